@@ -1,6 +1,13 @@
 #ifndef TASKSCHEDULER_H
 #define TASKSCHEDULER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
 using namespace std;
 
 /**
@@ -14,6 +21,7 @@ typedef struct {
     char surname[100];     /**< User surname */
     char email[100];       /**< User email */
     char password[100];    /**< User password */
+    uint8_t tag[16];       /**< AES-CMAC integrity tag over the fields above */
 } User;
 
 /**
@@ -33,6 +41,7 @@ typedef struct {
     bool isDeadlined;         /**< Flag indicating if the task has a deadline */
     int dependencies[10];     /**< Array of dependencies (task IDs) */
     int numDependencies;      /**< Number of dependencies */
+    uint8_t tag[16];          /**< AES-CMAC integrity tag over the fields above */
 } Task;
 
 /**
@@ -84,6 +93,45 @@ struct Edge {
     int weight;  /**< Weight of the edge */
 };
 
+/**
+ * @brief Task dependency graph in compressed sparse row (CSR) form.
+ *
+ * Task ids are mapped to dense vertex indexes 0..ids.size()-1 in ascending id order, so the graph is sized by the
+ * number of tasks rather than by the largest id. The edges of vertex v are stored contiguously in
+ * [offsets[v], offsets[v + 1]) of targets and weights, so a traversal reads them sequentially.
+ * generation changes every time the graph changes, so results computed from the graph can be cached against it.
+ */
+struct TaskGraph {
+    unsigned long long generation = 0;  /**< Incremented by every build or update of the graph */
+    vector<int> ids;                  /**< Task id of each vertex, ascending */
+    unordered_map<int, int> indexOf;  /**< Vertex index of each task id */
+    vector<int> offsets;              /**< First undirected edge of each vertex, one extra entry at the end */
+    vector<int> targets;              /**< Neighbour vertex of each undirected edge */
+    vector<int> weights;              /**< Weight of each undirected edge */
+    vector<int> depOffsets;           /**< First dependency arc of each vertex, one extra entry at the end */
+    vector<int> depTargets;           /**< Vertex that each dependency arc points to */
+    vector<int> dependentOffsets;     /**< First reversed dependency arc of each vertex, one extra entry at the end */
+    vector<int> dependentTargets;     /**< Vertex that each reversed dependency arc points to, i.e. a dependent task */
+    bool acyclic = true;              /**< True if the dependency arcs have no cycle */
+    vector<int> topoOrder;            /**< Position of each vertex in a topological order of the dependency arcs, empty unless acyclic */
+};
+
+/**
+ * @brief Schedule of the tasks of an acyclic task graph (critical path method).
+ *
+ * A task starts once every task it depends on has finished. The arrays are indexed by vertex like the graph the
+ * plan was computed for. The latest start of vertex v that does not delay the whole schedule is
+ * makespan - remaining[v], its slack is that minus earliestStart[v], and the critical tasks are those without slack.
+ */
+struct TaskPlan {
+    unsigned long long generation = 0;  /**< Generation of the task graph the plan reflects */
+    vector<int> ids;                  /**< Task id of each vertex, as in the graph */
+    vector<int> durations;            /**< Duration of each task */
+    vector<int> earliestStart;        /**< Earliest start time of each task */
+    vector<int> remaining;            /**< Longest chain of work from the start of each task to the end, its own duration included */
+    int makespan = 0;                 /**< Time at which the last task finishes */
+};
+
 
 //TOOLS
 
@@ -99,6 +147,22 @@ int getNewUserId(User users[], int userCount);
 
 int getNewTaskId(const char* pathFileTasks);
 
+void tagTask(Task* task);
+
+bool verifyTask(const Task* task);
+
+void tagUser(User* user);
+
+bool verifyUser(const User* user);
+
+int verifyTasksFile(const char* pathFileTasks, int threadCount);
+
+FILE* createTasksFile(const char* pathFileTasks);
+
+bool saveUsers(const char* pathFileUsers, const User* users, int userCount);
+
+bool upgradeRecordFiles(const char* pathFileUsers, const char* pathFileTasks, ostream& out);
+
 //TOOLS
 
 //PRINT MENUS
@@ -139,9 +203,9 @@ bool viewTask(const char* pathFileTasks, istream& in, ostream& out);
 
 bool viewTaskForFunc(const char* pathFileTasks, istream& in, ostream& out);
 
-int loadTasks(const char* pathFileTasks, Task** tasks);
+int loadTasks(const char* pathFileTasks, Task** tasks, int* skipped = nullptr);
 
-int loadOwnedTasks(const char* pathFileTasks, Task** tasks, int userId);
+int loadOwnedTasks(const char* pathFileTasks, Task** tasks, int userId, int* skipped = nullptr);
 
 bool viewDeadlines(const char* pathFileTasks, istream& in, ostream& out);
 
@@ -169,6 +233,8 @@ bool calculateMST(istream& in, ostream& out);
 
 bool shortestPath(istream& in, ostream& out);
 
+bool planSchedule(const char* pathFileTasks, istream& in, ostream& out);
+
 //Algorithms
 
 bool bfs(int** residualGraph, int source, int sink, int parent[], int V);
@@ -177,12 +243,38 @@ bool dfs(int** residualGraph, int source, int sink, int parent[], int V);
 
 bool loadTasksAndDependencies(const char* pathFileTasks);
 
+void buildTaskGraph(const vector<int>& taskIds, const vector<Edge>& dependencies, TaskGraph* graph);
+
+void addTaskToGraph(TaskGraph* graph, const Task* task);
+
+const TaskGraph& syncTaskGraph(const char* pathFileTasks);
+
+bool dependencyCreatesCycle(const TaskGraph& graph, int taskId, int dependencyId);
+
+int taskGraphIndex(const TaskGraph& graph, int taskId);
+
+bool topologicalOrder(const TaskGraph& graph, vector<int>* order);
+
+bool planTaskGraph(const TaskGraph& graph, const vector<int>& durations, TaskPlan* plan);
+
+bool setPlannedDuration(const TaskGraph& graph, TaskPlan* plan, int taskId, int duration);
+
+bool addTaskToPlan(const TaskGraph& graph, TaskPlan* plan, const Task* task, int duration);
+
+vector<int> criticalPath(const TaskGraph& graph, const TaskPlan& plan);
+
+void printTaskPlan(const TaskGraph& graph, const TaskPlan& plan, ostream& out);
+
 int BFS(int startVertex);
 
 int DFSUtil(int vertex, bool visited[]);
 
 int DFS(int startVertex);
 
+int directionOptimizingBFS(const TaskGraph& graph, int startVertex, int threadCount, vector<int>* depths);
+
+int executeTaskGraph(const TaskGraph& graph, int threadCount, const function<void(int)>& run);
+
 void heapify(User users[], int n, int i);
 
 void buildMaxHeap(User users[], int n);
@@ -201,7 +293,11 @@ void huffmanEncodingTaskMenu(const char* pathFileTasks, istream& in, ostream& ou
 
 bool analyzeSCC(const char* pathFileTasks, istream& in, ostream& out);
 
-void addEdgeWithWeight(int u, int v, int weight);
+int findStronglyConnectedComponents(const TaskGraph& graph, vector<int>* components);
+
+int parallelStronglyConnectedComponents(const TaskGraph& graph, int threadCount, vector<int>* components);
+
+void findSCCs(const TaskGraph& graph, ostream& out);
 
 void primMST(int startVertex, ostream& out);
 
@@ -211,26 +307,46 @@ int find(int parent[], int i);
 
 void unionSets(int parent[], int x, int y);
 
+long long kruskalForest(const TaskGraph& graph, int V, vector<Edge>* forest);
+
 void kruskalMST(int V, ostream& out);
 
+long long boruvkaMST(const TaskGraph& graph, int threadCount, vector<Edge>* forest);
+
+int findShortestRoute(const TaskGraph& graph, int startTaskId, int targetTaskId, vector<int>* route);
+
+int dijkstraDistances(const TaskGraph& graph, int startTaskId, vector<int>* dist);
+
 void calculateShortestPath(int startVertex, ostream& out);
 
+int deltaSteppingDistances(const TaskGraph& graph, int startTaskId, int threadCount, int delta, vector<int>* dist);
+
+void calculateDeltaStepping(int startVertex, ostream& out);
+
+int bellmanFordDistances(const TaskGraph& graph, int startTaskId, int V, vector<int>* dist, vector<int>* cycle);
+
 void calculateBellmanFord(int startVertex, int V, ostream& out);
 
+bool allPairsDistances(const TaskGraph& graph, int threadCount, vector<int>* dist);
+
+const vector<int>* cachedTaskGraphDistances();
+
 int fordFulkerson(int** graph, int source, int sink, int V);
 
 int edmondsKarp(int** graph, int source, int sink, int V);
 
-/*
 void encryptData(uint8_t* data, size_t length);
 
 void decryptData(uint8_t* data, size_t length);
-*/
 
 //Algorithms
 
 //LOGIN REGISTER
 
+size_t encryptEmail(const char* email, uint8_t* out);
+
+bool findUserByEmail(const char* pathFileUsers, const char* email, User* user);
+
 int loginUser(User loginUser, const char* pathFileUsers, istream& in, ostream& out);
 
 int loginUserMenu(const char* pathFileUsers, istream& in, ostream& out);
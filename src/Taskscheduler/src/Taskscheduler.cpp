@@ -15,13 +15,32 @@
 #include <sstream>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TASKSCHEDULER_AVX2 1
+#include <immintrin.h>
+#else
+#define TASKSCHEDULER_AVX2 0
+#endif
 #include <list>
+#include <deque>
 #include <queue>
 #include <stack>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <climits>
 #include <set>
+#include <map>
+#include <algorithm>
+#include <sys/stat.h>
 #include "../../aes/header/aes.h"
 
 using namespace std;
@@ -42,24 +61,69 @@ const char* pathFileUsers = "Users.bin";
 const char* pathFileTasks = "Tasks.bin";
 
 /**
- * @brief Maximum number of tasks that can be managed by the application.
+ * @brief Number of vertices of the dense capacity matrix used by the flow algorithms menu.
  */
 const int MAX_TASKS = 100;
 
 /**
- * @brief Adjacency list for storing task dependencies.
+ * @brief Dependency graph of the tasks, built from the task file by loadTasksAndDependencies and kept up to date by addTask.
  */
-list<int> adjLists[MAX_TASKS];
+TaskGraph taskGraph;
 
 /**
- * @brief Map for storing Huffman codes.
+ * @brief Path of the task file taskGraph was built from, empty if it has not been built.
  */
-unordered_map<char, string> codes;
+string taskGraphPath;
+
+/**
+ * @brief Size in bytes of the task file taskGraph reflects.
+ */
+long long taskGraphFileSize = -1;
+
+/**
+ * @brief Modification time of the task file taskGraph reflects, in the units of fileStamp.
+ */
+long long taskGraphFileTime = -1;
+
+/**
+ * @brief Schedule of the tasks in taskGraph, kept up to date by addTask and planSchedule.
+ */
+TaskPlan taskPlan;
+
+/**
+ * @brief Duration given to tasks that have not been given one.
+ */
+const int DEFAULT_TASK_DURATION = 1;
+
+/**
+ * @brief All-pairs distances of taskGraph, row by row, filled by cachedTaskGraphDistances.
+ */
+vector<int> taskGraphDistanceCache;
+
+/**
+ * @brief Generation of taskGraph that taskGraphDistanceCache holds, 0 if it holds nothing.
+ */
+unsigned long long taskGraphDistanceGeneration = 0;
+
+/**
+ * @brief Largest task graph whose all-pairs distances are computed and cached, 4 MB of distances.
+ */
+const int DISTANCE_CACHE_MAX_VERTICES = 1024;
+
+/**
+ * @brief First bytes of a saved distance cache file.
+ */
+const char DISTANCE_CACHE_MAGIC[4] = { 'T', 'S', 'D', 'C' };
+
+/**
+ * @brief Layout version of a saved distance cache file, raised whenever the layout changes.
+ */
+const uint32_t DISTANCE_CACHE_VERSION = 1;
 
 /**
- * @brief List of pairs representing the adjacency list for the graph.
+ * @brief Map for storing Huffman codes.
  */
-list<pair<int, int>> adj[MAX_TASKS];
+unordered_map<char, string> codes;
 
 /**
  * @brief AES encryption key.
@@ -71,6 +135,40 @@ const uint8_t AES_KEY[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0x
  */
 const uint8_t AES_IV[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
 
+/**
+ * @brief AES-CMAC key for the integrity tags of Task and User records.
+ */
+const uint8_t TAG_KEY[16] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81 };
+
+/**
+ * @brief AES-SIV key (CMAC key followed by CTR key) for the deterministic encryption of emails.
+ */
+const uint8_t EMAIL_KEY[32] = { 0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5, 0xf4, 0xf3, 0xf2, 0xf1, 0xf0,
+                                0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff };
+
+/**
+ * @brief Login index: maps the encrypted email of each user to the user's position in the user file.
+ *
+ * The index and the fields below are not guarded; like the rest of the menu state they are only used from the
+ * thread running the menus.
+ */
+unordered_map<string, int> userIndex;
+
+/**
+ * @brief Path of the user file the login index was built from, empty if it has not been built.
+ */
+string userIndexPath;
+
+/**
+ * @brief Size in bytes of the user file the login index was built from.
+ */
+long long userIndexFileSize = -1;
+
+/**
+ * @brief Modification time of the user file the login index was built from, in the units of fileStamp.
+ */
+long long userIndexFileTime = -1;
+
 //TOOLS
 
 /**
@@ -86,6 +184,33 @@ void clearScreen() {
 #endif
 }
 
+/**
+ * @brief Reads the size and the modification time of a file.
+ *
+ * The time has nanosecond resolution where the platform reports it, so a rewrite that keeps the size is still
+ * noticed unless it happens within the same clock tick.
+ *
+ * @param path Path to the file.
+ * @param size Receives the size in bytes.
+ * @param modified Receives the modification time.
+ * @return bool Returns true if the file exists, otherwise false.
+ */
+static bool fileStamp(const char* path, long long* size, long long* modified) {
+	struct stat info;
+	if (stat(path, &info) != 0) {
+		return false;
+	}
+	*size = (long long)info.st_size;
+#if defined(__APPLE__)
+	*modified = (long long)info.st_mtimespec.tv_sec * 1000000000LL + info.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+	*modified = (long long)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+#else
+	*modified = (long long)info.st_mtime;
+#endif
+	return true;
+}
+
 /**
  * @brief Prompts the user to press enter to continue.
  *
@@ -163,948 +288,3350 @@ int getNewUserId(User users[], int userCount) {
 }
 
 /**
- * @brief Generates a new task ID.
- *
- * This function generates a new task ID based on the maximum existing task ID in the binary file.
- * It reads the tasks from the binary file and finds the maximum ID.
+ * @brief Returns the expanded AES-CMAC key used for record tags.
  *
- * @param pathFileTasks Path to the binary file containing tasks.
- * @return int A new unique task ID.
+ * @return const AES_CMAC_key* The shared key, expanded on first use.
  */
-int getNewTaskId(const char* pathFileTasks) {
-	FILE* file = fopen(pathFileTasks, "rb");
-	if (!file) {
-		return 1;
-	}
-
-	Task task;
-	int maxId = 0;
-
-	while (fread(&task, sizeof(Task), 1, file)) {
-		if (task.id > maxId) {
-			maxId = task.id;
-		}
-	}
-
-	fclose(file);
-
-	return maxId + 1;
+static const struct AES_CMAC_key* tagKey() {
+	static struct AES_CMAC_key key;
+	static const int ready = AES_CMAC_key_init(&key, TAG_KEY, sizeof(TAG_KEY));
+	(void)ready;
+	return &key;
 }
 
-
-//TOOLS
-
-
-
-//PRINT MENUS
-
 /**
- * @brief Prints the guest menu.
+ * @brief Checks the tag stored at the end of a raw record.
  *
- * This function displays the guest menu options to the output stream.
+ * Every record must carry a tag: one that was never tagged fails like one that was modified.
  *
- * @param out Output stream for displaying the menu.
- * @return bool Always returns true.
+ * @param record The record bytes.
+ * @param tagOffset Offset of the tag, which covers every byte before it.
+ * @return bool Returns true if the tag matches, otherwise false.
  */
-bool printGuestMenu(ostream& out) {
-	out << "1. View Categories\n";
-	out << "2. Exit";
-	return true;
+static bool verifyRecord(const uint8_t* record, size_t tagOffset) {
+	return AES_CMAC_verify_buffer(tagKey(), record, tagOffset, record + tagOffset) == 1;
 }
 
 /**
- * @brief Prints the main menu.
+ * @brief Computes the integrity tag of a task.
  *
- * This function clears the screen and displays the main menu options to the output stream.
+ * The tag covers every field of the task, so it must be recomputed after any change and right before the task is written.
  *
- * @param out Output stream for displaying the menu.
- * @return bool Always returns true.
+ * @param task The task to tag.
  */
-bool printMainMenu(ostream& out) {
-	clearScreen();
-	out << "1. Login\n";
-	out << "2. Register\n";
-	out << "3. Guest Mode\n";
-	out << "4. Exit\n";
-	return true;
+void tagTask(Task* task) {
+	AES_CMAC_buffer(tagKey(), reinterpret_cast<const uint8_t*>(task), offsetof(Task, tag), task->tag);
 }
 
 /**
- * @brief Prints the user menu.
- *
- * This function clears the screen and displays the user menu options to the output stream.
- * It includes options for creating tasks, setting deadlines, managing reminders, task prioritization, and flow algorithms.
+ * @brief Checks the integrity tag of a task.
  *
- * @param out Output stream for displaying the menu.
- * @return bool Always returns true.
+ * @param task The task to check.
+ * @return bool Returns true if the task is unmodified, false if it was changed after tagging or never tagged.
  */
-bool printUserMenu(ostream& out) {
-	clearScreen();
-	out << "Welcome " << loggedUser.name << " " << loggedUser.surname << " Please Enter Your Choice\n";
-	out << "1. Create Task\n";
-	out << "2. Deadline Settings\n";
-	out << "3. Reminder System\n";
-	out << "4. Task Prioritization\n";
-	out << "5. Flow Algorithms\n";  // New menu option
-	out << "6. Exit\n";
-	return true;
+bool verifyTask(const Task* task) {
+	return verifyRecord(reinterpret_cast<const uint8_t*>(task), offsetof(Task, tag));
 }
 
 /**
- * @brief Prints the create task menu.
- *
- * This function clears the screen and displays the create task menu options to the output stream.
- * It includes options for adding, categorizing, viewing tasks, viewing similar tasks, task allegiances, SCC analysis, and Huffman encoding.
+ * @brief Computes the integrity tag of a user.
  *
- * @param out Output stream for displaying the menu.
- * @return bool Always returns true.
+ * @param user The user to tag.
  */
-bool printCreateTaskMenu(ostream& out) {
-	clearScreen();
-	out << "1. Add Task\n";
-	out << "2. Categorize Tasks\n";
-	out << "3. View Tasks\n";
-	out << "4. View Similar Tasks\n";
-	out << "5. Task Allegiances\n";
-	out << "6. Analyze SCC\n";
-	out << "7. Encode With Huffman\n";
-	out << "8. Exit\n";
-	return true;
+void tagUser(User* user) {
+	AES_CMAC_buffer(tagKey(), reinterpret_cast<const uint8_t*>(user), offsetof(User, tag), user->tag);
 }
 
 /**
- * @brief Prints the deadline settings menu.
- *
- * This function clears the screen and displays the deadline settings menu options to the output stream.
- * It includes options for assigning and viewing deadlines.
+ * @brief Checks the integrity tag of a user.
  *
- * @param out Output stream for displaying the menu.
- * @return bool Always returns true.
+ * @param user The user to check.
+ * @return bool Returns true if the user is unmodified, false if it was changed after tagging or never tagged.
  */
-bool printDeadlineSettingsMenu(ostream& out) {
-	clearScreen();
-	out << "1. Assign Deadline\n";
-	out << "2. View Deadlines\n";
-	out << "3. Exit\n";
-	return true;
+bool verifyUser(const User* user) {
+	return verifyRecord(reinterpret_cast<const uint8_t*>(user), offsetof(User, tag));
 }
 
 /**
- * @brief Prints the reminder system menu.
+ * @brief Reads the next task whose tag verifies.
  *
- * This function clears the screen and displays the reminder system menu options to the output stream.
- * It includes options for setting reminders and managing notification settings.
+ * Records that fail verification are skipped, so a modified task is never loaded.
  *
- * @param out Output stream for displaying the menu.
- * @return bool Always returns true.
+ * @param file The task file, opened for reading.
+ * @param task Receives the task.
+ * @param skipped Incremented for every record skipped, may be nullptr.
+ * @return bool Returns true if a task was read, false at the end of the file.
  */
-bool printReminderSystemMenu(ostream& out) {
-	clearScreen();
-	out << "1. Set Reminders\n";
-	out << "2. Notification Settings\n";
-	out << "3. Exit\n";
-	return true;
+static bool readTaskRecord(FILE* file, Task* task, int* skipped) {
+	while (fread(task, sizeof(Task), 1, file) == 1) {
+		if (verifyTask(task)) {
+			return true;
+		}
+		if (skipped) {
+			(*skipped)++;
+		}
+	}
+	return false;
 }
 
 /**
- * @brief Prints the task prioritization menu.
- *
- * This function clears the screen and displays the task prioritization menu options to the output stream.
- * It includes options for marking task importance, reordering tasks, calculating MST for task dependencies, and calculating the shortest path.
+ * @brief Tags a task and writes it to the file.
  *
- * @param out Output stream for displaying the menu.
- * @return bool Always returns true.
+ * @param file The task file, opened for writing.
+ * @param task The task to write; its tag is updated.
+ * @return bool Returns true if the record was written, otherwise false.
  */
-bool printTaskPrioritizationMenu(ostream& out) {
-	clearScreen();
-	out << "1. Mark Task Importance\n";
-	out << "2. Reorder Task\n";
-	out << "3. Calculate MST for Task Dependencies\n";
-	out << "4. Calculate Shortest Path\n";
-	out << "5. Exit\n";
-	return true;
+static bool writeTaskRecord(FILE* file, Task* task) {
+	tagTask(task);
+	return fwrite(task, sizeof(Task), 1, file) == 1;
 }
 
 /**
- * @brief Prints the flow algorithms menu.
- *
- * This function clears the screen and displays the flow algorithms menu options to the output stream.
- * It includes options for choosing between the Ford-Fulkerson and Edmonds-Karp algorithms.
+ * @brief Header at the start of the task and user files.
  *
- * @param out Output stream for displaying the menu.
- * @return bool Always returns true.
+ * Files written before records were tagged have no header. They are recognised by their size and converted once,
+ * see upgradeTasksFile and upgradeUsersFile.
  */
-bool printFlowAlgorithmsMenu(ostream& out) {
-	clearScreen();
-	out << "Choose flow algorithm:\n";
-	out << "1. Ford-Fulkerson Algorithm\n";
-	out << "2. Edmonds-Karp Algorithm\n";
-	out << "3. Exit\n";
-	return true;
-}
+struct RecordFileHeader {
+	char magic[4];          /**< TASK_FILE_MAGIC or USER_FILE_MAGIC */
+	uint32_t version;       /**< RECORD_FILE_VERSION */
+	uint32_t recordSize;    /**< sizeof(Task) or sizeof(User) of the writer */
+};
+
+/**
+ * @brief First bytes of a task file.
+ */
+const char TASK_FILE_MAGIC[4] = { 'T', 'S', 'T', 'K' };
 
+/**
+ * @brief First bytes of a user file.
+ */
+const char USER_FILE_MAGIC[4] = { 'T', 'S', 'U', 'S' };
 
-//PRINT MENUS
+/**
+ * @brief Layout version of the task and user files, raised whenever a record changes.
+ */
+const uint32_t RECORD_FILE_VERSION = 1;
 
+/**
+ * @brief Size of a user record before records were tagged: every field up to the tag.
+ */
+const size_t LEGACY_USER_SIZE = offsetof(User, tag);
 
+/**
+ * @brief Size of a task record before records were tagged: the owner and the task without their tags.
+ */
+const size_t LEGACY_TASK_SIZE = offsetof(Task, owner) + LEGACY_USER_SIZE + (offsetof(Task, tag) - offsetof(Task, name));
 
-//MENUS
+/**
+ * @brief Outcome of bringing a task or user file to the current layout.
+ */
+enum RecordFileLayout {
+	RECORD_FILE_CURRENT,        /**< Missing, empty or already in the current layout */
+	RECORD_FILE_UPGRADED,       /**< Converted from the untagged layout */
+	RECORD_FILE_UNSUPPORTED     /**< Neither layout; the file is left as it is */
+};
 
 /**
- * @brief Displays and handles the create task menu.
+ * @brief Reads a record file header and checks it against the current layout.
  *
- * This function displays the create task menu and processes user input to perform various task-related operations.
+ * @param file The file, positioned at its start.
+ * @param magic TASK_FILE_MAGIC or USER_FILE_MAGIC.
+ * @param recordSize sizeof(Task) or sizeof(User).
+ * @return RecordFileLayout RECORD_FILE_CURRENT if the header matches, RECORD_FILE_UNSUPPORTED if it carries the
+ * magic but another version or record size, RECORD_FILE_UPGRADED if there is no header at all.
+ */
+static RecordFileLayout readRecordFileHeader(FILE* file, const char* magic, size_t recordSize) {
+	RecordFileHeader header;
+	if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, magic, sizeof(header.magic)) != 0) {
+		return RECORD_FILE_UPGRADED;
+	}
+	return header.version == RECORD_FILE_VERSION && header.recordSize == recordSize ? RECORD_FILE_CURRENT : RECORD_FILE_UNSUPPORTED;
+}
+
+/**
+ * @brief Writes a record file header for the current layout.
  *
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the menu and messages.
- * @return int Returns 0 when the user chooses to exit the menu.
+ * @param file The file, positioned at its start.
+ * @param magic TASK_FILE_MAGIC or USER_FILE_MAGIC.
+ * @param recordSize sizeof(Task) or sizeof(User).
+ * @return bool Returns true if the header was written.
  */
-int createTaskMenu(istream& in, ostream& out) {
-	int choice;
+static bool writeRecordFileHeader(FILE* file, const char* magic, size_t recordSize) {
+	RecordFileHeader header;
+	memcpy(header.magic, magic, sizeof(header.magic));
+	header.version = RECORD_FILE_VERSION;
+	header.recordSize = (uint32_t)recordSize;
+	return fwrite(&header, sizeof(header), 1, file) == 1;
+}
 
-	while (true) {
-		printCreateTaskMenu(out);
-		choice = getInput(in);
+/**
+ * @brief Returns the size of an open file.
+ *
+ * @param file The file; it is left at its start.
+ * @return long The size in bytes.
+ */
+static long recordFileSize(FILE* file) {
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	return size;
+}
 
-		if (in.fail()) { handleInputError(in, out); continue; }
-
-		switch (choice) {
-		case 1:
-			addTaskMenu(pathFileTasks, in, out);
-			break;
-		case 2:
-			categorizeTask(pathFileTasks, in, out);
-			break;
-		case 3:
-			viewTask(pathFileTasks, in, out);
-			break;
-		case 4:
-			similarTasks(pathFileTasks, in, out);
-			break;
-		case 5:
-			allegiances(pathFileTasks, in, out);
-			break;
-		case 6:
-			analyzeSCC(pathFileTasks, in, out);
-			break;
-		case 7:
-			huffmanEncodingTaskMenu(pathFileTasks, in, out);
-			break;
-		case 8:
-			return 0;
-		default:
-			out << "\nInvalid choice. Please try again.\n";
-			enterToContinue(in, out);
-			break;
-		}
-	}
-}
+/**
+ * @brief Replaces a file with a new version written next to it.
+ *
+ * @param path Path of the file to replace.
+ * @param replacement Path of the new version.
+ * @return bool Returns true if the file was replaced.
+ */
+static bool replaceFile(const char* path, const string& replacement) {
+	remove(path);
+	return rename(replacement.c_str(), path) == 0;
+}
 
 /**
- * @brief Displays and handles the deadline settings menu.
+ * @brief Creates an empty task file, replacing any file at the path.
  *
- * This function displays the deadline settings menu and processes user input to assign or view deadlines.
- *
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the menu and messages.
- * @return int Returns 0 when the user chooses to exit the menu.
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @return FILE* The file, open for writing records, or nullptr if it cannot be created.
  */
-int deadlineSettingsMenu(istream& in, ostream& out) {
-	int choice;
-
-	while (true) {
-		printDeadlineSettingsMenu(out);
-		choice = getInput(in);
-
-		if (in.fail()) { handleInputError(in, out); continue; }
-
-		switch (choice) {
-		case 1:
-			assignDeadline(pathFileTasks, in, out);
-			break;
-		case 2:
-			viewDeadlines(pathFileTasks, in, out);
-			break;
-		case 3:
-			return 0;
-		default:
-			out << "\nInvalid choice. Please try again.\n";
-			enterToContinue(in, out);
-			break;
-		}
+FILE* createTasksFile(const char* pathFileTasks) {
+	FILE* file = fopen(pathFileTasks, "wb");
+	if (file && !writeRecordFileHeader(file, TASK_FILE_MAGIC, sizeof(Task))) {
+		fclose(file);
+		return nullptr;
 	}
+	return file;
 }
 
 /**
- * @brief Displays and handles the reminder system menu.
+ * @brief Writes a user file: the header, the user count and the users.
  *
- * This function displays the reminder system menu and processes user input to set reminders or manage notification settings.
+ * The users are written as they are; tag a user with tagUser after changing it.
  *
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the menu and messages.
- * @return int Returns 0 when the user chooses to exit the menu.
+ * @param pathFileUsers Path to the binary file containing user data.
+ * @param users The users.
+ * @param userCount Number of users.
+ * @return bool Returns true if the file was written.
  */
-int reminderSystemMenu(istream& in, ostream& out) {
-	int choice;
-
-	while (true) {
-		printReminderSystemMenu(out);
-		choice = getInput(in);
-
-		if (in.fail()) { handleInputError(in, out); continue; }
-
-		switch (choice) {
-		case 1:
-			setReminders(in, out);
-			break;
-		case 2:
-			notificationSettings(in, out);
-			break;
-		case 3:
-			return 0;
-		default:
-			out << "\nInvalid choice. Please try again.\n";
-			enterToContinue(in, out);
-			break;
-		}
+bool saveUsers(const char* pathFileUsers, const User* users, int userCount) {
+	FILE* file = fopen(pathFileUsers, "wb");
+	if (!file) {
+		return false;
 	}
+	bool written = writeRecordFileHeader(file, USER_FILE_MAGIC, sizeof(User))
+		&& fwrite(&userCount, sizeof(int), 1, file) == 1
+		&& (userCount == 0 || fwrite(users, sizeof(User), (size_t)userCount, file) == (size_t)userCount);
+	return fclose(file) == 0 && written;
 }
 
 /**
- * @brief Displays and handles the task prioritization menu.
+ * @brief Converts an untagged task file to the current layout.
  *
- * This function displays the task prioritization menu and processes user input to mark task importance, reorder tasks, calculate MST, or find the shortest path.
+ * Every record is widened by the owner's tag and its own, then tagged, and the file gets a header. The records are
+ * tagged as they are, so a file must be trusted when it is converted.
  *
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the menu and messages.
- * @return int Returns 0 when the user chooses to exit the menu.
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @return RecordFileLayout How the file was found.
  */
-int taskPrioritizationMenu(istream& in, ostream& out) {
-	int choice;
-
-	while (true) {
-		printTaskPrioritizationMenu(out);
-		choice = getInput(in);
+static RecordFileLayout upgradeTasksFile(const char* pathFileTasks) {
+	FILE* file = fopen(pathFileTasks, "rb");
+	if (!file) {
+		return RECORD_FILE_CURRENT;
+	}
+	long size = recordFileSize(file);
+	RecordFileLayout layout = size == 0 ? RECORD_FILE_CURRENT : readRecordFileHeader(file, TASK_FILE_MAGIC, sizeof(Task));
+	if (layout != RECORD_FILE_UPGRADED || size % LEGACY_TASK_SIZE != 0) {
+		fclose(file);
+		return layout == RECORD_FILE_UPGRADED ? RECORD_FILE_UNSUPPORTED : layout;
+	}
 
-		if (in.fail()) { handleInputError(in, out); continue; }
+	vector<uint8_t> legacy((size_t)size);
+	fseek(file, 0, SEEK_SET);
+	bool read = fread(legacy.data(), 1, legacy.size(), file) == legacy.size();
+	fclose(file);
+	string upgradedPath = string(pathFileTasks) + ".upgrade";
+	file = read ? fopen(upgradedPath.c_str(), "wb") : nullptr;
+	if (!file) {
+		return RECORD_FILE_UNSUPPORTED;
+	}
 
-		switch (choice) {
-		case 1:
-			markTaskImportance(pathFileTasks, in, out);
-			break;
-		case 2:
-			reorderTask(pathFileTasks, in, out);
-			break;
-		case 3:
-			calculateMST(in, out);
-			break;
-		case 4:
-			shortestPath(in, out);
-			break;
-		case 5:
-			return 0;
-		default:
-			out << "\nInvalid choice. Please try again.\n";
-			enterToContinue(in, out);
-			break;
-		}
+	const size_t head = offsetof(Task, owner) + LEGACY_USER_SIZE;
+	bool written = writeRecordFileHeader(file, TASK_FILE_MAGIC, sizeof(Task));
+	for (size_t offset = 0; written && offset < legacy.size(); offset += LEGACY_TASK_SIZE) {
+		Task task;
+		memset(&task, 0, sizeof(task));
+		memcpy(&task, &legacy[offset], head);
+		memcpy(task.name, &legacy[offset + head], offsetof(Task, tag) - offsetof(Task, name));
+		tagUser(&task.owner);
+		written = writeTaskRecord(file, &task);
 	}
+	if (fclose(file) != 0 || !written || !replaceFile(pathFileTasks, upgradedPath)) {
+		remove(upgradedPath.c_str());
+		return RECORD_FILE_UNSUPPORTED;
+	}
+	return RECORD_FILE_UPGRADED;
 }
 
 /**
- * @brief Displays and handles the flow algorithms menu.
+ * @brief Converts an untagged user file to the current layout.
  *
- * This function displays the flow algorithms menu and processes user input to choose between the Ford-Fulkerson and Edmonds-Karp algorithms for calculating maximum flow.
+ * The file is the user count followed by the users; every user is widened by its tag and tagged, and the file gets
+ * a header. The users are tagged as they are, so a file must be trusted when it is converted.
  *
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the menu and messages.
- * @return int Returns 0 when the user chooses to exit the menu.
+ * @param pathFileUsers Path to the binary file containing user data.
+ * @return RecordFileLayout How the file was found.
  */
-int flowAlgorithmsMenu(istream& in, ostream& out) {
-	int choice;
-	int source, sink;
-	int V = MAX_TASKS;
-	int** graph = new int* [V];
-	for (int i = 0; i < V; i++) {
-		graph[i] = new int[V]();
+static RecordFileLayout upgradeUsersFile(const char* pathFileUsers) {
+	FILE* file = fopen(pathFileUsers, "rb");
+	if (!file) {
+		return RECORD_FILE_CURRENT;
 	}
-
-	while (true) {
-		printFlowAlgorithmsMenu(out);
-		choice = getInput(in);
-
-		if (in.fail()) { handleInputError(in, out); continue; }
-
-		if (choice == 3) {
-			for (int i = 0; i < V; i++) {
-				delete[] graph[i];
-			}
-			delete[] graph;
-			return 0;
+	long size = recordFileSize(file);
+	RecordFileLayout layout = size == 0 ? RECORD_FILE_CURRENT : readRecordFileHeader(file, USER_FILE_MAGIC, sizeof(User));
+	int userCount = -1;
+	if (layout == RECORD_FILE_UPGRADED) {
+		fseek(file, 0, SEEK_SET);
+		if (fread(&userCount, sizeof(int), 1, file) != 1 || userCount < 0
+			|| (size_t)size != sizeof(int) + (size_t)userCount * LEGACY_USER_SIZE) {
+			layout = RECORD_FILE_UNSUPPORTED;
 		}
+	}
+	if (layout != RECORD_FILE_UPGRADED) {
+		fclose(file);
+		return layout;
+	}
 
-		viewTaskForFunc(pathFileTasks, in, out);
-		out << "\nEnter the source task ID:\n";
-		source = getInput(in);
-		out << "Enter the sink task ID:\n";
-		sink = getInput(in);
-
-		if (source < 0 || source >= V || sink < 0 || sink >= V) {
-			out << "Invalid task ID.\n";
-			enterToContinue(in, out);
-			continue;
-		}
+	vector<User> users(userCount);
+	bool read = true;
+	for (int i = 0; read && i < userCount; i++) {
+		memset(&users[i], 0, sizeof(User));
+		read = fread(&users[i], LEGACY_USER_SIZE, 1, file) == 1;
+		tagUser(&users[i]);
+	}
+	fclose(file);
 
-		loadTasksAndDependencies(pathFileTasks);
+	string upgradedPath = string(pathFileUsers) + ".upgrade";
+	if (!read || !saveUsers(upgradedPath.c_str(), users.data(), userCount) || !replaceFile(pathFileUsers, upgradedPath)) {
+		remove(upgradedPath.c_str());
+		return RECORD_FILE_UNSUPPORTED;
+	}
+	return RECORD_FILE_UPGRADED;
+}
 
-		int maxFlow = 0;
-		if (choice == 1) {
-			maxFlow = fordFulkerson(graph, source, sink, V);
+/**
+ * @brief Opens a task file for reading, converting it first if it is still untagged.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @return FILE* The file positioned at its first record, or nullptr if it is missing or in an unknown layout.
+ */
+static FILE* openTasksFile(const char* pathFileTasks) {
+	for (int attempt = 0; attempt < 2; attempt++) {
+		FILE* file = fopen(pathFileTasks, "rb");
+		if (!file) {
+			return nullptr;
 		}
-		else if (choice == 2) {
-			maxFlow = edmondsKarp(graph, source, sink, V);
+		if (recordFileSize(file) == 0 || readRecordFileHeader(file, TASK_FILE_MAGIC, sizeof(Task)) == RECORD_FILE_CURRENT) {
+			return file;
 		}
-		else {
-			out << "Invalid choice.\n";
-			enterToContinue(in, out);
-			continue;
+		fclose(file);
+		if (attempt > 0 || upgradeTasksFile(pathFileTasks) != RECORD_FILE_UPGRADED) {
+			return nullptr;
 		}
-
-		out << "Maximum flow from task " << source << " to task " << sink << " is: " << maxFlow << endl;
-		enterToContinue(in, out);
 	}
+	return nullptr;
 }
 
-
-//MENUS
-
 /**
- * @brief Displays and handles viewing tasks.
+ * @brief Opens a user file for reading, converting it first if it is still untagged.
  *
- * This function clears the screen and displays all tasks owned by the logged-in user.
+ * @param file Receives the file, positioned at the user count unless the file is empty.
+ * @param pathFileUsers Path to the binary file containing user data.
+ * @return RecordFileLayout How the file was found; the file is only open if this is not RECORD_FILE_UNSUPPORTED.
+ */
+static RecordFileLayout openUsersFile(ifstream& file, const char* pathFileUsers) {
+	RecordFileLayout layout = upgradeUsersFile(pathFileUsers);
+	if (layout != RECORD_FILE_UNSUPPORTED) {
+		file.open(pathFileUsers, ios::binary);
+		file.seekg(0, ios::end);
+		streamoff size = file.tellg();
+		file.seekg(size > 0 ? (streamoff)sizeof(RecordFileHeader) : 0, ios::beg);
+	}
+	return layout;
+}
+
+/**
+ * @brief Converts the task and user files written before records were tagged and reports files it cannot read.
  *
+ * @param pathFileUsers Path to the binary file containing user data.
  * @param pathFileTasks Path to the binary file containing tasks.
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the tasks and messages.
- * @return bool Always returns true.
+ * @param out Output stream for displaying messages.
+ * @return bool Returns true if both files are readable, missing ones included.
  */
-bool viewTask(const char* pathFileTasks, istream& in, ostream& out) {
-	clearScreen();
-	Task* tasks = NULL;
-	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
-
-	if (taskCount <= 0) {
-		out << "No Task Created.\n";
-	}
-	else {
-		for (int i = 0; i < taskCount; i++) {
-			out << "ID: " << tasks[i].id << ", Name: " << tasks[i].name
-				<< ", Description: " << tasks[i].description << ", Category: "
-				<< tasks[i].category << ", Deadline: " << tasks[i].deadLine << endl;
+bool upgradeRecordFiles(const char* pathFileUsers, const char* pathFileTasks, ostream& out) {
+	const char* paths[] = { pathFileUsers, pathFileTasks };
+	RecordFileLayout layouts[] = { upgradeUsersFile(pathFileUsers), upgradeTasksFile(pathFileTasks) };
+	bool readable = true;
+	for (int i = 0; i < 2; i++) {
+		if (layouts[i] == RECORD_FILE_UPGRADED) {
+			out << paths[i] << " was converted to the current record format." << endl;
+		}
+		else if (layouts[i] == RECORD_FILE_UNSUPPORTED) {
+			out << paths[i] << " is not in a record format this version can read and was left unchanged." << endl;
+			readable = false;
 		}
 	}
-
-	enterToContinue(in, out);
-	free(tasks);
-	return true;
+	return readable;
 }
 
 /**
- * @brief Displays tasks for function usage.
+ * @brief Generates a new task ID.
  *
- * This function clears the screen and displays all tasks owned by the logged-in user without waiting for user input.
+ * This function generates a new task ID based on the maximum existing task ID in the binary file.
+ * It reads the tasks from the binary file and finds the maximum ID. Records that fail verification are skipped.
  *
  * @param pathFileTasks Path to the binary file containing tasks.
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the tasks and messages.
- * @return bool Always returns true.
+ * @return int A new unique task ID.
  */
-bool viewTaskForFunc(const char* pathFileTasks, istream& in, ostream& out) {
-	clearScreen();
-	Task* tasks = NULL;
-	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
-
-	if (taskCount <= 0) {
-		out << "No Task Created.\n";
+int getNewTaskId(const char* pathFileTasks) {
+	FILE* file = openTasksFile(pathFileTasks);
+	if (!file) {
+		return 1;
 	}
-	else {
-		for (int i = 0; i < taskCount; i++) {
-			out << "ID: " << tasks[i].id << ", Name: " << tasks[i].name
-				<< ", Description: " << tasks[i].description << ", Category: "
-				<< tasks[i].category << ", Deadline: " << tasks[i].deadLine << endl;
+
+	Task task;
+	int maxId = 0;
+
+	while (readTaskRecord(file, &task, nullptr)) {
+		if (task.id > maxId) {
+			maxId = task.id;
 		}
 	}
 
-	free(tasks);
-	return true;
+	fclose(file);
+
+	return maxId + 1;
 }
 
 /**
- * @brief Displays tasks with deadlines.
+ * @brief Returns the number of threads to use for a parallel algorithm.
  *
- * This function clears the screen and displays all tasks owned by the logged-in user that have deadlines assigned.
+ * @param threadCount Requested number of threads, or 0 to use one per hardware thread.
+ * @return int The number of threads, at least 1.
+ */
+static int resolveThreadCount(int threadCount) {
+	if (threadCount <= 0) {
+		threadCount = (int)thread::hardware_concurrency();
+	}
+	return threadCount > 0 ? threadCount : 1;
+}
+
+/**
+ * @brief Verifies every record of a task file on several threads.
+ *
+ * The file is read in one pass and split into equal runs of records, one per thread. Each thread
+ * checks the tags of its run with the shared key and counts the failures on its own, so the
+ * threads do not touch any common state until the counts are added up.
  *
  * @param pathFileTasks Path to the binary file containing tasks.
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the tasks and messages.
- * @return bool Always returns true.
+ * @param threadCount Number of threads, or 0 to use one per hardware thread.
+ * @return int The number of modified records (a truncated last record counts as one), or -1 if the file cannot be read
+ * or is in an unknown layout.
  */
-bool viewDeadlines(const char* pathFileTasks, istream& in, ostream& out) {
-	clearScreen();
-	Task* tasks = nullptr;
-	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
+int verifyTasksFile(const char* pathFileTasks, int threadCount) {
+	FILE* file = openTasksFile(pathFileTasks);
+	if (!file) {
+		return -1;
+	}
 
-	if (taskCount <= 0) {
-		out << "No Task Created or Assigned to You." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return false;
+	long start = ftell(file);
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file) - start;
+	fseek(file, start, SEEK_SET);
+	vector<uint8_t> data(size > 0 ? (size_t)size : 0);
+	if (!data.empty() && fread(data.data(), 1, data.size(), file) != data.size()) {
+		fclose(file);
+		return -1;
 	}
+	fclose(file);
 
-	bool hasDeadlines = false;
-	for (int i = 0; i < taskCount; ++i) {
-		if (tasks[i].isDeadlined) {
-			out << "ID: " << tasks[i].id << ", Name: " << tasks[i].name
-				<< ", Description: " << tasks[i].description << ", Category: "
-				<< tasks[i].category << ", Deadline: " << tasks[i].deadLine << endl;
-			hasDeadlines = true;
-		}
+	size_t recordCount = data.size() / sizeof(Task);
+	int modified = data.size() % sizeof(Task) != 0 ? 1 : 0;
+	if (recordCount == 0) {
+		return modified;
 	}
 
-	if (!hasDeadlines) {
-		out << "No Task with Deadline Assigned to You." << endl;
+	threadCount = resolveThreadCount(threadCount);
+	if ((size_t)threadCount > recordCount) {
+		threadCount = (int)recordCount;
 	}
 
-	enterToContinue(in, out);
-	free(tasks);
-	return true;
+	tagKey();
+	vector<int> counts(threadCount, 0);
+	vector<thread> workers;
+	size_t perThread = (recordCount + threadCount - 1) / threadCount;
+
+	for (int t = 0; t < threadCount; t++) {
+		size_t first = t * perThread;
+		size_t last = min(recordCount, first + perThread);
+		workers.push_back(thread([&data, &counts, t, first, last]() {
+			int bad = 0;
+			for (size_t i = first; i < last; i++) {
+				if (!verifyRecord(&data[i * sizeof(Task)], offsetof(Task, tag))) {
+					bad++;
+				}
+			}
+			counts[t] = bad;
+		}));
+	}
+
+	for (size_t t = 0; t < workers.size(); t++) {
+		workers[t].join();
+		modified += counts[t];
+	}
+
+	return modified;
 }
 
+
+//TOOLS
+
+
+
+//PRINT MENUS
+
 /**
- * @brief Loads all tasks from the binary file.
+ * @brief Prints the guest menu.
  *
- * This function loads all tasks from the specified binary file and stores them in the provided array.
+ * This function displays the guest menu options to the output stream.
  *
- * @param pathFileTasks Path to the binary file containing tasks.
- * @param tasks Pointer to an array of Task objects.
- * @return int The number of tasks loaded.
+ * @param out Output stream for displaying the menu.
+ * @return bool Always returns true.
  */
-int loadTasks(const char* pathFileTasks, Task** tasks) {
-	FILE* file = fopen(pathFileTasks, "rb");
-	if (!file) {
-		printf("Failed to open file\n");
-		return -1;
-	}
-
-	Task temp;
-	int count = 0;
-	while (fread(&temp, sizeof(Task), 1, file) == 1) {
-		*tasks = (Task*)realloc(*tasks, (count + 1) * sizeof(Task));
-		(*tasks)[count] = temp;
-		count++;
-	}
-	fclose(file);
-	return count;
+bool printGuestMenu(ostream& out) {
+	out << "1. View Categories\n";
+	out << "2. Exit";
+	return true;
 }
 
 /**
- * @brief Loads tasks owned by a specific user from the binary file.
+ * @brief Prints the main menu.
  *
- * This function loads tasks owned by the specified user from the binary file and stores them in the provided array.
+ * This function clears the screen and displays the main menu options to the output stream.
  *
- * @param pathFileTasks Path to the binary file containing tasks.
- * @param tasks Pointer to an array of Task objects.
- * @param userId The ID of the user whose tasks are to be loaded.
- * @return int The number of tasks loaded.
+ * @param out Output stream for displaying the menu.
+ * @return bool Always returns true.
  */
-int loadOwnedTasks(const char* pathFileTasks, Task** tasks, int userId) {
-	FILE* file = fopen(pathFileTasks, "rb");
-	if (!file) {
-		printf("Failed to open file\n");
-		return -1;
-	}
+bool printMainMenu(ostream& out) {
+	clearScreen();
+	out << "1. Login\n";
+	out << "2. Register\n";
+	out << "3. Guest Mode\n";
+	out << "4. Exit\n";
+	return true;
+}
 
-	Task temp;
-	int count = 0;
-	while (fread(&temp, sizeof(Task), 1, file) == 1) {
-		if (temp.owner.id == userId) {
-			*tasks = (Task*)realloc(*tasks, (count + 1) * sizeof(Task));
-			(*tasks)[count] = temp;
-			count++;
-		}
-	}
-	fclose(file);
-	return count;
+/**
+ * @brief Prints the user menu.
+ *
+ * This function clears the screen and displays the user menu options to the output stream.
+ * It includes options for creating tasks, setting deadlines, managing reminders, task prioritization, and flow algorithms.
+ *
+ * @param out Output stream for displaying the menu.
+ * @return bool Always returns true.
+ */
+bool printUserMenu(ostream& out) {
+	clearScreen();
+	out << "Welcome " << loggedUser.name << " " << loggedUser.surname << " Please Enter Your Choice\n";
+	out << "1. Create Task\n";
+	out << "2. Deadline Settings\n";
+	out << "3. Reminder System\n";
+	out << "4. Task Prioritization\n";
+	out << "5. Flow Algorithms\n";  // New menu option
+	out << "6. Exit\n";
+	return true;
 }
 
 /**
- * @brief Adds a new task to the binary file.
+ * @brief Prints the create task menu.
  *
- * This function appends a new task to the specified binary file.
+ * This function clears the screen and displays the create task menu options to the output stream.
+ * It includes options for adding, categorizing, viewing tasks, viewing similar tasks, task allegiances, SCC analysis, and Huffman encoding.
  *
- * @param newTask Pointer to the Task object to be added.
- * @param pathFileTasks Path to the binary file containing tasks.
- * @return int Returns 1 if the task is added successfully, otherwise 0.
+ * @param out Output stream for displaying the menu.
+ * @return bool Always returns true.
  */
-int addTask(const Task* newTask, const char* pathFileTasks) {
-	FILE* file = fopen(pathFileTasks, "ab");
-	if (!file) {
-		return 0;
-	}
+bool printCreateTaskMenu(ostream& out) {
+	clearScreen();
+	out << "1. Add Task\n";
+	out << "2. Categorize Tasks\n";
+	out << "3. View Tasks\n";
+	out << "4. View Similar Tasks\n";
+	out << "5. Task Allegiances\n";
+	out << "6. Analyze SCC\n";
+	out << "7. Encode With Huffman\n";
+	out << "8. Exit\n";
+	return true;
+}
 
-	fwrite(newTask, sizeof(Task), 1, file);
-	fclose(file);
-	return 1;
+/**
+ * @brief Prints the deadline settings menu.
+ *
+ * This function clears the screen and displays the deadline settings menu options to the output stream.
+ * It includes options for assigning and viewing deadlines.
+ *
+ * @param out Output stream for displaying the menu.
+ * @return bool Always returns true.
+ */
+bool printDeadlineSettingsMenu(ostream& out) {
+	clearScreen();
+	out << "1. Assign Deadline\n";
+	out << "2. View Deadlines\n";
+	out << "3. Exit\n";
+	return true;
 }
 
 /**
- * @brief Displays and handles the add task menu.
+ * @brief Prints the reminder system menu.
  *
- * This function displays the add task menu and processes user input to add a new task.
+ * This function clears the screen and displays the reminder system menu options to the output stream.
+ * It includes options for setting reminders and managing notification settings.
  *
- * @param pathFileTasks Path to the binary file containing tasks.
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the menu and messages.
- * @return int Returns 1 if the task is added successfully, otherwise 0.
+ * @param out Output stream for displaying the menu.
+ * @return bool Always returns true.
  */
-int addTaskMenu(const char* pathFileTasks, istream& in, ostream& out) {
+bool printReminderSystemMenu(ostream& out) {
 	clearScreen();
-	Task newTask;
+	out << "1. Set Reminders\n";
+	out << "2. Notification Settings\n";
+	out << "3. Exit\n";
+	return true;
+}
 
-	out << "Enter Task Name: ";
-	in.getline(newTask.name, sizeof(newTask.name));
+/**
+ * @brief Prints the task prioritization menu.
+ *
+ * This function clears the screen and displays the task prioritization menu options to the output stream.
+ * It includes options for marking task importance, reordering tasks, calculating MST for task dependencies, and calculating the shortest path.
+ *
+ * @param out Output stream for displaying the menu.
+ * @return bool Always returns true.
+ */
+bool printTaskPrioritizationMenu(ostream& out) {
+	clearScreen();
+	out << "1. Mark Task Importance\n";
+	out << "2. Reorder Task\n";
+	out << "3. Calculate MST for Task Dependencies\n";
+	out << "4. Calculate Shortest Path\n";
+	out << "5. Plan Schedule\n";
+	out << "6. Exit\n";
+	return true;
+}
 
-	out << "Enter Task Description: ";
-	in.getline(newTask.description, sizeof(newTask.description));
+/**
+ * @brief Prints the flow algorithms menu.
+ *
+ * This function clears the screen and displays the flow algorithms menu options to the output stream.
+ * It includes options for choosing between the Ford-Fulkerson and Edmonds-Karp algorithms.
+ *
+ * @param out Output stream for displaying the menu.
+ * @return bool Always returns true.
+ */
+bool printFlowAlgorithmsMenu(ostream& out) {
+	clearScreen();
+	out << "Choose flow algorithm:\n";
+	out << "1. Ford-Fulkerson Algorithm\n";
+	out << "2. Edmonds-Karp Algorithm\n";
+	out << "3. Exit\n";
+	return true;
+}
 
-	newTask.owner = loggedUser;
-	newTask.id = getNewTaskId(pathFileTasks);
-	newTask.isCategorized = false;
-	newTask.isDeadlined = false;
-	newTask.impid = 0;
-	newTask.category[0] = '\0';
-	newTask.deadLine[0] = '\0';
-	newTask.numDependencies = 0;
 
-	out << "Enter number of dependencies for this task: ";
-	int numDeps;
-	in >> numDeps;
-	in.ignore();
-	newTask.numDependencies = numDeps;
+//PRINT MENUS
 
-	for (int i = 0; i < numDeps; i++) {
-		out << "Enter dependency task ID #" << (i + 1) << ": ";
-		in >> newTask.dependencies[i];
-		in.ignore();
-	}
 
-	if (!addTask(&newTask, pathFileTasks)) {
-		out << "Failed to add Task.\n";
-		enterToContinue(in, out);
-		return 0;
-	}
 
-	out << "Task added successfully.\n";
-	enterToContinue(in, out);
-	return 1;
-}
+//MENUS
 
 /**
- * @brief Displays and handles the categorize task menu.
+ * @brief Displays and handles the create task menu.
  *
- * This function displays the categorize task menu and processes user input to categorize tasks.
+ * This function displays the create task menu and processes user input to perform various task-related operations.
  *
- * @param pathFileTasks Path to the binary file containing tasks.
  * @param in Input stream for reading user input.
  * @param out Output stream for displaying the menu and messages.
- * @return int Returns 1 if the task is categorized successfully, otherwise 0.
+ * @return int Returns 0 when the user chooses to exit the menu.
  */
-int categorizeTask(const char* pathFileTasks, istream& in, ostream& out) {
+int createTaskMenu(istream& in, ostream& out) {
+	int choice;
+
+	while (true) {
+		printCreateTaskMenu(out);
+		choice = getInput(in);
+
+		if (in.fail()) { handleInputError(in, out); continue; }
+
+		switch (choice) {
+		case 1:
+			addTaskMenu(pathFileTasks, in, out);
+			break;
+		case 2:
+			categorizeTask(pathFileTasks, in, out);
+			break;
+		case 3:
+			viewTask(pathFileTasks, in, out);
+			break;
+		case 4:
+			similarTasks(pathFileTasks, in, out);
+			break;
+		case 5:
+			allegiances(pathFileTasks, in, out);
+			break;
+		case 6:
+			analyzeSCC(pathFileTasks, in, out);
+			break;
+		case 7:
+			huffmanEncodingTaskMenu(pathFileTasks, in, out);
+			break;
+		case 8:
+			return 0;
+		default:
+			out << "\nInvalid choice. Please try again.\n";
+			enterToContinue(in, out);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Displays and handles the deadline settings menu.
+ *
+ * This function displays the deadline settings menu and processes user input to assign or view deadlines.
+ *
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the menu and messages.
+ * @return int Returns 0 when the user chooses to exit the menu.
+ */
+int deadlineSettingsMenu(istream& in, ostream& out) {
+	int choice;
+
+	while (true) {
+		printDeadlineSettingsMenu(out);
+		choice = getInput(in);
+
+		if (in.fail()) { handleInputError(in, out); continue; }
+
+		switch (choice) {
+		case 1:
+			assignDeadline(pathFileTasks, in, out);
+			break;
+		case 2:
+			viewDeadlines(pathFileTasks, in, out);
+			break;
+		case 3:
+			return 0;
+		default:
+			out << "\nInvalid choice. Please try again.\n";
+			enterToContinue(in, out);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Displays and handles the reminder system menu.
+ *
+ * This function displays the reminder system menu and processes user input to set reminders or manage notification settings.
+ *
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the menu and messages.
+ * @return int Returns 0 when the user chooses to exit the menu.
+ */
+int reminderSystemMenu(istream& in, ostream& out) {
+	int choice;
+
+	while (true) {
+		printReminderSystemMenu(out);
+		choice = getInput(in);
+
+		if (in.fail()) { handleInputError(in, out); continue; }
+
+		switch (choice) {
+		case 1:
+			setReminders(in, out);
+			break;
+		case 2:
+			notificationSettings(in, out);
+			break;
+		case 3:
+			return 0;
+		default:
+			out << "\nInvalid choice. Please try again.\n";
+			enterToContinue(in, out);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Displays and handles the task prioritization menu.
+ *
+ * This function displays the task prioritization menu and processes user input to mark task importance, reorder tasks, calculate MST, find the shortest path, or plan the schedule.
+ *
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the menu and messages.
+ * @return int Returns 0 when the user chooses to exit the menu.
+ */
+int taskPrioritizationMenu(istream& in, ostream& out) {
+	int choice;
+
+	while (true) {
+		printTaskPrioritizationMenu(out);
+		choice = getInput(in);
+
+		if (in.fail()) { handleInputError(in, out); continue; }
+
+		switch (choice) {
+		case 1:
+			markTaskImportance(pathFileTasks, in, out);
+			break;
+		case 2:
+			reorderTask(pathFileTasks, in, out);
+			break;
+		case 3:
+			calculateMST(in, out);
+			break;
+		case 4:
+			shortestPath(in, out);
+			break;
+		case 5:
+			planSchedule(pathFileTasks, in, out);
+			break;
+		case 6:
+			return 0;
+		default:
+			out << "\nInvalid choice. Please try again.\n";
+			enterToContinue(in, out);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Displays and handles the flow algorithms menu.
+ *
+ * This function displays the flow algorithms menu and processes user input to choose between the Ford-Fulkerson and Edmonds-Karp algorithms for calculating maximum flow.
+ *
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the menu and messages.
+ * @return int Returns 0 when the user chooses to exit the menu.
+ */
+int flowAlgorithmsMenu(istream& in, ostream& out) {
+	int choice;
+	int source, sink;
+	int V = MAX_TASKS;
+	int** graph = new int* [V];
+	for (int i = 0; i < V; i++) {
+		graph[i] = new int[V]();
+	}
+
+	while (true) {
+		printFlowAlgorithmsMenu(out);
+		choice = getInput(in);
+
+		if (in.fail()) { handleInputError(in, out); continue; }
+
+		if (choice == 3) {
+			for (int i = 0; i < V; i++) {
+				delete[] graph[i];
+			}
+			delete[] graph;
+			return 0;
+		}
+
+		viewTaskForFunc(pathFileTasks, in, out);
+		out << "\nEnter the source task ID:\n";
+		source = getInput(in);
+		out << "Enter the sink task ID:\n";
+		sink = getInput(in);
+
+		if (source < 0 || source >= V || sink < 0 || sink >= V) {
+			out << "Invalid task ID.\n";
+			enterToContinue(in, out);
+			continue;
+		}
+
+		syncTaskGraph(pathFileTasks);
+
+		int maxFlow = 0;
+		if (choice == 1) {
+			maxFlow = fordFulkerson(graph, source, sink, V);
+		}
+		else if (choice == 2) {
+			maxFlow = edmondsKarp(graph, source, sink, V);
+		}
+		else {
+			out << "Invalid choice.\n";
+			enterToContinue(in, out);
+			continue;
+		}
+
+		out << "Maximum flow from task " << source << " to task " << sink << " is: " << maxFlow << endl;
+		enterToContinue(in, out);
+	}
+}
+
+
+//MENUS
+
+/**
+ * @brief Displays and handles viewing tasks.
+ *
+ * This function clears the screen and displays all tasks owned by the logged-in user.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the tasks and messages.
+ * @return bool Always returns true.
+ */
+bool viewTask(const char* pathFileTasks, istream& in, ostream& out) {
 	clearScreen();
-	Task* tasks = nullptr;
-	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
-	int uncategorizedTaskCount = 0;
+	Task* tasks = NULL;
+	int skipped = 0;
+	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id, &skipped);
+	if (skipped > 0) {
+		out << "Skipped " << skipped << " modified task record(s)." << endl;
+	}
 
-	for (int i = 0; i < taskCount; ++i) {
-		if (!tasks[i].isCategorized) {
+	if (taskCount <= 0) {
+		out << "No Task Created.\n";
+	}
+	else {
+		for (int i = 0; i < taskCount; i++) {
 			out << "ID: " << tasks[i].id << ", Name: " << tasks[i].name
-				<< ", Description: " << tasks[i].description << endl;
-			uncategorizedTaskCount++;
+				<< ", Description: " << tasks[i].description << ", Category: "
+				<< tasks[i].category << ", Deadline: " << tasks[i].deadLine << endl;
+		}
+	}
+
+	enterToContinue(in, out);
+	free(tasks);
+	return true;
+}
+
+/**
+ * @brief Displays tasks for function usage.
+ *
+ * This function clears the screen and displays all tasks owned by the logged-in user without waiting for user input.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the tasks and messages.
+ * @return bool Always returns true.
+ */
+bool viewTaskForFunc(const char* pathFileTasks, istream& in, ostream& out) {
+	clearScreen();
+	Task* tasks = NULL;
+	int skipped = 0;
+	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id, &skipped);
+	if (skipped > 0) {
+		out << "Skipped " << skipped << " modified task record(s)." << endl;
+	}
+
+	if (taskCount <= 0) {
+		out << "No Task Created.\n";
+	}
+	else {
+		for (int i = 0; i < taskCount; i++) {
+			out << "ID: " << tasks[i].id << ", Name: " << tasks[i].name
+				<< ", Description: " << tasks[i].description << ", Category: "
+				<< tasks[i].category << ", Deadline: " << tasks[i].deadLine << endl;
+		}
+	}
+
+	free(tasks);
+	return true;
+}
+
+/**
+ * @brief Displays tasks with deadlines.
+ *
+ * This function clears the screen and displays all tasks owned by the logged-in user that have deadlines assigned.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the tasks and messages.
+ * @return bool Always returns true.
+ */
+bool viewDeadlines(const char* pathFileTasks, istream& in, ostream& out) {
+	clearScreen();
+	Task* tasks = nullptr;
+	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
+
+	if (taskCount <= 0) {
+		out << "No Task Created or Assigned to You." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return false;
+	}
+
+	bool hasDeadlines = false;
+	for (int i = 0; i < taskCount; ++i) {
+		if (tasks[i].isDeadlined) {
+			out << "ID: " << tasks[i].id << ", Name: " << tasks[i].name
+				<< ", Description: " << tasks[i].description << ", Category: "
+				<< tasks[i].category << ", Deadline: " << tasks[i].deadLine << endl;
+			hasDeadlines = true;
+		}
+	}
+
+	if (!hasDeadlines) {
+		out << "No Task with Deadline Assigned to You." << endl;
+	}
+
+	enterToContinue(in, out);
+	free(tasks);
+	return true;
+}
+
+/**
+ * @brief Loads all tasks from the binary file.
+ *
+ * This function loads all tasks from the specified binary file and stores them in the provided array.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param tasks Pointer to an array of Task objects.
+ * @param skipped Receives the number of records skipped because they failed verification, may be nullptr.
+ * @return int The number of tasks loaded.
+ */
+int loadTasks(const char* pathFileTasks, Task** tasks, int* skipped) {
+	FILE* file = openTasksFile(pathFileTasks);
+	if (!file) {
+		printf("Failed to open file\n");
+		return -1;
+	}
+
+	Task temp;
+	int count = 0;
+	if (skipped) {
+		*skipped = 0;
+	}
+	while (readTaskRecord(file, &temp, skipped)) {
+		*tasks = (Task*)realloc(*tasks, (count + 1) * sizeof(Task));
+		(*tasks)[count] = temp;
+		count++;
+	}
+	fclose(file);
+	return count;
+}
+
+/**
+ * @brief Loads tasks owned by a specific user from the binary file.
+ *
+ * This function loads tasks owned by the specified user from the binary file and stores them in the provided array.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param tasks Pointer to an array of Task objects.
+ * @param userId The ID of the user whose tasks are to be loaded.
+ * @param skipped Receives the number of records skipped because they failed verification, may be nullptr.
+ * @return int The number of tasks loaded.
+ */
+int loadOwnedTasks(const char* pathFileTasks, Task** tasks, int userId, int* skipped) {
+	FILE* file = openTasksFile(pathFileTasks);
+	if (!file) {
+		printf("Failed to open file\n");
+		return -1;
+	}
+
+	Task temp;
+	int count = 0;
+	if (skipped) {
+		*skipped = 0;
+	}
+	while (readTaskRecord(file, &temp, skipped)) {
+		if (temp.owner.id == userId) {
+			*tasks = (Task*)realloc(*tasks, (count + 1) * sizeof(Task));
+			(*tasks)[count] = temp;
+			count++;
+		}
+	}
+	fclose(file);
+	return count;
+}
+
+/**
+ * @brief Adds a new task to the binary file.
+ *
+ * This function appends a new task to the specified binary file, creating it or converting an untagged one first.
+ *
+ * @param newTask Pointer to the Task object to be added.
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @return int Returns 1 if the task is added successfully, otherwise 0.
+ */
+int addTask(const Task* newTask, const char* pathFileTasks) {
+	// The graph only follows the append if it was in step with the file right before it
+	long long fileSize = -1;
+	long long fileTime = -1;
+	bool inStep = taskGraphPath == pathFileTasks && fileStamp(pathFileTasks, &fileSize, &fileTime)
+		&& fileSize == taskGraphFileSize && fileTime == taskGraphFileTime;
+
+	// A file the graph was loaded from is already in the current layout
+	if (!inStep && upgradeTasksFile(pathFileTasks) == RECORD_FILE_UNSUPPORTED) {
+		return 0;
+	}
+	FILE* file = fopen(pathFileTasks, "ab");
+	if (!file) {
+		return 0;
+	}
+	fseek(file, 0, SEEK_END);
+	if (ftell(file) == 0 && !writeRecordFileHeader(file, TASK_FILE_MAGIC, sizeof(Task))) {
+		fclose(file);
+		return 0;
+	}
+
+	Task record = *newTask;
+	writeTaskRecord(file, &record);
+	fclose(file);
+
+	if (inStep) {
+		bool planned = taskPlan.generation == taskGraph.generation;
+		addTaskToGraph(&taskGraph, &record);
+		fileStamp(pathFileTasks, &taskGraphFileSize, &taskGraphFileTime);
+		if (planned) {
+			addTaskToPlan(taskGraph, &taskPlan, &record, DEFAULT_TASK_DURATION);
+		}
+	}
+	return 1;
+}
+
+/**
+ * @brief Displays and handles the add task menu.
+ *
+ * This function displays the add task menu and processes user input to add a new task. Dependencies that would
+ * close a cycle in the task graph are reported and left out.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the menu and messages.
+ * @return int Returns 1 if the task is added successfully, otherwise 0.
+ */
+int addTaskMenu(const char* pathFileTasks, istream& in, ostream& out) {
+	clearScreen();
+	Task newTask;
+
+	out << "Enter Task Name: ";
+	in.getline(newTask.name, sizeof(newTask.name));
+
+	out << "Enter Task Description: ";
+	in.getline(newTask.description, sizeof(newTask.description));
+
+	newTask.owner = loggedUser;
+	newTask.id = getNewTaskId(pathFileTasks);
+	newTask.isCategorized = false;
+	newTask.isDeadlined = false;
+	newTask.impid = 0;
+	newTask.category[0] = '\0';
+	newTask.deadLine[0] = '\0';
+	newTask.numDependencies = 0;
+
+	out << "Enter number of dependencies for this task: ";
+	int numDeps;
+	in >> numDeps;
+	in.ignore();
+	newTask.numDependencies = numDeps;
+
+	for (int i = 0; i < numDeps; i++) {
+		out << "Enter dependency task ID #" << (i + 1) << ": ";
+		in >> newTask.dependencies[i];
+		in.ignore();
+	}
+
+	if (numDeps > 0) {
+		const TaskGraph& graph = syncTaskGraph(pathFileTasks);
+		int kept = 0;
+		for (int i = 0; i < numDeps; i++) {
+			if (dependencyCreatesCycle(graph, newTask.id, newTask.dependencies[i])) {
+				out << "Dependency on task " << newTask.dependencies[i] << " would create a cycle and was skipped.\n";
+				continue;
+			}
+			newTask.dependencies[kept++] = newTask.dependencies[i];
+		}
+		newTask.numDependencies = kept;
+	}
+
+	if (!addTask(&newTask, pathFileTasks)) {
+		out << "Failed to add Task.\n";
+		enterToContinue(in, out);
+		return 0;
+	}
+
+	out << "Task added successfully.\n";
+	enterToContinue(in, out);
+	return 1;
+}
+
+/**
+ * @brief Displays and handles the categorize task menu.
+ *
+ * This function displays the categorize task menu and processes user input to categorize tasks.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the menu and messages.
+ * @return int Returns 1 if the task is categorized successfully, otherwise 0.
+ */
+int categorizeTask(const char* pathFileTasks, istream& in, ostream& out) {
+	clearScreen();
+	Task* tasks = nullptr;
+	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
+	int uncategorizedTaskCount = 0;
+
+	for (int i = 0; i < taskCount; ++i) {
+		if (!tasks[i].isCategorized) {
+			out << "ID: " << tasks[i].id << ", Name: " << tasks[i].name
+				<< ", Description: " << tasks[i].description << endl;
+			uncategorizedTaskCount++;
+		}
+	}
+
+	if (taskCount <= 0 || uncategorizedTaskCount == 0) {
+		out << "No tasks available to categorize." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+
+	out << "\nEnter the ID of the task you want to categorize: ";
+	int selectedTaskId = getInput(in);
+
+	Task* selectedTask = nullptr;
+	for (int i = 0; i < taskCount; ++i) {
+		if (tasks[i].id == selectedTaskId && !tasks[i].isCategorized) {
+			selectedTask = &tasks[i];
+			break;
+		}
+	}
+
+	if (!selectedTask) {
+		out << "Invalid task ID. Please try again." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+
+	out << "Select a category for the task:" << endl;
+	out << "1. Work" << endl;
+	out << "2. Sport" << endl;
+	out << "3. Diet" << endl;
+	out << "4. Study" << endl;
+
+	int categoryChoice = getInput(in);
+
+	switch (categoryChoice) {
+	case 1:
+		strcpy(selectedTask->category, "Work");
+		break;
+	case 2:
+		strcpy(selectedTask->category, "Sport");
+		break;
+	case 3:
+		strcpy(selectedTask->category, "Diet");
+		break;
+	case 4:
+		strcpy(selectedTask->category, "Study");
+		break;
+	default:
+		out << "Invalid category choice. Please try again." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+
+	selectedTask->isCategorized = true;
+
+	FILE* file = createTasksFile(pathFileTasks);
+
+	for (int i = 0; i < taskCount; ++i) {
+		writeTaskRecord(file, &tasks[i]);
+	}
+
+	fclose(file);
+	taskGraphPath.clear();
+	out << "Task categorized successfully." << endl;
+	enterToContinue(in, out);
+	free(tasks);
+	return 1;
+}
+
+/**
+ * @brief Displays and handles the assign deadline menu.
+ *
+ * This function displays the assign deadline menu and processes user input to assign deadlines to tasks.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the menu and messages.
+ * @return int Returns 1 if the deadline is assigned successfully, otherwise 0.
+ */
+int assignDeadline(const char* pathFileTasks, istream& in, ostream& out) {
+	clearScreen();
+	Task* tasks = nullptr;
+	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
+	int unDeadlinedTaskCount = 0;
+
+	for (int i = 0; i < taskCount; ++i) {
+		if (!tasks[i].isDeadlined) {
+			out << "ID: " << tasks[i].id << ", Name: " << tasks[i].name
+				<< ", Description: " << tasks[i].description << endl;
+			unDeadlinedTaskCount++;
+		}
+	}
+
+	if (taskCount <= 0 || unDeadlinedTaskCount == 0) {
+		out << "No Tasks Available To Add Deadline." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+
+	out << "\nEnter The ID Of The Task You Want To Add Deadline: ";
+	int selectedTaskId = getInput(in);
+
+	Task* selectedTask = nullptr;
+	for (int i = 0; i < taskCount; ++i) {
+		if (tasks[i].id == selectedTaskId && !tasks[i].isDeadlined) {
+			selectedTask = &tasks[i];
+			break;
+		}
+	}
+
+	if (!selectedTask) {
+		out << "Invalid Task ID. Please Try again." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+
+	out << "Enter Deadline Day (1-31): ";
+	int day = getInput(in);
+	out << "Enter Deadline Month (1-12): ";
+	int month = getInput(in);
+	out << "Enter Deadline Year: ";
+	int year = getInput(in);
+
+	if (day < 1 || day > 31 || month < 1 || month > 12 || year < 0) {
+		out << "Invalid date. Please enter valid day, month, and year." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+
+	stringstream deadlineStream;
+	deadlineStream << day << "/" << month << "/" << year;
+	string deadlineStr = deadlineStream.str();
+
+	strncpy(selectedTask->deadLine, deadlineStr.c_str(), sizeof(selectedTask->deadLine) - 1);
+	selectedTask->deadLine[sizeof(selectedTask->deadLine) - 1] = '\0';
+
+	selectedTask->isDeadlined = true;
+
+	FILE* file = createTasksFile(pathFileTasks);
+	for (int i = 0; i < taskCount; ++i) {
+		writeTaskRecord(file, &tasks[i]);
+	}
+	fclose(file);
+	taskGraphPath.clear();
+
+	out << "Deadline Added Successfully." << endl;
+	enterToContinue(in, out);
+	free(tasks);
+	return 1;
+}
+
+/**
+ * @brief Sets a reminder.
+ *
+ * This function sets a reminder for a specified duration.
+ *
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying messages.
+ * @return int Always returns 0.
+ */
+int setReminders(istream& in, ostream& out) {
+	int seconds, minutes, hours, days;
+
+	out << "Enter the reminder duration:" << endl;
+	out << "Seconds: ";
+	seconds = getInput(in);
+	out << "Minutes: ";
+	minutes = getInput(in);
+	out << "Hours: ";
+	hours = getInput(in);
+	out << "Days: ";
+	days = getInput(in);
+
+	int totalSeconds = seconds + minutes * 60 + hours * 3600 + days * 86400;
+
+	if (totalSeconds <= 0) {
+		out << "Invalid duration. Please enter a positive duration." << endl;
+		enterToContinue(in, out);
+		return 0;
+	}
+
+	out << "Setting reminder for " << totalSeconds << " seconds..." << endl;
+	this_thread::sleep_for(chrono::seconds(totalSeconds));
+	out << "Time's up! Reminder triggered after " << totalSeconds << " seconds." << endl;
+
+	enterToContinue(in, out);
+	return 0;
+}
+
+/**
+ * @brief Manages notification settings.
+ *
+ * This function displays and processes user input for managing notification settings.
+ *
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying messages.
+ * @return int Always returns 0.
+ */
+int notificationSettings(istream& in, ostream& out) {
+	int choice;
+
+	out << "Select notification method:" << endl;
+	out << "1. SMS" << endl;
+	out << "2. E-Mail" << endl;
+	out << "3. Notification" << endl;
+	out << "Enter your choice: ";
+	choice = getInput(in);
+
+	switch (choice) {
+	case 1:
+		out << "Your reminder has been set to SMS." << endl;
+		enterToContinue(in, out);
+		break;
+	case 2:
+		out << "Your reminder has been set to E-Mail." << endl;
+		enterToContinue(in, out);
+		break;
+	case 3:
+		out << "Your reminder has been set to Notification." << endl;
+		enterToContinue(in, out);
+		break;
+	default:
+		out << "Invalid choice. Please try again." << endl;
+		enterToContinue(in, out);
+		break;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Marks the importance of a task.
+ *
+ * This function displays tasks and allows the user to mark the importance of a selected task.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the menu and messages.
+ * @return int Returns 1 if the importance is marked successfully, otherwise 0.
+ */
+int markTaskImportance(const char* pathFileTasks, istream& in, ostream& out) {
+	clearScreen();
+	Task* tasks = nullptr;
+	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
+	bool taskAlreadyMarked = false;
+	int unMarkedTaskCount = 0;
+
+	for (int i = 0; i < taskCount; ++i) {
+		if (tasks[i].impid == 0 && !taskAlreadyMarked) {
+			out << "ID: " << tasks[i].id << ", Name: " << tasks[i].name
+				<< ", Description: " << tasks[i].description << endl;
+			unMarkedTaskCount++;
+		}
+	}
+
+	if (taskCount <= 0 || unMarkedTaskCount == 0) {
+		out << "No tasks available to mark importance." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+	out << "Select the task to mark importance by entering its ID:" << endl;
+
+	int selectedTaskId;
+	selectedTaskId = getInput(in);
+
+	Task* selectedTask = nullptr;
+	for (int i = 0; i < taskCount; ++i) {
+		if (tasks[i].id == selectedTaskId && tasks[i].impid == 0) {
+			selectedTask = &tasks[i];
+			taskAlreadyMarked = true;
+			break;
+		}
+	}
+
+	if (!selectedTask) {
+		out << "Invalid task ID. Please try again." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+
+	out << "Enter the importance ID for the task: ";
+	int importanceId;
+	importanceId = getInput(in);
+
+	if (importanceId < 0) {
+		out << "Invalid input" << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+
+	selectedTask->impid = importanceId;
+
+	FILE* file = createTasksFile(pathFileTasks);
+	if (!file) {
+		out << "Failed to open file for writing." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+
+	for (int i = 0; i < taskCount; ++i) {
+		if (tasks[i].id == selectedTaskId) {
+			writeTaskRecord(file, selectedTask);
+		}
+		else {
+			writeTaskRecord(file, &tasks[i]);
+		}
+	}
+	fclose(file);
+	taskGraphPath.clear();
+
+	out << "Task importance marked successfully." << endl;
+	enterToContinue(in, out);
+	free(tasks);
+	return 1;
+}
+
+/**
+ * @brief Reorders tasks based on importance.
+ *
+ * This function displays tasks and allows the user to reorder a selected task by changing its importance ID.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the menu and messages.
+ * @return int Returns 1 if the task is reordered successfully, otherwise 0.
+ */
+int reorderTask(const char* pathFileTasks, istream& in, ostream& out) {
+	clearScreen();
+	Task* tasks = nullptr;
+	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
+	int reorderedTaskCount = 0;
+
+	out << "Tasks with importance ID:" << endl;
+	for (int i = 0; i < taskCount; ++i) {
+		if (tasks[i].impid != 0) {
+			out << "ID: " << tasks[i].id << ", Importance ID: " << tasks[i].impid
+				<< ", Name: " << tasks[i].name << ", Description: " << tasks[i].description
+				<< ", Category: " << tasks[i].category << ", Deadline: " << tasks[i].deadLine << endl;
+			reorderedTaskCount++;
+		}
+	}
+
+	if (taskCount <= 0 || reorderedTaskCount == 0) {
+		out << "No tasks available to reorder." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+
+	out << "Enter the id of the task to reorder :" << endl;
+	int selectedTaskId;
+	selectedTaskId = getInput(in);
+
+	Task* selectedTask = nullptr;
+	for (int i = 0; i < taskCount; ++i) {
+		if (tasks[i].id == selectedTaskId && tasks[i].impid != 0) {
+			selectedTask = &tasks[i];
+			break;
+		}
+	}
+
+	if (!selectedTask) {
+		out << "Invalid task ID. Please try again." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+
+	out << "Enter the new importance ID for the task: ";
+	int newImportanceId;
+	newImportanceId = getInput(in);
+
+	selectedTask->impid = newImportanceId;
+
+	FILE* file = createTasksFile(pathFileTasks);
+	for (int i = 0; i < taskCount; ++i) {
+		writeTaskRecord(file, &tasks[i]);
+	}
+	fclose(file);
+	taskGraphPath.clear();
+
+	out << "Task reordered successfully." << endl;
+	enterToContinue(in, out);
+	free(tasks);
+	return 1;
+}
+
+/**
+ * @brief Finds and displays the most similar tasks based on their descriptions.
+ *
+ * This function compares tasks based on their descriptions and finds the two most similar tasks using the longest common subsequence algorithm.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the results.
+ * @return bool Always returns true.
+ */
+bool similarTasks(const char* pathFileTasks, istream& in, ostream& out) {
+	clearScreen();
+	Task* tasks = nullptr;
+	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
+
+	if (taskCount < 2) {
+		out << "Insufficient number of tasks, at least two tasks are required." << endl;
+		return false;
+	}
+
+	int maxLcs = 0;
+	int task1Index = -1, task2Index = -1;
+
+	for (int i = 0; i < taskCount - 1; i++) {
+		for (int j = i + 1; j < taskCount; j++) {
+			int lcsLength = longestCommonSubsequence(tasks[i].description, tasks[j].description);
+			if (lcsLength > maxLcs) {
+				maxLcs = lcsLength;
+				task1Index = i;
+				task2Index = j;
+			}
+		}
+	}
+
+	if (task1Index != -1 && task2Index != -1) {
+		out << "The two most similar tasks are:" << endl;
+		out << "Task 1: " << tasks[task1Index].description << endl;
+		out << "Task 2: " << tasks[task2Index].description << endl;
+		enterToContinue(in, out);
+	}
+	else {
+		out << "No similar task found." << endl;
+		enterToContinue(in, out);
+	}
+	free(tasks);
+	return true;
+}
+
+/**
+ * @brief Displays and handles the task allegiances menu.
+ *
+ * This function displays the task allegiances menu and processes user input to perform BFS or DFS on the tasks.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the menu and messages.
+ * @return bool Always returns true.
+ */
+bool allegiances(const char* pathFileTasks, istream& in, ostream& out) {
+	clearScreen();
+	Task* tasks = nullptr;
+	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
+	int choice, startVertex;
+
+	if (taskCount <= 0) {
+		out << "No Tasks Available." << endl;
+		enterToContinue(in, out);
+		free(tasks);
+		return 0;
+	}
+	free(tasks);
+
+	out << "Choose algorithm:\n 1. BFS\n 2. DFS\n";
+	choice = getInput(in);
+
+	viewTaskForFunc(pathFileTasks, in, out);
+
+	out << "\nEnter the starting task ID:\n";
+	startVertex = getInput(in);
+
+	if (startVertex < 0) {
+		out << "Invalid task ID." << endl;
+		enterToContinue(in, out);
+		return 0;
+	}
+
+	syncTaskGraph(pathFileTasks);
+
+	int result = 0;
+	switch (choice) {
+	case 1:
+		result = directionOptimizingBFS(taskGraph, startVertex, 0, nullptr);
+		break;
+	case 2:
+		result = DFS(startVertex);
+		break;
+	default:
+		out << "Wrong Input ";
+		enterToContinue(in, out);
+		return 0;
+	}
+
+	out << "Number of tasks connected to task " << startVertex << " is: " << result << endl;
+	enterToContinue(in, out);
+	return true;
+}
+
+/**
+ * @brief Calculates and displays the minimum spanning tree (MST) of the tasks.
+ *
+ * This function displays the MST menu and processes user input to calculate the MST using Prim's or Kruskal's algorithm.
+ *
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the results.
+ * @return bool Always returns true.
+ */
+bool calculateMST(istream& in, ostream& out) {
+	viewTaskForFunc(pathFileTasks, in, out);
+	out << "\nEnter the starting task ID:\n";
+	int startVertex = getInput(in);
+
+	if (startVertex < 0) {
+		out << "Invalid task ID." << endl;
+		enterToContinue(in, out);
+		return false;
+	}
+
+	syncTaskGraph(pathFileTasks);
+
+	out << "Choose MST algorithm:\n 1. Prim's Algorithm\n 2. Kruskal's Algorithm\n";
+	int mstChoice = getInput(in);
+
+	if (mstChoice == 1) {
+		primMST(startVertex, out);
+	}
+	else if (mstChoice == 2) {
+		kruskalMST((int)taskGraph.ids.size(), out);
+	}
+	else {
+		out << "Invalid choice." << endl;
+	}
+
+	enterToContinue(in, out);
+	return true;
+}
+
+/**
+ * @brief Calculates and displays the shortest path between tasks.
+ *
+ * This function displays the shortest path menu and processes user input to calculate the shortest path using Dijkstra's, Bellman-Ford
+ * or parallel delta-stepping algorithm.
+ * With Dijkstra's algorithm a target task may be given, in which case the route to it is displayed.
+ *
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the results.
+ * @return bool Always returns true.
+ */
+bool shortestPath(istream& in, ostream& out) {
+	viewTaskForFunc(pathFileTasks, in, out);
+	out << "\nEnter the starting task ID:\n";
+	int startVertex = getInput(in);
+
+	if (startVertex < 0) {
+		out << "Invalid task ID.\n";
+		enterToContinue(in, out);
+		return false;
+	}
+
+	syncTaskGraph(pathFileTasks);
+
+	out << "Choose shortest path algorithm:\n 1. Dijkstra\n 2. Bellman-Ford\n 3. Delta-stepping (parallel)\n";
+	int choice = getInput(in);
+
+	switch (choice) {
+	case 1: {
+		out << "Enter the target task ID (0 for all tasks):\n";
+		int targetVertex = getInput(in);
+		if (targetVertex <= 0) {
+			calculateShortestPath(startVertex, out);
+			break;
+		}
+
+		vector<int> route;
+		int distance = findShortestRoute(taskGraph, startVertex, targetVertex, &route);
+		if (distance < 0) {
+			out << "Task " << targetVertex << " cannot be reached from task " << startVertex << ".\n";
+			break;
+		}
+		out << "Shortest route:";
+		for (size_t i = 0; i < route.size(); i++) {
+			out << (i == 0 ? " " : " -> ") << route[i];
+		}
+		out << "\nDistance: " << distance << "\n";
+		break;
+	}
+	case 2:
+		calculateBellmanFord(startVertex, (int)taskGraph.ids.size(), out);
+		break;
+	case 3:
+		calculateDeltaStepping(startVertex, out);
+		break;
+	default:
+		out << "Invalid choice.\n";
+		enterToContinue(in, out);
+		return false;
+	}
+
+	enterToContinue(in, out);
+	return true;
+}
+
+/**
+ * @brief Path of the file that keeps the planned task durations of a task file.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @return string The path of the duration file next to the task file.
+ */
+static string taskPlanPath(const char* pathFileTasks) {
+	return string(pathFileTasks) + ".plan";
+}
+
+/**
+ * @brief Reads the planned task durations saved for a task file.
+ *
+ * Each line of the duration file holds a task id and its duration. A missing file or a malformed line ends the
+ * read, and the tasks not read keep the default duration.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @return unordered_map<int, int> The saved duration of each task id.
+ */
+static unordered_map<int, int> loadPlannedDurations(const char* pathFileTasks) {
+	unordered_map<int, int> durations;
+	FILE* file = fopen(taskPlanPath(pathFileTasks).c_str(), "r");
+	if (!file) {
+		return durations;
+	}
+
+	int taskId;
+	int duration;
+	while (fscanf(file, "%d %d", &taskId, &duration) == 2) {
+		if (duration >= 0) {
+			durations[taskId] = duration;
+		}
+	}
+	fclose(file);
+	return durations;
+}
+
+/**
+ * @brief Saves the durations in taskPlan next to the task file so they survive a restart.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @return bool Returns true if the durations were saved, otherwise false.
+ */
+static bool savePlannedDurations(const char* pathFileTasks) {
+	FILE* file = fopen(taskPlanPath(pathFileTasks).c_str(), "w");
+	if (!file) {
+		return false;
+	}
+
+	for (size_t i = 0; i < taskPlan.ids.size(); i++) {
+		fprintf(file, "%d %d\n", taskPlan.ids[i], taskPlan.durations[i]);
+	}
+	return fclose(file) == 0;
+}
+
+/**
+ * @brief Brings taskPlan in step with taskGraph.
+ *
+ * The plan is recomputed only if the graph changed in a way addTask did not pass on. Tasks get the durations
+ * saved for the task file, tasks without one get DEFAULT_TASK_DURATION.
+ *
+ * @param pathFileTasks Path to the binary file taskGraph was loaded from.
+ * @return bool Returns true if the plan is in step, false if the task graph has a cycle.
+ */
+static bool syncTaskPlan(const char* pathFileTasks) {
+	if (taskPlan.generation == taskGraph.generation) {
+		return true;
+	}
+
+	unordered_map<int, int> known = loadPlannedDurations(pathFileTasks);
+	vector<int> durations(taskGraph.ids.size(), DEFAULT_TASK_DURATION);
+	for (size_t v = 0; v < taskGraph.ids.size(); v++) {
+		unordered_map<int, int>::const_iterator it = known.find(taskGraph.ids[v]);
+		if (it != known.end()) {
+			durations[v] = it->second;
+		}
+	}
+	return planTaskGraph(taskGraph, durations, &taskPlan);
+}
+
+/**
+ * @brief Displays and handles the plan schedule menu.
+ *
+ * This function lets the user set task durations and then displays the earliest and latest start, the slack and
+ * the critical path of every task. Durations are saved next to the task file, so they are kept between calls and
+ * across restarts, and each change only updates the tasks it affects.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @param in Input stream for reading user input.
+ * @param out Output stream for displaying the results.
+ * @return bool Returns true if a schedule was displayed, false if the task dependencies form a cycle.
+ */
+bool planSchedule(const char* pathFileTasks, istream& in, ostream& out) {
+	clearScreen();
+	syncTaskGraph(pathFileTasks);
+
+	if (!syncTaskPlan(pathFileTasks)) {
+		out << "The task dependencies form a cycle, so no schedule can be planned.\n";
+		enterToContinue(in, out);
+		return false;
+	}
+
+	bool changed = false;
+	while (true) {
+		out << "Enter a task ID to set its duration (0 to finish): ";
+		int taskId = getInput(in);
+		if (taskId == 0 || taskId == -1) {
+			break;
+		}
+
+		out << "Enter the duration: ";
+		int duration = getInput(in);
+		if (duration < 0 || !setPlannedDuration(taskGraph, &taskPlan, taskId, duration)) {
+			out << "Invalid task ID or duration.\n";
+		}
+		else {
+			changed = true;
+		}
+	}
+
+	if (changed && !savePlannedDurations(pathFileTasks)) {
+		out << "The durations could not be saved.\n";
+	}
+
+	printTaskPlan(taskGraph, taskPlan, out);
+	enterToContinue(in, out);
+	return true;
+}
+
+//Algorithms
+
+
+/**
+ * @brief Loads tasks and their dependencies from the binary file.
+ *
+ * This function reads tasks from the specified binary file and rebuilds the task graph from their dependencies.
+ * A dependency of task u on task v becomes an edge of weight u + v. Only the ids and the dependencies are kept
+ * while reading, so large task files are not held in memory. Use syncTaskGraph to skip the reload when the
+ * graph already reflects the file.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @return bool Returns true if tasks are loaded successfully, otherwise false.
+ */
+bool loadTasksAndDependencies(const char* pathFileTasks) {
+	FILE* file = openTasksFile(pathFileTasks);
+	if (!file) {
+		cout << "Failed to open task file." << endl;
+		buildTaskGraph(vector<int>(), vector<Edge>(), &taskGraph);
+		taskGraphPath.clear();
+		taskGraphFileSize = -1;
+		taskGraphFileTime = -1;
+		return false;
+	}
+
+	vector<int> taskIds;
+	vector<Edge> dependencies;
+	Task task;
+	while (readTaskRecord(file, &task, nullptr)) {
+		taskIds.push_back(task.id);
+		int numDependencies = min(max(task.numDependencies, 0), 10);
+		for (int i = 0; i < numDependencies; i++) {
+			int depId = task.dependencies[i];
+			int weight = task.id + depId;
+			dependencies.push_back({ task.id, depId, weight });
+		}
+	}
+	fclose(file);
+	taskGraphPath = pathFileTasks;
+	if (!fileStamp(pathFileTasks, &taskGraphFileSize, &taskGraphFileTime)) {
+		taskGraphFileSize = -1;
+		taskGraphFileTime = -1;
+	}
+
+	buildTaskGraph(taskIds, dependencies, &taskGraph);
+	return true;
+}
+
+/**
+ * @brief Returns the task graph of a task file, loading it only if needed.
+ *
+ * The graph is reloaded when it was built from another file or when the size or the modification time of the file
+ * changed since, which covers records appended, dropped or rewritten by other writers. Appends made through addTask
+ * are applied to the graph directly and do not cause a reload.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks.
+ * @return const TaskGraph& The task graph, empty if the file cannot be read.
+ */
+const TaskGraph& syncTaskGraph(const char* pathFileTasks) {
+	long long fileSize = -1;
+	long long fileTime = -1;
+	fileStamp(pathFileTasks, &fileSize, &fileTime);
+
+	if (taskGraphPath != pathFileTasks || fileSize != taskGraphFileSize || fileTime != taskGraphFileTime) {
+		loadTasksAndDependencies(pathFileTasks);
+	}
+	return taskGraph;
+}
+
+/**
+ * @brief Builds a task graph in compressed sparse row form.
+ *
+ * Every task id and every id named by a dependency becomes a vertex. Each dependency is stored once as a directed
+ * arc from the task to the task it depends on, and in both directions as an undirected weighted edge. The arrays are
+ * filled with a counting pass and a prefix sum, so the build is linear in the number of tasks and dependencies.
+ *
+ * @param taskIds Ids of the tasks.
+ * @param dependencies One entry per dependency: src depends on dest, with the weight of the edge.
+ * @param graph Receives the graph; its previous contents are replaced.
+ */
+void buildTaskGraph(const vector<int>& taskIds, const vector<Edge>& dependencies, TaskGraph* graph) {
+	graph->generation++;
+	graph->ids = taskIds;
+	for (size_t i = 0; i < dependencies.size(); i++) {
+		graph->ids.push_back(dependencies[i].src);
+		graph->ids.push_back(dependencies[i].dest);
+	}
+	sort(graph->ids.begin(), graph->ids.end());
+	graph->ids.erase(unique(graph->ids.begin(), graph->ids.end()), graph->ids.end());
+
+	int n = (int)graph->ids.size();
+	graph->indexOf.clear();
+	graph->indexOf.reserve(n);
+	for (int v = 0; v < n; v++) {
+		graph->indexOf[graph->ids[v]] = v;
+	}
+
+	graph->offsets.assign(n + 1, 0);
+	graph->depOffsets.assign(n + 1, 0);
+	graph->dependentOffsets.assign(n + 1, 0);
+	vector<pair<int, int>> ends(dependencies.size());
+	for (size_t i = 0; i < dependencies.size(); i++) {
+		int u = graph->indexOf[dependencies[i].src];
+		int v = graph->indexOf[dependencies[i].dest];
+		ends[i] = make_pair(u, v);
+		graph->offsets[u + 1]++;
+		graph->offsets[v + 1]++;
+		graph->depOffsets[u + 1]++;
+		graph->dependentOffsets[v + 1]++;
+	}
+	for (int v = 0; v < n; v++) {
+		graph->offsets[v + 1] += graph->offsets[v];
+		graph->depOffsets[v + 1] += graph->depOffsets[v];
+		graph->dependentOffsets[v + 1] += graph->dependentOffsets[v];
+	}
+
+	graph->targets.resize(graph->offsets[n]);
+	graph->weights.resize(graph->offsets[n]);
+	graph->depTargets.resize(graph->depOffsets[n]);
+	graph->dependentTargets.resize(graph->dependentOffsets[n]);
+	vector<int> next(graph->offsets.begin(), graph->offsets.end() - 1);
+	vector<int> nextDep(graph->depOffsets.begin(), graph->depOffsets.end() - 1);
+	vector<int> nextDependent(graph->dependentOffsets.begin(), graph->dependentOffsets.end() - 1);
+	for (size_t i = 0; i < dependencies.size(); i++) {
+		int u = ends[i].first;
+		int v = ends[i].second;
+		int weight = dependencies[i].weight;
+		graph->targets[next[u]] = v;
+		graph->weights[next[u]++] = weight;
+		graph->targets[next[v]] = u;
+		graph->weights[next[v]++] = weight;
+		graph->depTargets[nextDep[u]++] = v;
+		graph->dependentTargets[nextDependent[v]++] = u;
+	}
+
+	// Kahn's algorithm: a task is placed once every task depending on it has been placed
+	graph->topoOrder.assign(n, -1);
+	vector<int> remaining(n);
+	vector<int> ready;
+	for (int v = 0; v < n; v++) {
+		remaining[v] = graph->dependentOffsets[v + 1] - graph->dependentOffsets[v];
+		if (remaining[v] == 0) {
+			ready.push_back(v);
+		}
+	}
+	for (size_t head = 0; head < ready.size(); head++) {
+		int u = ready[head];
+		graph->topoOrder[u] = (int)head;
+		for (int e = graph->depOffsets[u]; e < graph->depOffsets[u + 1]; e++) {
+			if (--remaining[graph->depTargets[e]] == 0) {
+				ready.push_back(graph->depTargets[e]);
+			}
+		}
+	}
+	graph->acyclic = (int)ready.size() == n;
+	if (!graph->acyclic) {
+		graph->topoOrder.clear();
+	}
+}
+
+/**
+ * @brief Inserts a vertex for a task id into a task graph.
+ *
+ * Ids above every existing id are appended; otherwise the vertex indexes after the new one are shifted up by one.
+ *
+ * @param graph The task graph, which must not contain the id yet.
+ * @param taskId The task id.
+ * @return int The vertex index of the task.
+ */
+static int insertGraphVertex(TaskGraph* graph, int taskId) {
+	int position = (int)(lower_bound(graph->ids.begin(), graph->ids.end(), taskId) - graph->ids.begin());
+	bool appended = position == (int)graph->ids.size();
+
+	graph->ids.insert(graph->ids.begin() + position, taskId);
+	graph->offsets.insert(graph->offsets.begin() + position, graph->offsets[position]);
+	graph->depOffsets.insert(graph->depOffsets.begin() + position, graph->depOffsets[position]);
+	graph->dependentOffsets.insert(graph->dependentOffsets.begin() + position, graph->dependentOffsets[position]);
+	if (graph->acyclic) {
+		// A vertex without arcs can go last in the order
+		graph->topoOrder.insert(graph->topoOrder.begin() + position, (int)graph->topoOrder.size());
+	}
+
+	if (!appended) {
+		for (size_t e = 0; e < graph->targets.size(); e++) {
+			if (graph->targets[e] >= position) {
+				graph->targets[e]++;
+			}
+		}
+		for (size_t e = 0; e < graph->depTargets.size(); e++) {
+			if (graph->depTargets[e] >= position) {
+				graph->depTargets[e]++;
+			}
+		}
+		for (size_t e = 0; e < graph->dependentTargets.size(); e++) {
+			if (graph->dependentTargets[e] >= position) {
+				graph->dependentTargets[e]++;
+			}
+		}
+		for (size_t v = position + 1; v < graph->ids.size(); v++) {
+			graph->indexOf[graph->ids[v]] = (int)v;
+		}
+	}
+	graph->indexOf[taskId] = position;
+	return position;
+}
+
+/**
+ * @brief Merges new arcs into one CSR adjacency in a single sequential pass.
+ *
+ * @param offsets First arc of each vertex, updated.
+ * @param targets Target vertex of each arc, updated.
+ * @param weights Weight of each arc, updated; nullptr if the adjacency has no weights.
+ * @param arcs The arcs to add, as (source vertex, target vertex, weight).
+ */
+static void mergeGraphArcs(vector<int>& offsets, vector<int>& targets, vector<int>* weights, const vector<Edge>& arcs) {
+	int n = (int)offsets.size() - 1;
+	vector<int> mergedOffsets(n + 1, 0);
+	for (size_t i = 0; i < arcs.size(); i++) {
+		mergedOffsets[arcs[i].src + 1]++;
+	}
+	for (int v = 0; v < n; v++) {
+		mergedOffsets[v + 1] += mergedOffsets[v] + offsets[v + 1] - offsets[v];
+	}
+
+	vector<int> mergedTargets(mergedOffsets[n]);
+	vector<int> mergedWeights(weights ? mergedOffsets[n] : 0);
+	vector<int> next(n);
+	for (int v = 0; v < n; v++) {
+		int count = offsets[v + 1] - offsets[v];
+		copy(targets.begin() + offsets[v], targets.begin() + offsets[v + 1], mergedTargets.begin() + mergedOffsets[v]);
+		if (weights) {
+			copy(weights->begin() + offsets[v], weights->begin() + offsets[v + 1], mergedWeights.begin() + mergedOffsets[v]);
+		}
+		next[v] = mergedOffsets[v] + count;
+	}
+	for (size_t i = 0; i < arcs.size(); i++) {
+		int slot = next[arcs[i].src]++;
+		mergedTargets[slot] = arcs[i].dest;
+		if (weights) {
+			mergedWeights[slot] = arcs[i].weight;
+		}
+	}
+
+	offsets.swap(mergedOffsets);
+	targets.swap(mergedTargets);
+	if (weights) {
+		weights->swap(mergedWeights);
+	}
+}
+
+/**
+ * @brief Collects the vertices reachable from a start vertex whose order position lies strictly between two bounds.
+ *
+ * @param offsets First arc of each vertex.
+ * @param targets Target vertex of each arc.
+ * @param order Order position of each vertex, or nullptr to search without bounds.
+ * @param start The start vertex, collected first whatever its position.
+ * @param lower Exclusive lower bound of the positions to enter.
+ * @param upper Exclusive upper bound of the positions to enter.
+ * @param stopAt Vertex whose discovery ends the search, or -1.
+ * @param found Receives the collected vertices.
+ * @param seen Vertices already collected, by this or an earlier search; updated.
+ * @return bool Returns false if stopAt was reached, otherwise true.
+ */
+static bool searchOrderRegion(const vector<int>& offsets, const vector<int>& targets, const vector<int>* order,
+	int start, int lower, int upper, int stopAt, vector<int>& found, unordered_set<int>& seen) {
+	vector<int> stack(1, start);
+	seen.insert(start);
+	found.push_back(start);
+
+	while (!stack.empty()) {
+		int x = stack.back();
+		stack.pop_back();
+		for (int e = offsets[x]; e < offsets[x + 1]; e++) {
+			int w = targets[e];
+			if (w == stopAt) {
+				return false;
+			}
+			if ((!order || ((*order)[w] > lower && (*order)[w] < upper)) && seen.insert(w).second) {
+				found.push_back(w);
+				stack.push_back(w);
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Updates the topological order of a task graph for a new dependency arc (Pearce-Kelly).
+ *
+ * If the task already comes before its dependency nothing changes. Otherwise the dependency's descendants and the
+ * task's ancestors are collected, both only among the vertices placed between the two, and the ancestors are
+ * moved in front of the descendants within the positions the two sets already hold. The cost depends on the size
+ * of that region, not on the size of the graph.
+ *
+ * @param graph The task graph, with acyclic set and a valid topoOrder.
+ * @param u Vertex of the task.
+ * @param v Vertex of the dependency.
+ * @return bool Returns true if the order was updated, false if the arc would close a cycle.
+ */
+static bool orderDependency(TaskGraph* graph, int u, int v) {
+	vector<int>& order = graph->topoOrder;
+	if (u == v) {
+		return false;
+	}
+	int lower = order[v];
+	int upper = order[u];
+	if (upper < lower) {
+		return true;
+	}
+
+	vector<int> descendants;
+	vector<int> ancestors;
+	unordered_set<int> seen;
+	if (!searchOrderRegion(graph->depOffsets, graph->depTargets, &order, v, lower, upper, u, descendants, seen)) {
+		return false;
+	}
+	searchOrderRegion(graph->dependentOffsets, graph->dependentTargets, &order, u, lower, upper, -1, ancestors, seen);
+
+	vector<int> positions;
+	for (size_t i = 0; i < ancestors.size(); i++) {
+		positions.push_back(order[ancestors[i]]);
+	}
+	for (size_t i = 0; i < descendants.size(); i++) {
+		positions.push_back(order[descendants[i]]);
+	}
+	sort(positions.begin(), positions.end());
+
+	// Each set keeps its internal order
+	vector<pair<int, int>> moved;
+	for (size_t i = 0; i < ancestors.size(); i++) {
+		moved.push_back(make_pair(order[ancestors[i]], ancestors[i]));
+	}
+	sort(moved.begin(), moved.end());
+	size_t firstDescendant = moved.size();
+	for (size_t i = 0; i < descendants.size(); i++) {
+		moved.push_back(make_pair(order[descendants[i]], descendants[i]));
+	}
+	sort(moved.begin() + firstDescendant, moved.end());
+
+	for (size_t i = 0; i < moved.size(); i++) {
+		order[moved[i].second] = positions[i];
+	}
+	return true;
+}
+
+/**
+ * @brief Adds a task and its dependencies to a task graph without rebuilding it.
+ *
+ * The result is the same graph buildTaskGraph would produce with the task appended to its input. The cost is one
+ * sequential pass over the edge arrays, instead of rereading the task file and rebuilding the id map.
+ *
+ * @param graph The task graph.
+ * @param task The task to add.
+ */
+void addTaskToGraph(TaskGraph* graph, const Task* task) {
+	if (graph->offsets.empty()) {
+		graph->offsets.assign(1, 0);
+		graph->depOffsets.assign(1, 0);
+		graph->dependentOffsets.assign(1, 0);
+	}
+
+	int numDependencies = min(max(task->numDependencies, 0), 10);
+	if (taskGraphIndex(*graph, task->id) < 0) {
+		insertGraphVertex(graph, task->id);
+	}
+	for (int i = 0; i < numDependencies; i++) {
+		if (taskGraphIndex(*graph, task->dependencies[i]) < 0) {
+			insertGraphVertex(graph, task->dependencies[i]);
+		}
+	}
+
+	int u = taskGraphIndex(*graph, task->id);
+	vector<Edge> edges;
+	vector<Edge> arcs;
+	vector<Edge> reversedArcs;
+	for (int i = 0; i < numDependencies; i++) {
+		int v = taskGraphIndex(*graph, task->dependencies[i]);
+		int weight = task->id + task->dependencies[i];
+		edges.push_back({ u, v, weight });
+		edges.push_back({ v, u, weight });
+		arcs.push_back({ u, v, weight });
+		reversedArcs.push_back({ v, u, weight });
+
+		// The searches never follow the task's own new arcs, so each arc can be ordered before any is merged
+		if (graph->acyclic && !orderDependency(graph, u, v)) {
+			graph->acyclic = false;
+			graph->topoOrder.clear();
+		}
+	}
+
+	if (!arcs.empty()) {
+		mergeGraphArcs(graph->offsets, graph->targets, &graph->weights, edges);
+		mergeGraphArcs(graph->depOffsets, graph->depTargets, nullptr, arcs);
+		mergeGraphArcs(graph->dependentOffsets, graph->dependentTargets, nullptr, reversedArcs);
+	}
+	graph->generation++;
+}
+
+/**
+ * @brief Checks whether a new dependency would close a cycle in a task graph.
+ *
+ * With a topological order at hand only the tasks placed between the two in that order are searched, and a
+ * dependency that already agrees with the order is accepted at once. If the graph has a cycle already, every
+ * task reachable from the dependency is searched.
+ *
+ * @param graph The task graph.
+ * @param taskId The task that would get the dependency.
+ * @param dependencyId The task it would depend on.
+ * @return bool Returns true if the dependency would create a cycle, otherwise false.
+ */
+bool dependencyCreatesCycle(const TaskGraph& graph, int taskId, int dependencyId) {
+	if (taskId == dependencyId) {
+		return true;
+	}
+	int u = taskGraphIndex(graph, taskId);
+	int v = taskGraphIndex(graph, dependencyId);
+	if (u < 0 || v < 0) {
+		return false;
+	}
+
+	vector<int> reached;
+	unordered_set<int> seen;
+	if (!graph.acyclic) {
+		return !searchOrderRegion(graph.depOffsets, graph.depTargets, nullptr, v, 0, 0, u, reached, seen);
+	}
+	if (graph.topoOrder[u] < graph.topoOrder[v]) {
+		return false;
+	}
+	return !searchOrderRegion(graph.depOffsets, graph.depTargets, &graph.topoOrder, v, graph.topoOrder[v], graph.topoOrder[u], u, reached, seen);
+}
+
+/**
+ * @brief Looks up the vertex index of a task.
+ *
+ * @param graph The task graph.
+ * @param taskId The task id.
+ * @return int The vertex index, or -1 if the task is not in the graph.
+ */
+int taskGraphIndex(const TaskGraph& graph, int taskId) {
+	unordered_map<int, int>::const_iterator it = graph.indexOf.find(taskId);
+	return it == graph.indexOf.end() ? -1 : it->second;
+}
+
+/**
+ * @brief Lists the vertices of a task graph so that every task comes after the tasks it depends on.
+ *
+ * @param graph The task graph.
+ * @param order Receives the vertex indexes, dependencies first.
+ * @return bool Returns true if the order was listed, false if the task graph has a cycle.
+ */
+bool topologicalOrder(const TaskGraph& graph, vector<int>* order) {
+	if (!graph.acyclic) {
+		order->clear();
+		return false;
+	}
+
+	// topoOrder places every task before its dependencies, so it is read from the back
+	int V = (int)graph.ids.size();
+	order->assign(V, 0);
+	for (int v = 0; v < V; v++) {
+		(*order)[V - 1 - graph.topoOrder[v]] = v;
+	}
+	return true;
+}
+
+/**
+ * @brief Computes the schedule of a task graph with the critical path method.
+ *
+ * The earliest starts are computed in topological order and the remaining work in the reverse order, each from
+ * the values of the neighbours already done, so the whole plan takes O(V + E).
+ *
+ * @param graph The task graph.
+ * @param durations Duration of each vertex.
+ * @param plan Receives the schedule.
+ * @return bool Returns true if the schedule was computed, false if the task graph has a cycle.
+ */
+bool planTaskGraph(const TaskGraph& graph, const vector<int>& durations, TaskPlan* plan) {
+	vector<int> order;
+	if (!topologicalOrder(graph, &order)) {
+		return false;
+	}
+
+	int V = (int)graph.ids.size();
+	plan->ids = graph.ids;
+	plan->durations = durations;
+	plan->earliestStart.assign(V, 0);
+	plan->remaining.assign(V, 0);
+	plan->makespan = 0;
+
+	for (int i = 0; i < V; i++) {
+		int u = order[i];
+		for (int e = graph.depOffsets[u]; e < graph.depOffsets[u + 1]; e++) {
+			int v = graph.depTargets[e];
+			plan->earliestStart[u] = max(plan->earliestStart[u], plan->earliestStart[v] + durations[v]);
+		}
+	}
+	for (int i = V - 1; i >= 0; i--) {
+		int v = order[i];
+		int after = 0;
+		for (int e = graph.dependentOffsets[v]; e < graph.dependentOffsets[v + 1]; e++) {
+			after = max(after, plan->remaining[graph.dependentTargets[e]]);
+		}
+		plan->remaining[v] = durations[v] + after;
+		plan->makespan = max(plan->makespan, plan->remaining[v]);
+	}
+
+	plan->generation = graph.generation;
+	return true;
+}
+
+/**
+ * @brief Updates a schedule after some of its values went stale.
+ *
+ * Stale earliest starts are recomputed from the back of the graph's topoOrder, where the dependencies are, and
+ * stale remaining work from the front, so each vertex is recomputed once after all the values it reads. Only
+ * the neighbours of a vertex whose value changed are recomputed in turn.
+ *
+ * @param graph The task graph, with a valid topoOrder.
+ * @param plan The schedule.
+ * @param staleStarts Vertices whose earliest start may be stale.
+ * @param staleRemaining Vertices whose remaining work may be stale.
+ */
+static void propagateTaskPlan(const TaskGraph& graph, TaskPlan* plan, const vector<int>& staleStarts, const vector<int>& staleRemaining) {
+	const vector<int>& position = graph.topoOrder;
+	priority_queue<pair<int, int>> starts;
+	unordered_set<int> queued;
+	for (size_t i = 0; i < staleStarts.size(); i++) {
+		if (queued.insert(staleStarts[i]).second) {
+			starts.push(make_pair(position[staleStarts[i]], staleStarts[i]));
+		}
+	}
+	while (!starts.empty()) {
+		int u = starts.top().second;
+		starts.pop();
+		int start = 0;
+		for (int e = graph.depOffsets[u]; e < graph.depOffsets[u + 1]; e++) {
+			int v = graph.depTargets[e];
+			start = max(start, plan->earliestStart[v] + plan->durations[v]);
+		}
+		if (start == plan->earliestStart[u]) {
+			continue;
+		}
+		plan->earliestStart[u] = start;
+		for (int e = graph.dependentOffsets[u]; e < graph.dependentOffsets[u + 1]; e++) {
+			int w = graph.dependentTargets[e];
+			if (queued.insert(w).second) {
+				starts.push(make_pair(position[w], w));
+			}
+		}
+	}
+
+	priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> remaining;
+	queued.clear();
+	for (size_t i = 0; i < staleRemaining.size(); i++) {
+		if (queued.insert(staleRemaining[i]).second) {
+			remaining.push(make_pair(position[staleRemaining[i]], staleRemaining[i]));
+		}
+	}
+	bool shortened = false;
+	while (!remaining.empty()) {
+		int v = remaining.top().second;
+		remaining.pop();
+		int after = 0;
+		for (int e = graph.dependentOffsets[v]; e < graph.dependentOffsets[v + 1]; e++) {
+			after = max(after, plan->remaining[graph.dependentTargets[e]]);
+		}
+		int work = plan->durations[v] + after;
+		if (work == plan->remaining[v]) {
+			continue;
+		}
+		shortened = shortened || plan->remaining[v] == plan->makespan;
+		plan->remaining[v] = work;
+		plan->makespan = max(plan->makespan, work);
+		for (int e = graph.depOffsets[v]; e < graph.depOffsets[v + 1]; e++) {
+			int w = graph.depTargets[e];
+			if (queued.insert(w).second) {
+				remaining.push(make_pair(position[w], w));
+			}
+		}
+	}
+
+	// Only a chain that was the longest getting shorter can bring the makespan down
+	if (shortened) {
+		plan->makespan = 0;
+		for (size_t v = 0; v < plan->remaining.size(); v++) {
+			plan->makespan = max(plan->makespan, plan->remaining[v]);
+		}
+	}
+}
+
+/**
+ * @brief Changes the duration of a task in a schedule.
+ *
+ * @param graph The task graph the schedule was computed for.
+ * @param plan The schedule.
+ * @param taskId The task id.
+ * @param duration The new duration.
+ * @return bool Returns true if the schedule was updated, false if the task is not in it or it does not match the graph.
+ */
+bool setPlannedDuration(const TaskGraph& graph, TaskPlan* plan, int taskId, int duration) {
+	int x = taskGraphIndex(graph, taskId);
+	if (x < 0 || plan->generation != graph.generation || !graph.acyclic) {
+		return false;
+	}
+
+	plan->durations[x] = duration;
+	vector<int> staleStarts(graph.dependentTargets.begin() + graph.dependentOffsets[x],
+		graph.dependentTargets.begin() + graph.dependentOffsets[x + 1]);
+	propagateTaskPlan(graph, plan, staleStarts, vector<int>(1, x));
+	return true;
+}
+
+/**
+ * @brief Updates a schedule for a task just added with addTaskToGraph.
+ *
+ * New vertices are inserted with the given duration, then only the tasks whose times the new dependencies change
+ * are recomputed.
+ *
+ * @param graph The task graph, after addTaskToGraph.
+ * @param plan The schedule, computed for the graph as it was before addTaskToGraph.
+ * @param task The task that was added.
+ * @param duration Duration of the task and of the vertices its dependencies added.
+ * @return bool Returns true if the schedule was updated, false if the task graph has a cycle.
+ */
+bool addTaskToPlan(const TaskGraph& graph, TaskPlan* plan, const Task* task, int duration) {
+	if (!graph.acyclic) {
+		return false;
+	}
+
+	size_t V = graph.ids.size();
+	if (plan->ids.size() != V) {
+		vector<int> durations(V, duration);
+		vector<int> earliestStart(V, 0);
+		vector<int> remaining(V, duration);
+		for (size_t v = 0, old = 0; v < V && old < plan->ids.size(); v++) {
+			if (graph.ids[v] == plan->ids[old]) {
+				durations[v] = plan->durations[old];
+				earliestStart[v] = plan->earliestStart[old];
+				remaining[v] = plan->remaining[old];
+				old++;
+			}
+		}
+		plan->ids = graph.ids;
+		plan->durations.swap(durations);
+		plan->earliestStart.swap(earliestStart);
+		plan->remaining.swap(remaining);
+		plan->makespan = max(plan->makespan, duration);
+	}
+
+	int numDependencies = min(max(task->numDependencies, 0), 10);
+	vector<int> staleRemaining;
+	for (int i = 0; i < numDependencies; i++) {
+		staleRemaining.push_back(taskGraphIndex(graph, task->dependencies[i]));
+	}
+	propagateTaskPlan(graph, plan, vector<int>(1, taskGraphIndex(graph, task->id)), staleRemaining);
+	plan->generation = graph.generation;
+	return true;
+}
+
+/**
+ * @brief Finds a critical path of a schedule.
+ *
+ * The path starts at a task that starts at time 0 and lies on a longest chain, and follows dependent tasks that
+ * start right when it finishes and lie on the same chain.
+ *
+ * @param graph The task graph the schedule was computed for.
+ * @param plan The schedule.
+ * @return vector<int> The task ids on the path, in the order they run; empty if the graph has no tasks.
+ */
+vector<int> criticalPath(const TaskGraph& graph, const TaskPlan& plan) {
+	vector<int> path;
+	int V = (int)plan.ids.size();
+	int v = 0;
+	while (v < V && (plan.earliestStart[v] != 0 || plan.remaining[v] != plan.makespan)) {
+		v++;
+	}
+
+	while (v < V) {
+		path.push_back(plan.ids[v]);
+		int finish = plan.earliestStart[v] + plan.durations[v];
+		int next = V;
+		for (int e = graph.dependentOffsets[v]; e < graph.dependentOffsets[v + 1] && next == V; e++) {
+			int u = graph.dependentTargets[e];
+			if (plan.earliestStart[u] == finish && plan.remaining[u] == plan.remaining[v] - plan.durations[v]) {
+				next = u;
+			}
+		}
+		v = next;
+	}
+	return path;
+}
+
+/**
+ * @brief Prints a schedule.
+ *
+ * The tasks are printed in topological order with their duration, earliest and latest start and slack, followed
+ * by the critical path and the total duration.
+ *
+ * @param graph The task graph the schedule was computed for.
+ * @param plan The schedule.
+ * @param out Output stream for displaying the schedule.
+ */
+void printTaskPlan(const TaskGraph& graph, const TaskPlan& plan, ostream& out) {
+	vector<int> order;
+	topologicalOrder(graph, &order);
+
+	for (size_t i = 0; i < order.size(); i++) {
+		int v = order[i];
+		int latestStart = plan.makespan - plan.remaining[v];
+		out << "Task " << plan.ids[v] << ": duration " << plan.durations[v] << ", earliest start " << plan.earliestStart[v]
+			<< ", latest start " << latestStart << ", slack " << latestStart - plan.earliestStart[v] << endl;
+	}
+
+	vector<int> path = criticalPath(graph, plan);
+	out << "Critical path:";
+	for (size_t i = 0; i < path.size(); i++) {
+		out << (i == 0 ? " " : " -> ") << path[i];
+	}
+	out << "\nTotal duration: " << plan.makespan << endl;
+}
+
+/**
+ * @brief Performs Breadth-First Search (BFS) on the task graph.
+ *
+ * This function performs BFS starting from the specified task and returns the number of connected tasks.
+ * The queue is a plain array of vertex indexes, each vertex is queued at most once.
+ *
+ * @param startVertex The id of the starting task.
+ * @return int The number of tasks connected to the starting task, including itself; 1 if the task has no dependencies in the graph.
+ */
+int BFS(int startVertex) {
+	int start = taskGraphIndex(taskGraph, startVertex);
+	if (start < 0) {
+		return 1;
+	}
+
+	vector<bool> visited(taskGraph.ids.size(), false);
+	vector<int> queue;
+	queue.reserve(taskGraph.ids.size());
+
+	visited[start] = true;
+	queue.push_back(start);
+
+	for (size_t head = 0; head < queue.size(); head++) {
+		int current = queue[head];
+		for (int e = taskGraph.offsets[current]; e < taskGraph.offsets[current + 1]; e++) {
+			int next = taskGraph.targets[e];
+			if (!visited[next]) {
+				visited[next] = true;
+				queue.push_back(next);
+			}
+		}
+	}
+
+	return (int)queue.size();
+}
+
+/**
+ * @brief Utility function for Depth-First Search (DFS).
+ *
+ * This function performs DFS starting from the specified vertex and returns the number of connected tasks.
+ * It keeps its own stack of vertices instead of recursing, so long dependency chains cannot overflow the call stack.
+ *
+ * @param vertex The vertex index to start from.
+ * @param visited Array to track visited vertices, one entry per vertex of the task graph.
+ * @return int The number of tasks connected to the vertex, including itself.
+ */
+int DFSUtil(int vertex, bool visited[]) {
+	vector<int> stack;
+	int connectedCount = 0;
+
+	visited[vertex] = true;
+	stack.push_back(vertex);
+
+	while (!stack.empty()) {
+		int current = stack.back();
+		stack.pop_back();
+		connectedCount++;
+
+		for (int e = taskGraph.offsets[current + 1] - 1; e >= taskGraph.offsets[current]; e--) {
+			int next = taskGraph.targets[e];
+			if (!visited[next]) {
+				visited[next] = true;
+				stack.push_back(next);
+			}
+		}
+	}
+
+	return connectedCount;
+}
+
+/**
+ * @brief Performs Depth-First Search (DFS) on the task graph.
+ *
+ * This function performs DFS starting from the specified task and returns the number of connected tasks.
+ *
+ * @param startVertex The id of the starting task.
+ * @return int The number of tasks connected to the starting task, including itself; 1 if the task has no dependencies in the graph.
+ */
+int DFS(int startVertex) {
+	int start = taskGraphIndex(taskGraph, startVertex);
+	if (start < 0) {
+		return 1;
+	}
+
+	bool* visited = new bool[taskGraph.ids.size()]();
+	int connectedCount = DFSUtil(start, visited);
+	delete[] visited;
+	return connectedCount;
+}
+
+/**
+ * @brief Whether the current thread is running a share of a WorkerPool job.
+ */
+static thread_local bool insideWorkerPool = false;
+
+/**
+ * @brief Fixed set of worker threads shared by the parallel graph algorithms.
+ *
+ * Threads are started on first use and then parked on a condition variable between jobs, so an algorithm that
+ * dispatches many short phases does not pay for creating threads each time. One job runs at a time; a job started
+ * from inside another one runs all its workers on the thread that started it.
+ */
+class WorkerPool {
+public:
+	/**
+	 * @brief Stops and joins the worker threads.
+	 */
+	~WorkerPool() {
+		{
+			lock_guard<mutex> guard(stateLock);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (size_t t = 0; t < threads.size(); t++) {
+			threads[t].join();
 		}
 	}
 
-	if (taskCount <= 0 || uncategorizedTaskCount == 0) {
-		out << "No tasks available to categorize." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return 0;
+	/**
+	 * @brief Runs a worker on several threads and waits for all of them.
+	 *
+	 * If a worker throws, the first exception is rethrown once every worker has returned.
+	 *
+	 * @param threadCount Number of workers; worker 0 runs on the calling thread.
+	 * @param worker Called once with each worker index 0..threadCount-1.
+	 */
+	void run(int threadCount, const function<void(int)>& worker) {
+		if (insideWorkerPool) {
+			// The pool is busy with the job that got us here, so waiting for it would never return
+			for (int t = 0; t < threadCount; t++) {
+				worker(t);
+			}
+			return;
+		}
+
+		lock_guard<mutex> serialize(runLock);
+		{
+			unique_lock<mutex> guard(stateLock);
+			while ((int)threads.size() < threadCount - 1) {
+				threads.push_back(thread(&WorkerPool::loop, this, (int)threads.size() + 1, round));
+			}
+			job = &worker;
+			jobThreads = threadCount;
+			pending = threadCount - 1;
+			failure = nullptr;
+			round++;
+		}
+		wake.notify_all();
+
+		exception_ptr callerFailure;
+		insideWorkerPool = true;
+		try {
+			worker(0);
+		}
+		catch (...) {
+			callerFailure = current_exception();
+		}
+		insideWorkerPool = false;
+
+		unique_lock<mutex> guard(stateLock);
+		while (pending > 0) {
+			done.wait(guard);
+		}
+		job = nullptr;
+		exception_ptr thrown = callerFailure ? callerFailure : failure;
+		failure = nullptr;
+		guard.unlock();
+		if (thrown) {
+			rethrow_exception(thrown);
+		}
 	}
 
-	out << "\nEnter the ID of the task you want to categorize: ";
-	int selectedTaskId = getInput(in);
+private:
+	/**
+	 * @brief Body of a worker thread: waits for each new job and runs its share if it takes part.
+	 *
+	 * @param index Worker index of this thread.
+	 * @param seenRound Last job round this thread has seen.
+	 */
+	void loop(int index, unsigned long long seenRound) {
+		insideWorkerPool = true;
+		unique_lock<mutex> guard(stateLock);
+		for (;;) {
+			while (!stopping && round == seenRound) {
+				wake.wait(guard);
+			}
+			if (stopping) {
+				return;
+			}
+			seenRound = round;
+			if (index >= jobThreads) {
+				continue;
+			}
 
-	Task* selectedTask = nullptr;
-	for (int i = 0; i < taskCount; ++i) {
-		if (tasks[i].id == selectedTaskId && !tasks[i].isCategorized) {
-			selectedTask = &tasks[i];
-			break;
+			const function<void(int)>* current = job;
+			guard.unlock();
+			exception_ptr thrown;
+			try {
+				(*current)(index);
+			}
+			catch (...) {
+				thrown = current_exception();
+			}
+			guard.lock();
+			if (thrown && !failure) {
+				failure = thrown;
+			}
+			if (--pending == 0) {
+				done.notify_one();
+			}
 		}
 	}
 
-	if (!selectedTask) {
-		out << "Invalid task ID. Please try again." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return 0;
+	mutex runLock;                       /**< Serializes jobs */
+	mutex stateLock;                     /**< Guards the fields below */
+	condition_variable wake;             /**< Signals a new job or shutdown to the workers */
+	condition_variable done;             /**< Signals the caller that the last worker finished */
+	vector<thread> threads;              /**< Worker threads, index t runs worker t + 1 */
+	const function<void(int)>* job = nullptr;
+	int jobThreads = 0;
+	int pending = 0;
+	exception_ptr failure;               /**< First exception thrown by a worker thread in the current job */
+	unsigned long long round = 0;
+	bool stopping = false;
+};
+
+/**
+ * @brief Returns the worker pool shared by the parallel graph algorithms.
+ *
+ * @return WorkerPool& The pool, created on first use.
+ */
+static WorkerPool& workerPool() {
+	static WorkerPool pool;
+	return pool;
+}
+
+/**
+ * @brief Runs a worker on several threads and waits for all of them.
+ *
+ * Worker 0 runs on the calling thread, so a single worker involves no other thread at all.
+ *
+ * @param threadCount Number of workers.
+ * @param worker Called once with each worker index 0..threadCount-1.
+ */
+template <typename Worker>
+static void runOnThreads(int threadCount, Worker worker) {
+	if (threadCount <= 1) {
+		worker(0);
+		return;
 	}
+	workerPool().run(threadCount, function<void(int)>(worker));
+}
 
-	out << "Select a category for the task:" << endl;
-	out << "1. Work" << endl;
-	out << "2. Sport" << endl;
-	out << "3. Diet" << endl;
-	out << "4. Study" << endl;
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero word.
+ *
+ * @param word The word.
+ * @return int The bit index, 0..63.
+ */
+static inline int lowestSetBit(uint64_t word) {
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return (int)index;
+#else
+	return __builtin_ctzll(word);
+#endif
+}
 
-	int categoryChoice = getInput(in);
+/**
+ * @brief Performs a parallel direction-optimizing Breadth-First Search (BFS) on a task graph.
+ *
+ * Each level is expanded either top-down, where the frontier claims its unvisited neighbours, or bottom-up,
+ * where every unvisited vertex looks for a neighbour in the frontier and stops at the first one. Bottom-up is
+ * chosen while the frontier's edges outnumber a fraction of the unexplored edges, which saves most of the edge
+ * checks on the large middle levels. Frontiers and the visited set are bitmaps split into equal word ranges
+ * across the threads; top-down claims vertices with an atomic OR, bottom-up writes only its own words.
+ *
+ * @param graph The task graph.
+ * @param startVertex The id of the starting task.
+ * @param threadCount Number of threads, or 0 to use one per hardware thread.
+ * @param depths Receives the BFS level of each vertex index, -1 if unreached; may be nullptr.
+ * @return int The number of tasks connected to the starting task, including itself; 1 if the task has no dependencies in the graph.
+ */
+int directionOptimizingBFS(const TaskGraph& graph, int startVertex, int threadCount, vector<int>* depths) {
+	const long long TOP_DOWN_FACTOR = 14;   // go bottom-up once frontier edges exceed unexplored edges / 14
+	const int BOTTOM_UP_FACTOR = 24;        // go back top-down once the frontier holds fewer than n / 24 vertices
 
-	switch (categoryChoice) {
-	case 1:
-		strcpy(selectedTask->category, "Work");
-		break;
-	case 2:
-		strcpy(selectedTask->category, "Sport");
-		break;
-	case 3:
-		strcpy(selectedTask->category, "Diet");
-		break;
-	case 4:
-		strcpy(selectedTask->category, "Study");
-		break;
-	default:
-		out << "Invalid category choice. Please try again." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return 0;
+	int n = (int)graph.ids.size();
+	if (depths) {
+		depths->assign(n, -1);
+	}
+	int start = taskGraphIndex(graph, startVertex);
+	if (start < 0) {
+		return 1;
 	}
 
-	selectedTask->isCategorized = true;
+	size_t wordCount = ((size_t)n + 63) / 64;
+	threadCount = min(resolveThreadCount(threadCount), (int)wordCount);
+	size_t wordsPerThread = (wordCount + threadCount - 1) / threadCount;
+	uint64_t lastWordMask = n % 64 == 0 ? ~(uint64_t)0 : (((uint64_t)1 << (n % 64)) - 1);
+
+	vector<atomic<uint64_t>> visited(wordCount);
+	vector<atomic<uint64_t>> frontier(wordCount);
+	vector<atomic<uint64_t>> next(wordCount);
+	for (size_t w = 0; w < wordCount; w++) {
+		visited[w].store(0, memory_order_relaxed);
+		frontier[w].store(0, memory_order_relaxed);
+	}
 
-	FILE* file = fopen(pathFileTasks, "wb");
+	const vector<int>& offsets = graph.offsets;
+	const vector<int>& targets = graph.targets;
+	uint64_t startBit = (uint64_t)1 << (start % 64);
+	visited[start / 64].store(startBit, memory_order_relaxed);
+	frontier[start / 64].store(startBit, memory_order_relaxed);
+	if (depths) {
+		(*depths)[start] = 0;
+	}
 
-	for (int i = 0; i < taskCount; ++i) {
-		fwrite(&tasks[i], sizeof(Task), 1, file);
+	long long frontierEdges = offsets[start + 1] - offsets[start];
+	long long unexploredEdges = (long long)targets.size() - frontierEdges;
+	int frontierSize = 1;
+	int reached = 1;
+	bool bottomUp = false;
+	vector<long long> levelEdges(threadCount);
+	vector<int> levelVertices(threadCount);
+
+	for (int level = 1; frontierSize > 0; level++) {
+		if (!bottomUp && frontierEdges > unexploredEdges / TOP_DOWN_FACTOR) {
+			bottomUp = true;
+		}
+		else if (bottomUp && frontierSize < n / BOTTOM_UP_FACTOR) {
+			bottomUp = false;
+		}
+		for (size_t w = 0; w < wordCount; w++) {
+			next[w].store(0, memory_order_relaxed);
+		}
+
+		runOnThreads(threadCount, [&](int t) {
+			size_t first = t * wordsPerThread;
+			size_t last = min(wordCount, first + wordsPerThread);
+			long long edges = 0;
+			int vertices = 0;
+
+			for (size_t w = first; w < last; w++) {
+				if (bottomUp) {
+					uint64_t seen = visited[w].load(memory_order_relaxed);
+					uint64_t pending = ~seen & (w + 1 == wordCount ? lastWordMask : ~(uint64_t)0);
+					uint64_t found = 0;
+					while (pending) {
+						int v = (int)(w * 64) + lowestSetBit(pending);
+						pending &= pending - 1;
+						for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+							int u = targets[e];
+							if (frontier[u / 64].load(memory_order_relaxed) & ((uint64_t)1 << (u % 64))) {
+								found |= (uint64_t)1 << (v % 64);
+								edges += offsets[v + 1] - offsets[v];
+								vertices++;
+								if (depths) {
+									(*depths)[v] = level;
+								}
+								break;
+							}
+						}
+					}
+					if (found) {
+						visited[w].store(seen | found, memory_order_relaxed);
+						next[w].store(found, memory_order_relaxed);
+					}
+				}
+				else {
+					uint64_t current = frontier[w].load(memory_order_relaxed);
+					while (current) {
+						int v = (int)(w * 64) + lowestSetBit(current);
+						current &= current - 1;
+						for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+							int u = targets[e];
+							uint64_t bit = (uint64_t)1 << (u % 64);
+							if ((visited[u / 64].load(memory_order_relaxed) & bit) == 0 &&
+								(visited[u / 64].fetch_or(bit, memory_order_relaxed) & bit) == 0) {
+								next[u / 64].fetch_or(bit, memory_order_relaxed);
+								edges += offsets[u + 1] - offsets[u];
+								vertices++;
+								if (depths) {
+									(*depths)[u] = level;
+								}
+							}
+						}
+					}
+				}
+			}
+
+			levelEdges[t] = edges;
+			levelVertices[t] = vertices;
+		});
+
+		frontierEdges = 0;
+		frontierSize = 0;
+		for (int t = 0; t < threadCount; t++) {
+			frontierEdges += levelEdges[t];
+			frontierSize += levelVertices[t];
+		}
+		unexploredEdges -= frontierEdges;
+		reached += frontierSize;
+		frontier.swap(next);
 	}
 
-	fclose(file);
-	out << "Task categorized successfully." << endl;
-	enterToContinue(in, out);
-	free(tasks);
-	return 1;
+	return reached;
 }
 
 /**
- * @brief Displays and handles the assign deadline menu.
- *
- * This function displays the assign deadline menu and processes user input to assign deadlines to tasks.
+ * @brief Deque of ready vertices owned by one executor worker.
  *
- * @param pathFileTasks Path to the binary file containing tasks.
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the menu and messages.
- * @return int Returns 1 if the deadline is assigned successfully, otherwise 0.
+ * The owner pushes and pops at the back, so it keeps working on the tasks it just made ready while their data is
+ * still in cache; other workers steal from the front, taking the oldest ready tasks.
  */
-int assignDeadline(const char* pathFileTasks, istream& in, ostream& out) {
-	clearScreen();
-	Task* tasks = nullptr;
-	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
-	int unDeadlinedTaskCount = 0;
+struct WorkDeque {
+	mutex lock;          /**< Guards tasks */
+	deque<int> tasks;    /**< Ready vertices */
+};
 
-	for (int i = 0; i < taskCount; ++i) {
-		if (!tasks[i].isDeadlined) {
-			out << "ID: " << tasks[i].id << ", Name: " << tasks[i].name
-				<< ", Description: " << tasks[i].description << endl;
-			unDeadlinedTaskCount++;
-		}
+/**
+ * @brief Runs a callback for every task of a task graph on several threads, each task after its dependencies.
+ *
+ * Every vertex has an atomic count of the dependencies that have not finished yet. The worker that brings a count
+ * to zero pushes the vertex on its own deque, so a task starts as soon as its last dependency finishes, and an
+ * idle worker steals from the others. Vertices that only appear as a dependency are run as well.
+ *
+ * @param graph The task graph.
+ * @param threadCount Number of threads, or 0 to use one per hardware thread.
+ * @param run Called once with the id of each task; may be called from several threads at once. It may start other
+ *            parallel algorithms, which then run on its own thread. If it throws, no new tasks are started and the
+ *            exception is rethrown once the running ones have finished.
+ * @return int The number of tasks run, or -1 if the task graph has a cycle.
+ */
+int executeTaskGraph(const TaskGraph& graph, int threadCount, const function<void(int)>& run) {
+	if (!graph.acyclic) {
+		return -1;
 	}
+	int V = (int)graph.ids.size();
+	threadCount = max(1, min(resolveThreadCount(threadCount), V));
 
-	if (taskCount <= 0 || unDeadlinedTaskCount == 0) {
-		out << "No Tasks Available To Add Deadline." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return 0;
+	vector<atomic<int>> waiting(V);
+	vector<WorkDeque> deques(threadCount);
+	int seeded = 0;
+	for (int v = 0; v < V; v++) {
+		int count = graph.depOffsets[v + 1] - graph.depOffsets[v];
+		waiting[v].store(count, memory_order_relaxed);
+		if (count == 0) {
+			deques[seeded++ % threadCount].tasks.push_back(v);
+		}
 	}
+	atomic<int> unfinished(V);
+	atomic<bool> abandoned(false);
+
+	runOnThreads(threadCount, [&](int index) {
+		WorkDeque& own = deques[index];
+		while (unfinished.load(memory_order_acquire) > 0 && !abandoned.load(memory_order_relaxed)) {
+			int v = -1;
+			{
+				lock_guard<mutex> guard(own.lock);
+				if (!own.tasks.empty()) {
+					v = own.tasks.back();
+					own.tasks.pop_back();
+				}
+			}
+			for (int k = 1; v < 0 && k < threadCount; k++) {
+				WorkDeque& victim = deques[(index + k) % threadCount];
+				lock_guard<mutex> guard(victim.lock);
+				if (!victim.tasks.empty()) {
+					v = victim.tasks.front();
+					victim.tasks.pop_front();
+				}
+			}
+			if (v < 0) {
+				this_thread::yield();
+				continue;
+			}
 
-	out << "\nEnter The ID Of The Task You Want To Add Deadline: ";
-	int selectedTaskId = getInput(in);
-
-	Task* selectedTask = nullptr;
-	for (int i = 0; i < taskCount; ++i) {
-		if (tasks[i].id == selectedTaskId && !tasks[i].isDeadlined) {
-			selectedTask = &tasks[i];
-			break;
+			try {
+				run(graph.ids[v]);
+			}
+			catch (...) {
+				abandoned.store(true, memory_order_relaxed);
+				throw;
+			}
+			for (int e = graph.dependentOffsets[v]; e < graph.dependentOffsets[v + 1]; e++) {
+				int u = graph.dependentTargets[e];
+				if (waiting[u].fetch_sub(1, memory_order_acq_rel) == 1) {
+					lock_guard<mutex> guard(own.lock);
+					own.tasks.push_back(u);
+				}
+			}
+			unfinished.fetch_sub(1, memory_order_acq_rel);
 		}
-	}
+	});
+	return V;
+}
 
-	if (!selectedTask) {
-		out << "Invalid Task ID. Please Try again." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return 0;
+/**
+ * @brief Heapifies a subtree with the root at the given index.
+ *
+ * This function heapifies a subtree in a max heap with the root at the specified index.
+ *
+ * @param users Array of User objects.
+ * @param n The size of the heap.
+ * @param i The root index of the subtree.
+ */
+void heapify(User users[], int n, int i) {
+	int largest = i;
+	int left = 2 * i + 1;
+	int right = 2 * i + 2;
+
+	if (left < n && users[left].id > users[largest].id)
+		largest = left;
+
+	if (right < n && users[right].id > users[largest].id)
+		largest = right;
+
+	if (largest != i) {
+		User swap = users[i];
+		users[i] = users[largest];
+		users[largest] = swap;
+
+		heapify(users, n, largest);
 	}
+}
 
-	out << "Enter Deadline Day (1-31): ";
-	int day = getInput(in);
-	out << "Enter Deadline Month (1-12): ";
-	int month = getInput(in);
-	out << "Enter Deadline Year: ";
-	int year = getInput(in);
+/**
+ * @brief Builds a max heap from the given array of users.
+ *
+ * This function builds a max heap from the specified array of User objects.
+ *
+ * @param users Array of User objects.
+ * @param n The size of the array.
+ */
+void buildMaxHeap(User users[], int n) {
+	for (int i = n / 2 - 1; i >= 0; i--)
+		heapify(users, n, i);
+}
 
-	if (day < 1 || day > 31 || month < 1 || month > 12 || year < 0) {
-		out << "Invalid date. Please enter valid day, month, and year." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return 0;
+/**
+ * @brief Finds the length of the longest common subsequence between two strings.
+ *
+ * This function calculates the length of the longest common subsequence between two given strings.
+ *
+ * @param text1 The first string.
+ * @param text2 The second string.
+ * @return int The length of the longest common subsequence.
+ */
+int longestCommonSubsequence(const char* text1, const char* text2) {
+	int m = strlen(text1);
+	int n = strlen(text2);
+	int dp[101][101] = { 0 };
+
+	for (int i = 1; i <= m; i++) {
+		for (int j = 1; j <= n; j++) {
+			if (text1[i - 1] == text2[j - 1]) {
+				dp[i][j] = dp[i - 1][j - 1] + 1;
+			}
+			else {
+				dp[i][j] = max(dp[i - 1][j], dp[i][j - 1]);
+			}
+		}
 	}
 
-	stringstream deadlineStream;
-	deadlineStream << day << "/" << month << "/" << year;
-	string deadlineStr = deadlineStream.str();
+	return dp[m][n];
+}
 
-	strncpy(selectedTask->deadLine, deadlineStr.c_str(), sizeof(selectedTask->deadLine) - 1);
-	selectedTask->deadLine[sizeof(selectedTask->deadLine) - 1] = '\0';
+/**
+ * @brief Builds a Huffman tree from the given data.
+ *
+ * This function constructs a Huffman tree based on the frequency of characters in the given data and stores the Huffman codes.
+ *
+ * @param pathFileTasks Path to the binary file containing tasks (unused in this function).
+ * @param data The input data to build the Huffman tree from.
+ * @param size The size of the input data.
+ */
+void buildHuffmanTree(const char* pathFileTasks, const char* data, int size) {
+	unordered_map<char, int> freq;
+	for (int i = 0; i < size; ++i)
+		freq[data[i]]++;
+
+	priority_queue<HuffmanNode*, vector<HuffmanNode*>, compare> minHeap;
 
-	selectedTask->isDeadlined = true;
+	for (auto pair : freq)
+		minHeap.push(new HuffmanNode(pair.first, pair.second));
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	for (int i = 0; i < taskCount; ++i) {
-		fwrite(&tasks[i], sizeof(Task), 1, file);
+	while (minHeap.size() != 1) {
+		HuffmanNode* left = minHeap.top();
+		minHeap.pop();
+		HuffmanNode* right = minHeap.top();
+		minHeap.pop();
+
+		HuffmanNode* top = new HuffmanNode('$', left->freq + right->freq);
+		top->left = left;
+		top->right = right;
+		minHeap.push(top);
 	}
-	fclose(file);
 
-	out << "Deadline Added Successfully." << endl;
-	enterToContinue(in, out);
-	free(tasks);
-	return 1;
+	storeCodes(minHeap.top(), "");
 }
 
 /**
- * @brief Sets a reminder.
+ * @brief Stores Huffman codes for the given Huffman tree.
  *
- * This function sets a reminder for a specified duration.
+ * This function traverses the Huffman tree and stores the Huffman codes for each character.
  *
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying messages.
- * @return int Always returns 0.
+ * @param root The root of the Huffman tree.
+ * @param str The current Huffman code as a string.
  */
-int setReminders(istream& in, ostream& out) {
-	int seconds, minutes, hours, days;
-
-	out << "Enter the reminder duration:" << endl;
-	out << "Seconds: ";
-	seconds = getInput(in);
-	out << "Minutes: ";
-	minutes = getInput(in);
-	out << "Hours: ";
-	hours = getInput(in);
-	out << "Days: ";
-	days = getInput(in);
-
-	int totalSeconds = seconds + minutes * 60 + hours * 3600 + days * 86400;
+void storeCodes(HuffmanNode* root, string str) {
+	if (root == nullptr)
+		return;
+	if (root->data != '$')
+		codes[root->data] = str;
+	storeCodes(root->left, str + "0");
+	storeCodes(root->right, str + "1");
+}
 
-	if (totalSeconds <= 0) {
-		out << "Invalid duration. Please enter a positive duration." << endl;
-		enterToContinue(in, out);
-		return 0;
+/**
+ * @brief Prints the stored Huffman codes.
+ *
+ * This function prints the Huffman codes for each character to the output stream.
+ *
+ * @param out Output stream for displaying the Huffman codes.
+ */
+void printCodes(ostream& out) {
+	for (auto pair : codes) {
+		out << pair.first << ": " << pair.second << "\n";
 	}
-
-	out << "Setting reminder for " << totalSeconds << " seconds..." << endl;
-	this_thread::sleep_for(chrono::seconds(totalSeconds));
-	out << "Time's up! Reminder triggered after " << totalSeconds << " seconds." << endl;
-
-	enterToContinue(in, out);
-	return 0;
 }
 
 /**
- * @brief Manages notification settings.
+ * @brief Encodes the given data using the stored Huffman codes.
  *
- * This function displays and processes user input for managing notification settings.
+ * This function encodes the input data based on the previously stored Huffman codes.
  *
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying messages.
- * @return int Always returns 0.
+ * @param data The input data to encode.
+ * @param size The size of the input data.
+ * @return string The encoded string.
  */
-int notificationSettings(istream& in, ostream& out) {
-	int choice;
-
-	out << "Select notification method:" << endl;
-	out << "1. SMS" << endl;
-	out << "2. E-Mail" << endl;
-	out << "3. Notification" << endl;
-	out << "Enter your choice: ";
-	choice = getInput(in);
-
-	switch (choice) {
-	case 1:
-		out << "Your reminder has been set to SMS." << endl;
-		enterToContinue(in, out);
-		break;
-	case 2:
-		out << "Your reminder has been set to E-Mail." << endl;
-		enterToContinue(in, out);
-		break;
-	case 3:
-		out << "Your reminder has been set to Notification." << endl;
-		enterToContinue(in, out);
-		break;
-	default:
-		out << "Invalid choice. Please try again." << endl;
-		enterToContinue(in, out);
-		break;
+string encode(const char* data, int size) {
+	string encodedString = "";
+	for (int i = 0; i < size; ++i) {
+		encodedString += codes[data[i]];
 	}
-
-	return 0;
+	return encodedString;
 }
 
 /**
- * @brief Marks the importance of a task.
+ * @brief Displays and handles the Huffman encoding task menu.
  *
- * This function displays tasks and allows the user to mark the importance of a selected task.
+ * This function displays the Huffman encoding task menu, processes user input, and encodes the selected task description using Huffman coding.
  *
  * @param pathFileTasks Path to the binary file containing tasks.
  * @param in Input stream for reading user input.
  * @param out Output stream for displaying the menu and messages.
- * @return int Returns 1 if the importance is marked successfully, otherwise 0.
  */
-int markTaskImportance(const char* pathFileTasks, istream& in, ostream& out) {
+void huffmanEncodingTaskMenu(const char* pathFileTasks, istream& in, ostream& out) {
 	clearScreen();
 	Task* tasks = nullptr;
 	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
-	bool taskAlreadyMarked = false;
-	int unMarkedTaskCount = 0;
-
-	for (int i = 0; i < taskCount; ++i) {
-		if (tasks[i].impid == 0 && !taskAlreadyMarked) {
-			out << "ID: " << tasks[i].id << ", Name: " << tasks[i].name
-				<< ", Description: " << tasks[i].description << endl;
-			unMarkedTaskCount++;
-		}
-	}
 
-	if (taskCount <= 0 || unMarkedTaskCount == 0) {
-		out << "No tasks available to mark importance." << endl;
+	if (taskCount <= 0) {
+		out << "No tasks available to encode." << endl;
 		enterToContinue(in, out);
 		free(tasks);
-		return 0;
+		return;
 	}
-	out << "Select the task to mark importance by entering its ID:" << endl;
 
-	int selectedTaskId;
-	selectedTaskId = getInput(in);
+	out << "Select a task to encode by entering its ID:" << endl;
+	for (int i = 0; i < taskCount; i++) {
+		out << "ID: " << tasks[i].id << " - " << tasks[i].name << endl;
+	}
 
+	int selectedTaskId = getInput(in);
 	Task* selectedTask = nullptr;
 	for (int i = 0; i < taskCount; ++i) {
-		if (tasks[i].id == selectedTaskId && tasks[i].impid == 0) {
+		if (tasks[i].id == selectedTaskId) {
 			selectedTask = &tasks[i];
-			taskAlreadyMarked = true;
 			break;
 		}
 	}
@@ -1113,975 +3640,1602 @@ int markTaskImportance(const char* pathFileTasks, istream& in, ostream& out) {
 		out << "Invalid task ID. Please try again." << endl;
 		enterToContinue(in, out);
 		free(tasks);
-		return 0;
-	}
-
-	out << "Enter the importance ID for the task: ";
-	int importanceId;
-	importanceId = getInput(in);
-
-	if (importanceId < 0) {
-		out << "Invalid input" << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return 0;
-	}
-
-	selectedTask->impid = importanceId;
-
-	FILE* file = fopen(pathFileTasks, "wb");
-	if (!file) {
-		out << "Failed to open file for writing." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return 0;
+		return;
 	}
 
-	for (int i = 0; i < taskCount; ++i) {
-		if (tasks[i].id == selectedTaskId) {
-			fwrite(selectedTask, sizeof(Task), 1, file);
-		}
-		else {
-			fwrite(&tasks[i], sizeof(Task), 1, file);
-		}
-	}
-	fclose(file);
+	const char* taskDescription = selectedTask->description;
+	buildHuffmanTree(pathFileTasks, taskDescription, strlen(taskDescription));
+	string encoded = encode(taskDescription, strlen(taskDescription));
 
-	out << "Task importance marked successfully." << endl;
+	printCodes(out);
+	out << "\nEncoded description for \"" << selectedTask->name << "\": " << encoded << endl;
 	enterToContinue(in, out);
 	free(tasks);
-	return 1;
 }
 
 /**
- * @brief Reorders tasks based on importance.
+ * @brief Labels the Strongly Connected Components (SCCs) of the vertices that have no component yet.
  *
- * This function displays tasks and allows the user to reorder a selected task by changing its importance ID.
+ * This is Pearce's single-pass variant of Tarjan's algorithm with an explicit call stack, so long dependency
+ * chains cannot overflow the thread's stack. Vertices that already have a component are treated as removed from
+ * the graph. Components are completed, and numbered, in reverse topological order of the arcs.
  *
- * @param pathFileTasks Path to the binary file containing tasks.
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the menu and messages.
- * @return int Returns 1 if the task is reordered successfully, otherwise 0.
+ * @param offsets First arc of each vertex.
+ * @param targets Target vertex of each arc.
+ * @param component Component of each vertex, -1 for the vertices to label; updated.
+ * @param firstLabel Number given to the first component found.
+ * @return int The number of components found.
  */
-int reorderTask(const char* pathFileTasks, istream& in, ostream& out) {
-	clearScreen();
-	Task* tasks = nullptr;
-	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
-	int reorderedTaskCount = 0;
-
-	out << "Tasks with importance ID:" << endl;
-	for (int i = 0; i < taskCount; ++i) {
-		if (tasks[i].impid != 0) {
-			out << "ID: " << tasks[i].id << ", Importance ID: " << tasks[i].impid
-				<< ", Name: " << tasks[i].name << ", Description: " << tasks[i].description
-				<< ", Category: " << tasks[i].category << ", Deadline: " << tasks[i].deadLine << endl;
-			reorderedTaskCount++;
+static int pearceComponents(const vector<int>& offsets, const vector<int>& targets, vector<int>& component, int firstLabel) {
+	int V = (int)component.size();
+	vector<int> rindex(V, 0);
+	vector<bool> root(V, false);
+	vector<int> componentStack;
+	vector<pair<int, int>> callStack;
+	int index = 1;
+	int count = firstLabel;
+
+	for (int s = 0; s < V; s++) {
+		if (rindex[s] != 0 || component[s] >= 0) {
+			continue;
 		}
-	}
-
-	if (taskCount <= 0 || reorderedTaskCount == 0) {
-		out << "No tasks available to reorder." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return 0;
-	}
+		rindex[s] = index++;
+		root[s] = true;
+		callStack.push_back(make_pair(s, offsets[s]));
+
+		while (!callStack.empty()) {
+			int v = callStack.back().first;
+			int e = callStack.back().second;
+
+			if (e < offsets[v + 1]) {
+				callStack.back().second++;
+				int w = targets[e];
+				if (rindex[w] == 0) {
+					if (component[w] < 0) {
+						rindex[w] = index++;
+						root[w] = true;
+						callStack.push_back(make_pair(w, offsets[w]));
+					}
+				}
+				else if (component[w] < 0 && rindex[w] < rindex[v]) {
+					rindex[v] = rindex[w];
+					root[v] = false;
+				}
+				continue;
+			}
 
-	out << "Enter the id of the task to reorder :" << endl;
-	int selectedTaskId;
-	selectedTaskId = getInput(in);
+			callStack.pop_back();
+			if (root[v]) {
+				component[v] = count;
+				while (!componentStack.empty() && rindex[componentStack.back()] >= rindex[v]) {
+					component[componentStack.back()] = count;
+					componentStack.pop_back();
+				}
+				count++;
+			}
+			else {
+				componentStack.push_back(v);
+			}
 
-	Task* selectedTask = nullptr;
-	for (int i = 0; i < taskCount; ++i) {
-		if (tasks[i].id == selectedTaskId && tasks[i].impid != 0) {
-			selectedTask = &tasks[i];
-			break;
+			if (!callStack.empty()) {
+				int u = callStack.back().first;
+				if (component[v] < 0 && rindex[v] < rindex[u]) {
+					rindex[u] = rindex[v];
+					root[u] = false;
+				}
+			}
 		}
 	}
-
-	if (!selectedTask) {
-		out << "Invalid task ID. Please try again." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return 0;
-	}
-
-	out << "Enter the new importance ID for the task: ";
-	int newImportanceId;
-	newImportanceId = getInput(in);
-
-	selectedTask->impid = newImportanceId;
-
-	FILE* file = fopen(pathFileTasks, "wb");
-	for (int i = 0; i < taskCount; ++i) {
-		fwrite(&tasks[i], sizeof(Task), 1, file);
-	}
-	fclose(file);
-
-	out << "Task reordered successfully." << endl;
-	enterToContinue(in, out);
-	free(tasks);
-	return 1;
+
+	return count - firstLabel;
 }
 
 /**
- * @brief Finds and displays the most similar tasks based on their descriptions.
+ * @brief Finds the Strongly Connected Components (SCCs) of the task dependency graph.
  *
- * This function compares tasks based on their descriptions and finds the two most similar tasks using the longest common subsequence algorithm.
+ * This function runs Pearce's single-pass variant of Tarjan's algorithm on the dependency arcs. No transpose
+ * graph is built; besides the output it keeps one index per vertex, the call stack and the component stack, all
+ * linear in the number of vertices. Components are numbered in topological order of the dependency arcs: a task's
+ * component never comes after the components of the tasks it depends on.
  *
- * @param pathFileTasks Path to the binary file containing tasks.
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the results.
- * @return bool Always returns true.
+ * @param graph The task graph.
+ * @param components Receives the component number of each vertex index.
+ * @return int The number of components.
  */
-bool similarTasks(const char* pathFileTasks, istream& in, ostream& out) {
-	clearScreen();
-	Task* tasks = nullptr;
-	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
-
-	if (taskCount < 2) {
-		out << "Insufficient number of tasks, at least two tasks are required." << endl;
-		return false;
+int findStronglyConnectedComponents(const TaskGraph& graph, vector<int>* components) {
+	vector<int>& component = *components;
+	component.assign(graph.ids.size(), -1);
+	int count = pearceComponents(graph.depOffsets, graph.depTargets, component, 0);
+
+	// Tarjan completes the components in reverse topological order
+	for (size_t v = 0; v < component.size(); v++) {
+		component[v] = count - 1 - component[v];
 	}
+	return count;
+}
 
-	int maxLcs = 0;
-	int task1Index = -1, task2Index = -1;
+/**
+ * @brief Graphs with fewer vertices than this are decomposed by the sequential search, which is faster there.
+ */
+const int PARALLEL_SCC_MIN_VERTICES = 100000;
 
-	for (int i = 0; i < taskCount - 1; i++) {
-		for (int j = i + 1; j < taskCount; j++) {
-			int lcsLength = longestCommonSubsequence(tasks[i].description, tasks[j].description);
-			if (lcsLength > maxLcs) {
-				maxLcs = lcsLength;
-				task1Index = i;
-				task2Index = j;
+/**
+ * @brief Frontiers with fewer vertices than this are expanded on the calling thread alone.
+ */
+const int PARALLEL_FRONTIER_MIN_VERTICES = 4096;
+
+/**
+ * @brief Trims the vertices that cannot be part of a cycle, in parallel.
+ *
+ * A vertex with no remaining incoming or no remaining outgoing arc is a component on its own. Removing it may
+ * strip the last arc of a neighbour, which is then trimmed by the same thread right away, so a long chain is
+ * peeled in one pass without a barrier per vertex.
+ *
+ * @param offsets First arc of each vertex.
+ * @param targets Target vertex of each arc.
+ * @param reverseOffsets First reversed arc of each vertex.
+ * @param reverseTargets Source vertex of each reversed arc.
+ * @param removed Set for the vertices that already have a component; updated.
+ * @param component Component of each vertex; updated for the trimmed vertices.
+ * @param nextLabel Next free component number; updated.
+ * @param threadCount Number of threads.
+ */
+static void trimComponents(const vector<int>& offsets, const vector<int>& targets, const vector<int>& reverseOffsets,
+	const vector<int>& reverseTargets, vector<atomic<char>>& removed, vector<int>& component, atomic<int>& nextLabel, int threadCount) {
+	int V = (int)component.size();
+	int perThread = (V + threadCount - 1) / threadCount;
+	vector<atomic<int>> inDegree(V);
+	vector<atomic<int>> outDegree(V);
+
+	runOnThreads(threadCount, [&](int t) {
+		int first = min(V, t * perThread);
+		int last = min(V, first + perThread);
+		for (int v = first; v < last; v++) {
+			int out = 0, in = 0;
+			if (!removed[v].load(memory_order_relaxed)) {
+				for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+					out += targets[e] != v && !removed[targets[e]].load(memory_order_relaxed);
+				}
+				for (int e = reverseOffsets[v]; e < reverseOffsets[v + 1]; e++) {
+					in += reverseTargets[e] != v && !removed[reverseTargets[e]].load(memory_order_relaxed);
+				}
 			}
+			outDegree[v].store(out, memory_order_relaxed);
+			inDegree[v].store(in, memory_order_relaxed);
 		}
-	}
+	});
 
-	if (task1Index != -1 && task2Index != -1) {
-		out << "The two most similar tasks are:" << endl;
-		out << "Task 1: " << tasks[task1Index].description << endl;
-		out << "Task 2: " << tasks[task2Index].description << endl;
-		enterToContinue(in, out);
-	}
-	else {
-		out << "No similar task found." << endl;
-		enterToContinue(in, out);
+	runOnThreads(threadCount, [&](int t) {
+		int first = min(V, t * perThread);
+		int last = min(V, first + perThread);
+		vector<int> work;
+
+		for (int s = first; s < last; s++) {
+			if ((outDegree[s].load(memory_order_relaxed) == 0 || inDegree[s].load(memory_order_relaxed) == 0) &&
+				!removed[s].exchange(1)) {
+				work.push_back(s);
+			}
+
+			while (!work.empty()) {
+				int v = work.back();
+				work.pop_back();
+				component[v] = nextLabel.fetch_add(1);
+
+				for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+					int w = targets[e];
+					if (w != v && !removed[w].load(memory_order_relaxed) && inDegree[w].fetch_sub(1) == 1 && !removed[w].exchange(1)) {
+						work.push_back(w);
+					}
+				}
+				for (int e = reverseOffsets[v]; e < reverseOffsets[v + 1]; e++) {
+					int u = reverseTargets[e];
+					if (u != v && !removed[u].load(memory_order_relaxed) && outDegree[u].fetch_sub(1) == 1 && !removed[u].exchange(1)) {
+						work.push_back(u);
+					}
+				}
+			}
+		}
+	});
+}
+
+/**
+ * @brief Marks every vertex reachable from a pivot through vertices without a component, in parallel.
+ *
+ * @param offsets First arc of each vertex.
+ * @param targets Target vertex of each arc.
+ * @param removed Set for the vertices that already have a component.
+ * @param pivot The start vertex.
+ * @param reached Set for every reached vertex; must be clear on entry.
+ * @param threadCount Number of threads.
+ * @return vector<int> The reached vertices.
+ */
+static vector<int> reachComponents(const vector<int>& offsets, const vector<int>& targets, const vector<atomic<char>>& removed,
+	int pivot, vector<atomic<char>>& reached, int threadCount) {
+	vector<int> visited(1, pivot);
+	vector<vector<int>> nextPerThread(threadCount);
+	reached[pivot].store(1, memory_order_relaxed);
+
+	for (size_t begin = 0; begin < visited.size();) {
+		size_t end = visited.size();
+		int workers = end - begin < (size_t)PARALLEL_FRONTIER_MIN_VERTICES ? 1 : threadCount;
+		size_t perThread = (end - begin + workers - 1) / workers;
+
+		runOnThreads(workers, [&](int t) {
+			size_t first = min(end, begin + t * perThread);
+			size_t last = min(end, first + perThread);
+			vector<int>& next = nextPerThread[t];
+			next.clear();
+			for (size_t i = first; i < last; i++) {
+				int v = visited[i];
+				for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+					int w = targets[e];
+					if (!removed[w].load(memory_order_relaxed) && !reached[w].load(memory_order_relaxed) && !reached[w].exchange(1)) {
+						next.push_back(w);
+					}
+				}
+			}
+		});
+
+		for (int t = 0; t < workers; t++) {
+			visited.insert(visited.end(), nextPerThread[t].begin(), nextPerThread[t].end());
+		}
+		begin = end;
 	}
-	free(tasks);
-	return true;
+	return visited;
 }
 
 /**
- * @brief Displays and handles the task allegiances menu.
- *
- * This function displays the task allegiances menu and processes user input to perform BFS or DFS on the tasks.
- *
- * @param pathFileTasks Path to the binary file containing tasks.
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the menu and messages.
- * @return bool Always returns true.
+ * @brief Finds the Strongly Connected Components (SCCs) of the task dependency graph on several threads.
+ *
+ * The decomposition trims the vertices that cannot be on a cycle, takes the component of the remaining vertex
+ * with the most arcs as the intersection of its forward and backward reachable sets, trims again, and leaves
+ * what is left, usually a few small components, to the sequential search. Dependency graphs tend to have one
+ * large component, which this takes out with two parallel traversals. Graphs with fewer than
+ * PARALLEL_SCC_MIN_VERTICES vertices, or a single thread, use findStronglyConnectedComponents directly.
+ * The numbering is topological as with findStronglyConnectedComponents, but tasks that do not depend on each
+ * other may come in a different order.
+ *
+ * @param graph The task graph.
+ * @param threadCount Number of threads, or 0 to use one per hardware thread.
+ * @param components Receives the component number of each vertex index.
+ * @return int The number of components.
  */
-bool allegiances(const char* pathFileTasks, istream& in, ostream& out) {
-	clearScreen();
-	Task* tasks = nullptr;
-	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
-	int choice, startVertex;
+int parallelStronglyConnectedComponents(const TaskGraph& graph, int threadCount, vector<int>* components) {
+	int V = (int)graph.ids.size();
+	threadCount = resolveThreadCount(threadCount);
+	if (V < PARALLEL_SCC_MIN_VERTICES || threadCount == 1) {
+		return findStronglyConnectedComponents(graph, components);
+	}
 
-	if (taskCount <= 0) {
-		out << "No Tasks Available." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return 0;
+	const vector<int>& offsets = graph.depOffsets;
+	const vector<int>& targets = graph.depTargets;
+	const vector<int>& reverseOffsets = graph.dependentOffsets;
+	const vector<int>& reverseTargets = graph.dependentTargets;
+
+	vector<int>& component = *components;
+	component.assign(V, -1);
+	vector<atomic<char>> removed(V);
+	for (int v = 0; v < V; v++) {
+		removed[v].store(0, memory_order_relaxed);
 	}
+	atomic<int> nextLabel(0);
 
-	out << "Choose algorithm:\n 1. BFS\n 2. DFS\n";
-	choice = getInput(in);
+	trimComponents(offsets, targets, reverseOffsets, reverseTargets, removed, component, nextLabel, threadCount);
 
-	viewTaskForFunc(pathFileTasks, in, out);
+	int pivot = -1;
+	long long pivotArcs = -1;
+	for (int v = 0; v < V; v++) {
+		long long arcs = (long long)(offsets[v + 1] - offsets[v]) * (reverseOffsets[v + 1] - reverseOffsets[v]);
+		if (!removed[v].load(memory_order_relaxed) && arcs > pivotArcs) {
+			pivot = v;
+			pivotArcs = arcs;
+		}
+	}
 
-	out << "\nEnter the starting task ID:\n";
-	startVertex = getInput(in);
+	if (pivot >= 0) {
+		vector<atomic<char>> forward(V);
+		vector<atomic<char>> backward(V);
+		for (int v = 0; v < V; v++) {
+			forward[v].store(0, memory_order_relaxed);
+			backward[v].store(0, memory_order_relaxed);
+		}
+		vector<int> reached = reachComponents(offsets, targets, removed, pivot, forward, threadCount);
+		reachComponents(reverseOffsets, reverseTargets, removed, pivot, backward, threadCount);
+
+		int label = nextLabel.fetch_add(1);
+		for (size_t i = 0; i < reached.size(); i++) {
+			if (backward[reached[i]].load(memory_order_relaxed)) {
+				component[reached[i]] = label;
+				removed[reached[i]].store(1, memory_order_relaxed);
+			}
+		}
+		trimComponents(offsets, targets, reverseOffsets, reverseTargets, removed, component, nextLabel, threadCount);
+	}
 
-	if (startVertex > taskCount) {
-		out << "There is no " << startVertex << ". Task";
-		enterToContinue(in, out);
-		return 0;
+	int count = nextLabel.load();
+	count += pearceComponents(offsets, targets, component, count);
+
+	// Renumber in topological order of the components with Kahn's algorithm on the condensed graph
+	vector<int> first(count + 1, 0);
+	for (int v = 0; v < V; v++) {
+		first[component[v] + 1]++;
+	}
+	for (int c = 0; c < count; c++) {
+		first[c + 1] += first[c];
+	}
+	vector<int> members(V);
+	vector<int> fill(first.begin(), first.end() - 1);
+	for (int v = 0; v < V; v++) {
+		members[fill[component[v]]++] = v;
 	}
 
-	int result = 0;
-	switch (choice) {
-	case 1:
-		result = BFS(startVertex);
-		break;
-	case 2:
-		result = DFS(startVertex);
-		break;
-	default:
-		out << "Wrong Input ";
-		enterToContinue(in, out);
-		return 0;
+	vector<int> inArcs(count, 0);
+	for (int v = 0; v < V; v++) {
+		for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+			if (component[targets[e]] != component[v]) {
+				inArcs[component[targets[e]]]++;
+			}
+		}
+	}
+	vector<int> order;
+	order.reserve(count);
+	for (int c = 0; c < count; c++) {
+		if (inArcs[c] == 0) {
+			order.push_back(c);
+		}
+	}
+	for (size_t head = 0; head < order.size(); head++) {
+		int c = order[head];
+		for (int i = first[c]; i < first[c + 1]; i++) {
+			int v = members[i];
+			for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+				int d = component[targets[e]];
+				if (d != c && --inArcs[d] == 0) {
+					order.push_back(d);
+				}
+			}
+		}
 	}
 
-	out << "Number of tasks connected to task " << startVertex << " is: " << result << endl;
-	enterToContinue(in, out);
-	return true;
+	vector<int> rank(count);
+	for (int i = 0; i < count; i++) {
+		rank[order[i]] = i;
+	}
+	for (int v = 0; v < V; v++) {
+		component[v] = rank[component[v]];
+	}
+	return count;
 }
 
 /**
- * @brief Calculates and displays the minimum spanning tree (MST) of the tasks.
+ * @brief Finds and prints all Strongly Connected Components (SCCs) of the task dependency graph.
  *
- * This function displays the MST menu and processes user input to calculate the MST using Prim's or Kruskal's algorithm.
+ * This function prints the components found by parallelStronglyConnectedComponents, each with its task ids in ascending order.
  *
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the results.
- * @return bool Always returns true.
+ * @param graph The task graph.
+ * @param out Output stream for displaying the SCCs.
  */
-bool calculateMST(istream& in, ostream& out) {
-	viewTaskForFunc(pathFileTasks, in, out);
-	out << "\nEnter the starting task ID:\n";
-	int startVertex = getInput(in);
-
-	if (startVertex >= MAX_TASKS || startVertex < 0) {
-		out << "Invalid task ID." << endl;
-		enterToContinue(in, out);
-		return false;
-	}
-
-	loadTasksAndDependencies(pathFileTasks);
-
-	out << "Choose MST algorithm:\n 1. Prim's Algorithm\n 2. Kruskal's Algorithm\n";
-	int mstChoice = getInput(in);
+void findSCCs(const TaskGraph& graph, ostream& out) {
+	vector<int> component;
+	int numSCC = parallelStronglyConnectedComponents(graph, 0, &component);
 
-	if (mstChoice == 1) {
-		primMST(startVertex, out);
+	vector<int> first(numSCC + 1, 0);
+	for (size_t v = 0; v < component.size(); v++) {
+		first[component[v] + 1]++;
 	}
-	else if (mstChoice == 2) {
-		kruskalMST(MAX_TASKS, out);
+	for (int c = 0; c < numSCC; c++) {
+		first[c + 1] += first[c];
 	}
-	else {
-		out << "Invalid choice." << endl;
+	vector<int> members(component.size());
+	for (size_t v = 0; v < component.size(); v++) {
+		members[first[component[v]]++] = (int)v;
 	}
 
-	enterToContinue(in, out);
-	return true;
+	int begin = 0;
+	for (int c = 0; c < numSCC; c++) {
+		out << "SCC #" << (c + 1) << ": ";
+		for (int i = begin; i < first[c]; i++) {
+			out << graph.ids[members[i]] << " ";
+		}
+		out << "\n";
+		begin = first[c];
+	}
 }
 
 /**
- * @brief Calculates and displays the shortest path between tasks.
+ * @brief Analyzes and prints Strongly Connected Components (SCCs) of tasks.
  *
- * This function displays the shortest path menu and processes user input to calculate the shortest path using Dijkstra's or Bellman-Ford algorithm.
+ * This function loads tasks, builds the task graph, and finds SCCs.
  *
+ * @param pathFileTasks Path to the binary file containing tasks.
  * @param in Input stream for reading user input.
- * @param out Output stream for displaying the results.
- * @return bool Always returns true.
+ * @param out Output stream for displaying the SCCs.
+ * @return bool Returns true if SCCs are analyzed successfully, otherwise false.
  */
-bool shortestPath(istream& in, ostream& out) {
-	viewTaskForFunc(pathFileTasks, in, out);
-	out << "\nEnter the starting task ID:\n";
-	int startVertex = getInput(in);
-
-	if (startVertex < 0 || startVertex >= MAX_TASKS) {
-		out << "Invalid task ID.\n";
-		enterToContinue(in, out);
-		return false;
-	}
-
-	out << "Choose shortest path algorithm:\n 1. Dijkstra\n 2. Bellman-Ford\n";
-	int choice = getInput(in);
+bool analyzeSCC(const char* pathFileTasks, istream& in, ostream& out) {
+	clearScreen();
+	Task* tasks = nullptr;
+	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
+	free(tasks);
 
-	switch (choice) {
-	case 1:
-		calculateShortestPath(startVertex, out);
-		break;
-	case 2:
-		calculateBellmanFord(startVertex, MAX_TASKS, out);
-		break;
-	default:
-		out << "Invalid choice.\n";
+	if (taskCount <= 0) {
+		out << "There is no task." << endl;
 		enterToContinue(in, out);
 		return false;
 	}
 
+	syncTaskGraph(pathFileTasks);
+	findSCCs(taskGraph, out);
 	enterToContinue(in, out);
 	return true;
 }
 
-//Algorithms
-
-
 /**
- * @brief Loads tasks and their dependencies from the binary file.
+ * @brief Min-heap of vertices ordered by a key array, with decrease-key.
  *
- * This function reads tasks from the specified binary file and adds edges with weights to the adjacency list.
- *
- * @param pathFileTasks Path to the binary file containing tasks.
- * @return bool Returns true if tasks are loaded successfully, otherwise false.
+ * A 4-ary heap keeps the tree shallow, so a decrease-key moves a vertex up fewer levels than in a binary heap,
+ * and the four children compared when moving down sit next to each other in memory. The position of every
+ * vertex is tracked, so a vertex whose key decreased is moved up in place instead of being queued again.
+ * Equal keys are ordered by vertex index.
  */
-bool loadTasksAndDependencies(const char* pathFileTasks) {
-	FILE* file = fopen(pathFileTasks, "rb");
-	if (!file) {
-		cout << "Failed to open task file." << endl;
-		return false;
+class IndexedHeap {
+public:
+	/**
+	 * @brief Creates an empty heap.
+	 *
+	 * @param key Key of each vertex; a key may only decrease while its vertex is in the heap.
+	 */
+	explicit IndexedHeap(const vector<int>& key) : key(key), position(key.size(), -1) {}
+
+	/**
+	 * @brief Returns true if the heap holds no vertex.
+	 */
+	bool empty() const {
+		return heap.empty();
 	}
 
-	Task task;
-	while (fread(&task, sizeof(Task), 1, file)) {
-		for (int i = 0; i < task.numDependencies; i++) {
-			int depId = task.dependencies[i];
-			int weight = task.id + depId;
-			addEdgeWithWeight(task.id, depId, weight);
+	/**
+	 * @brief Inserts a vertex, or moves it up after its key decreased.
+	 *
+	 * @param v The vertex.
+	 */
+	void push(int v) {
+		if (position[v] < 0) {
+			position[v] = (int)heap.size();
+			heap.push_back(v);
 		}
+		siftUp(position[v]);
 	}
-	fclose(file);
-	return true;
-}
 
-/**
- * @brief Performs Breadth-First Search (BFS) on the task graph.
- *
- * This function performs BFS starting from the specified vertex and returns the number of connected tasks.
- *
- * @param startVertex The starting vertex for BFS.
- * @return int The number of tasks connected to the starting vertex.
- */
-int BFS(int startVertex) {
-	bool visited[MAX_TASKS] = { false };
-	queue<int> queue;
-	int connectedCount = 0;
+	/**
+	 * @brief Removes and returns the vertex with the smallest key.
+	 *
+	 * @return int The vertex.
+	 */
+	int pop() {
+		int top = heap[0];
+		int last = heap.back();
+		heap.pop_back();
+		position[top] = -1;
+		if (!heap.empty()) {
+			heap[0] = last;
+			position[last] = 0;
+			siftDown(0);
+		}
+		return top;
+	}
 
-	visited[startVertex] = true;
-	queue.push(startVertex);
+private:
+	static const int ARITY = 4;   /**< Children per heap node */
 
-	while (!queue.empty()) {
-		int current = queue.front();
-		queue.pop();
-		connectedCount++;
+	/**
+	 * @brief Returns true if vertex a comes before vertex b in the heap order.
+	 */
+	bool before(int a, int b) const {
+		return key[a] < key[b] || (key[a] == key[b] && a < b);
+	}
+
+	/**
+	 * @brief Stores a vertex at a heap index and records its position.
+	 */
+	void place(int i, int v) {
+		heap[i] = v;
+		position[v] = i;
+	}
+
+	/**
+	 * @brief Moves the vertex at a heap index up until its parent comes before it.
+	 */
+	void siftUp(int i) {
+		int v = heap[i];
+		while (i > 0 && before(v, heap[(i - 1) / ARITY])) {
+			place(i, heap[(i - 1) / ARITY]);
+			i = (i - 1) / ARITY;
+		}
+		place(i, v);
+	}
 
-		for (const auto& adjPair : adj[current]) {
-			int adj = adjPair.first;
-			if (!visited[adj]) {
-				visited[adj] = true;
-				queue.push(adj);
+	/**
+	 * @brief Moves the vertex at a heap index down until it comes before all its children.
+	 */
+	void siftDown(int i) {
+		int v = heap[i];
+		int n = (int)heap.size();
+		for (;;) {
+			int first = i * ARITY + 1;
+			if (first >= n) {
+				break;
 			}
+			int best = first;
+			for (int c = first + 1; c < min(first + ARITY, n); c++) {
+				if (before(heap[c], heap[best])) {
+					best = c;
+				}
+			}
+			if (!before(heap[best], v)) {
+				break;
+			}
+			place(i, heap[best]);
+			i = best;
 		}
+		place(i, v);
 	}
 
-	return connectedCount;
-}
+	const vector<int>& key;     /**< Key of each vertex */
+	vector<int> heap;           /**< Vertices in heap order */
+	vector<int> position;       /**< Index of each vertex in heap, -1 if it is not in the heap */
+};
 
 /**
- * @brief Utility function for Depth-First Search (DFS).
+ * @brief Finds and prints the Minimum Spanning Tree (MST) using Prim's algorithm.
  *
- * This function recursively performs DFS starting from the specified vertex and returns the number of connected tasks.
+ * This function finds and prints a minimum spanning forest of the task graph using Prim's algorithm. The tree of
+ * the component containing the given task is grown first, then one tree for every other component, so tasks
+ * without a path to the starting task are covered as well. The frontier is an IndexedHeap.
  *
- * @param vertex The current vertex in DFS.
- * @param visited Array to track visited vertices.
- * @return int The number of tasks connected to the current vertex.
+ * @param startVertex The id of the starting task for Prim's algorithm.
+ * @param out Output stream for displaying the MST.
  */
-int DFSUtil(int vertex, bool visited[]) {
-	visited[vertex] = true;
-	int connectedCount = 1;
+void primMST(int startVertex, ostream& out) {
+	int V = (int)taskGraph.ids.size();
+	vector<int> key(V, INT_MAX);
+	vector<int> parent(V, -1);
+	vector<bool> inMST(V, false);
+
+	out << "Edge \tWeight\n";
+	int start = taskGraphIndex(taskGraph, startVertex);
+	if (start < 0) {
+		return;
+	}
+
+	IndexedHeap heap(key);
+	int next = 0;
+	for (int root = start; root < V; ) {
+		key[root] = 0;
+		heap.push(root);
+
+		while (!heap.empty()) {
+			int u = heap.pop();
+			inMST[u] = true;
+
+			for (int e = taskGraph.offsets[u]; e < taskGraph.offsets[u + 1]; e++) {
+				int v = taskGraph.targets[e];
+				int weight = taskGraph.weights[e];
+
+				if (!inMST[v] && key[v] > weight) {
+					key[v] = weight;
+					parent[v] = u;
+					heap.push(v);
+				}
+			}
+		}
 
-	for (const auto& adjPair : adj[vertex]) {
-		int adj = adjPair.first;
-		if (!visited[adj]) {
-			connectedCount += DFSUtil(adj, visited);
+		while (next < V && inMST[next]) {
+			next++;
 		}
+		root = next;
 	}
 
-	return connectedCount;
+	for (int i = 0; i < V; ++i) {
+		if (parent[i] != -1) {
+			out << taskGraph.ids[parent[i]] << " - " << taskGraph.ids[i] << "\t" << key[i] << " \n";
+		}
+	}
 }
 
 /**
- * @brief Performs Depth-First Search (DFS) on the task graph.
+ * @brief Compares two edges based on their weight.
  *
- * This function performs DFS starting from the specified vertex and returns the number of connected tasks.
+ * This function compares two edges and returns true if the first edge has a smaller weight than the second edge.
  *
- * @param startVertex The starting vertex for DFS.
- * @return int The number of tasks connected to the starting vertex.
+ * @param a The first edge.
+ * @param b The second edge.
+ * @return bool Returns true if the first edge has a smaller weight, otherwise false.
  */
-int DFS(int startVertex) {
-	bool visited[MAX_TASKS] = { false };
-	return DFSUtil(startVertex, visited);
+bool compareEdges(const Edge& a, const Edge& b) {
+	return a.weight < b.weight;
 }
 
 /**
- * @brief Heapifies a subtree with the root at the given index.
+ * @brief Finds the root of a set in the union-find data structure.
  *
- * This function heapifies a subtree in a max heap with the root at the specified index.
+ * This function finds the root of the set containing the given element, halving the path on the way up.
  *
- * @param users Array of User objects.
- * @param n The size of the heap.
- * @param i The root index of the subtree.
+ * @param parent The array representing the union-find data structure; a negative entry marks a root and holds
+ * -(rank + 1), so an array filled with -1 is a set of singletons.
+ * @param i The element whose root is to be found.
+ * @return int The root of the set containing the element.
  */
-void heapify(User users[], int n, int i) {
-	int largest = i;
-	int left = 2 * i + 1;
-	int right = 2 * i + 2;
-
-	if (left < n && users[left].id > users[largest].id)
-		largest = left;
-
-	if (right < n && users[right].id > users[largest].id)
-		largest = right;
-
-	if (largest != i) {
-		User swap = users[i];
-		users[i] = users[largest];
-		users[largest] = swap;
-
-		heapify(users, n, largest);
+int find(int parent[], int i) {
+	while (parent[i] >= 0) {
+		if (parent[parent[i]] >= 0) {
+			parent[i] = parent[parent[i]];
+		}
+		i = parent[i];
 	}
+	return i;
 }
 
 /**
- * @brief Builds a max heap from the given array of users.
+ * @brief Unites two sets in the union-find data structure.
  *
- * This function builds a max heap from the specified array of User objects.
+ * This function unites the sets containing the two given elements, hanging the root of lower rank under the
+ * other, so no path grows longer than log2 of the number of elements.
  *
- * @param users Array of User objects.
- * @param n The size of the array.
+ * @param parent The array representing the union-find data structure.
+ * @param x The first element.
+ * @param y The second element.
  */
-void buildMaxHeap(User users[], int n) {
-	for (int i = n / 2 - 1; i >= 0; i--)
-		heapify(users, n, i);
+void unionSets(int parent[], int x, int y) {
+	int xset = find(parent, x);
+	int yset = find(parent, y);
+	if (xset == yset) {
+		return;
+	}
+	if (parent[xset] > parent[yset]) {
+		swap(xset, yset);
+	}
+	if (parent[xset] == parent[yset]) {
+		parent[xset]--;
+	}
+	parent[yset] = xset;
 }
 
 /**
- * @brief Finds the length of the longest common subsequence between two strings.
+ * @brief Sorts edges by weight with a least significant digit radix sort.
  *
- * This function calculates the length of the longest common subsequence between two given strings.
+ * The weights are sorted 8 bits at a time in four counting passes, and a pass is skipped when every weight has
+ * the same byte there. The sort is stable, so edges of equal weight keep their order.
  *
- * @param text1 The first string.
- * @param text2 The second string.
- * @return int The length of the longest common subsequence.
+ * @param edges The edges to sort.
  */
-int longestCommonSubsequence(const char* text1, const char* text2) {
-	int m = strlen(text1);
-	int n = strlen(text2);
-	int dp[101][101] = { 0 };
+static void radixSortEdges(vector<Edge>& edges) {
+	if (edges.size() < 2) {
+		return;
+	}
+	vector<Edge> buffer(edges.size());
 
-	for (int i = 1; i <= m; i++) {
-		for (int j = 1; j <= n; j++) {
-			if (text1[i - 1] == text2[j - 1]) {
-				dp[i][j] = dp[i - 1][j - 1] + 1;
-			}
-			else {
-				dp[i][j] = max(dp[i - 1][j], dp[i][j - 1]);
-			}
+	for (int shift = 0; shift < 32; shift += 8) {
+		size_t count[257] = { 0 };
+		for (size_t i = 0; i < edges.size(); i++) {
+			count[((((unsigned)edges[i].weight ^ 0x80000000u) >> shift) & 0xff) + 1]++;
+		}
+		if (count[((((unsigned)edges[0].weight ^ 0x80000000u) >> shift) & 0xff) + 1] == edges.size()) {
+			continue;
+		}
+		for (int digit = 0; digit < 256; digit++) {
+			count[digit + 1] += count[digit];
 		}
+		for (size_t i = 0; i < edges.size(); i++) {
+			buffer[count[(((unsigned)edges[i].weight ^ 0x80000000u) >> shift) & 0xff]++] = edges[i];
+		}
+		edges.swap(buffer);
 	}
-
-	return dp[m][n];
 }
 
 /**
- * @brief Builds a Huffman tree from the given data.
+ * @brief Finds a minimum spanning forest of a task graph with Kruskal's algorithm.
  *
- * This function constructs a Huffman tree based on the frequency of characters in the given data and stores the Huffman codes.
+ * The edges are radix sorted by weight and added in that order unless a union-find with path halving and union
+ * by rank finds their ends already connected.
  *
- * @param pathFileTasks Path to the binary file containing tasks (unused in this function).
- * @param data The input data to build the Huffman tree from.
- * @param size The size of the input data.
+ * @param graph The task graph.
+ * @param V Number of vertices of the task graph to consider, the first V in index order.
+ * @param forest Receives the edges of the forest as vertex indexes, in ascending weight order.
+ * @return long long The total weight of the forest.
  */
-void buildHuffmanTree(const char* pathFileTasks, const char* data, int size) {
-	unordered_map<char, int> freq;
-	for (int i = 0; i < size; ++i)
-		freq[data[i]]++;
+long long kruskalForest(const TaskGraph& graph, int V, vector<Edge>* forest) {
+	V = min(max(V, 0), (int)graph.ids.size());
+	vector<Edge> edges;
 
-	priority_queue<HuffmanNode*, vector<HuffmanNode*>, compare> minHeap;
+	for (int u = 0; u < V; u++) {
+		for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+			if (u < graph.targets[e] && graph.targets[e] < V) {
+				edges.push_back({ u, graph.targets[e], graph.weights[e] });
+			}
+		}
+	}
 
-	for (auto pair : freq)
-		minHeap.push(new HuffmanNode(pair.first, pair.second));
+	radixSortEdges(edges);
 
-	while (minHeap.size() != 1) {
-		HuffmanNode* left = minHeap.top();
-		minHeap.pop();
-		HuffmanNode* right = minHeap.top();
-		minHeap.pop();
+	vector<int> parent(V, -1);
+	long long total = 0;
+	forest->clear();
 
-		HuffmanNode* top = new HuffmanNode('$', left->freq + right->freq);
-		top->left = left;
-		top->right = right;
-		minHeap.push(top);
-	}
+	for (size_t i = 0; i < edges.size() && (int)forest->size() < V - 1; i++) {
+		int x = find(parent.data(), edges[i].src);
+		int y = find(parent.data(), edges[i].dest);
 
-	storeCodes(minHeap.top(), "");
+		if (x != y) {
+			forest->push_back(edges[i]);
+			total += edges[i].weight;
+			unionSets(parent.data(), x, y);
+		}
+	}
+	return total;
 }
 
 /**
- * @brief Stores Huffman codes for the given Huffman tree.
+ * @brief Finds and prints the Minimum Spanning Tree (MST) using Kruskal's algorithm.
  *
- * This function traverses the Huffman tree and stores the Huffman codes for each character.
+ * This function finds and prints the minimum spanning forest of the task graph using Kruskal's algorithm.
  *
- * @param root The root of the Huffman tree.
- * @param str The current Huffman code as a string.
+ * @param V Number of vertices of the task graph to consider.
+ * @param out Output stream for displaying the MST.
  */
-void storeCodes(HuffmanNode* root, string str) {
-	if (root == nullptr)
-		return;
-	if (root->data != '$')
-		codes[root->data] = str;
-	storeCodes(root->left, str + "0");
-	storeCodes(root->right, str + "1");
+void kruskalMST(int V, ostream& out) {
+	vector<Edge> result;
+	kruskalForest(taskGraph, V, &result);
+
+	out << "Edge \tWeight\n";
+	for (size_t i = 0; i < result.size(); i++) {
+		out << taskGraph.ids[result[i].src] << " - " << taskGraph.ids[result[i].dest] << "\t" << result[i].weight << " \n";
+	}
 }
 
 /**
- * @brief Prints the stored Huffman codes.
- *
- * This function prints the Huffman codes for each character to the output stream.
- *
- * @param out Output stream for displaying the Huffman codes.
+ * @brief Finds a minimum spanning forest of a task graph with Boruvka's algorithm on several threads.
+ *
+ * Each round every component picks its lightest edge to another component and all picked edges are added at
+ * once, so the number of components at least halves per round. The edges are scanned in parallel and each
+ * component keeps its pick in an atomic word holding the weight and the edge's index, which breaks ties the
+ * same way from both ends and so never closes a cycle. Edges inside a component are dropped after each round.
+ * Unlike kruskalForest nothing is sorted, which suits large graphs.
+ *
+ * @param graph The task graph.
+ * @param threadCount Number of threads, or 0 to use one per hardware thread.
+ * @param forest Receives the edges of the forest as vertex indexes, in no particular order.
+ * @return long long The total weight of the forest.
  */
-void printCodes(ostream& out) {
-	for (auto pair : codes) {
-		out << pair.first << ": " << pair.second << "\n";
+long long boruvkaMST(const TaskGraph& graph, int threadCount, vector<Edge>* forest) {
+	const uint64_t NO_EDGE = ~(uint64_t)0;
+	int V = (int)graph.ids.size();
+	threadCount = resolveThreadCount(threadCount);
+
+	vector<Edge> edges;
+	for (int u = 0; u < V; u++) {
+		for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+			if (u < graph.targets[e]) {
+				edges.push_back({ u, graph.targets[e], graph.weights[e] });
+			}
+		}
+	}
+
+	vector<int> live(edges.size());
+	for (size_t i = 0; i < live.size(); i++) {
+		live[i] = (int)i;
+	}
+	vector<int> parent(V, -1);
+	vector<int> label(V);
+	for (int v = 0; v < V; v++) {
+		label[v] = v;
+	}
+	vector<atomic<uint64_t>> best(V);
+	for (int v = 0; v < V; v++) {
+		best[v].store(NO_EDGE, memory_order_relaxed);
 	}
+	vector<vector<int>> kept(threadCount);
+	long long total = 0;
+	forest->clear();
+
+	while (!live.empty()) {
+		int workers = (int)min((size_t)threadCount, live.size());
+		size_t perThread = (live.size() + workers - 1) / workers;
+		runOnThreads(workers, [&](int t) {
+			size_t first = min(live.size(), t * perThread);
+			size_t last = min(live.size(), first + perThread);
+			kept[t].clear();
+			for (size_t k = first; k < last; k++) {
+				const Edge& edge = edges[live[k]];
+				int cu = label[edge.src];
+				int cv = label[edge.dest];
+				if (cu == cv) {
+					continue;
+				}
+				kept[t].push_back(live[k]);
+				uint64_t key = ((uint64_t)((unsigned)edge.weight ^ 0x80000000u) << 32) | (uint32_t)live[k];
+				for (int c : { cu, cv }) {
+					uint64_t current = best[c].load(memory_order_relaxed);
+					while (key < current && !best[c].compare_exchange_weak(current, key, memory_order_relaxed)) {
+					}
+				}
+			}
+		});
+
+		live.clear();
+		for (int t = 0; t < workers; t++) {
+			live.insert(live.end(), kept[t].begin(), kept[t].end());
+		}
+		if (live.empty()) {
+			break;
+		}
+
+		// Both ends may have picked the same edge, only the first union adds it
+		for (int c = 0; c < V; c++) {
+			uint64_t key = best[c].load(memory_order_relaxed);
+			if (key == NO_EDGE) {
+				continue;
+			}
+			best[c].store(NO_EDGE, memory_order_relaxed);
+			const Edge& edge = edges[(uint32_t)key];
+			int x = find(parent.data(), edge.src);
+			int y = find(parent.data(), edge.dest);
+			if (x != y) {
+				unionSets(parent.data(), x, y);
+				forest->push_back(edge);
+				total += edge.weight;
+			}
+		}
+
+		int labelThreads = min(threadCount, max(1, V));
+		int verticesPerThread = (V + labelThreads - 1) / labelThreads;
+		runOnThreads(labelThreads, [&](int t) {
+			int last = min(V, (t + 1) * verticesPerThread);
+			for (int v = t * verticesPerThread; v < last; v++) {
+				int root = v;
+				while (parent[root] >= 0) {
+					root = parent[root];
+				}
+				label[v] = root;
+			}
+		});
+	}
+	return total;
 }
 
 /**
- * @brief Encodes the given data using the stored Huffman codes.
+ * @brief Runs Dijkstra's algorithm on a task graph.
  *
- * This function encodes the input data based on the previously stored Huffman codes.
+ * The frontier is an IndexedHeap, so every vertex is in it at most once. With a target the search stops as soon
+ * as the target is settled, leaving farther vertices unsettled.
  *
- * @param data The input data to encode.
- * @param size The size of the input data.
- * @return string The encoded string.
+ * @param graph The task graph.
+ * @param source Vertex index of the source.
+ * @param target Vertex index at which to stop, or -1 to settle every reachable vertex.
+ * @param dist Receives the distance of each vertex, INT_MAX if not reached; exact for settled vertices.
+ * @param parent Receives the vertex each vertex was reached from, -1 for the source and vertices not reached.
  */
-string encode(const char* data, int size) {
-	string encodedString = "";
-	for (int i = 0; i < size; ++i) {
-		encodedString += codes[data[i]];
+static void dijkstraSearch(const TaskGraph& graph, int source, int target, vector<int>& dist, vector<int>& parent) {
+	int V = (int)graph.ids.size();
+	dist.assign(V, INT_MAX);
+	parent.assign(V, -1);
+
+	IndexedHeap heap(dist);
+	dist[source] = 0;
+	heap.push(source);
+
+	while (!heap.empty()) {
+		int u = heap.pop();
+		if (u == target) {
+			return;
+		}
+
+		for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+			int v = graph.targets[e];
+			int weight = graph.weights[e];
+
+			if (dist[u] + weight < dist[v]) {
+				dist[v] = dist[u] + weight;
+				parent[v] = u;
+				heap.push(v);
+			}
+		}
 	}
-	return encodedString;
 }
 
 /**
- * @brief Displays and handles the Huffman encoding task menu.
+ * @brief Finds the shortest route between two tasks using Dijkstra's algorithm.
  *
- * This function displays the Huffman encoding task menu, processes user input, and encodes the selected task description using Huffman coding.
+ * The search stops as soon as the target task is settled and the route is read back from the parent pointers.
  *
- * @param pathFileTasks Path to the binary file containing tasks.
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the menu and messages.
+ * @param graph The task graph.
+ * @param startTaskId The id of the starting task.
+ * @param targetTaskId The id of the target task.
+ * @param route Receives the task ids along the route, from the starting task to the target; empty if there is none.
+ * @return int The length of the route, or -1 if either task is not in the graph or the target is not reachable.
  */
-void huffmanEncodingTaskMenu(const char* pathFileTasks, istream& in, ostream& out) {
-	clearScreen();
-	Task* tasks = nullptr;
-	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
-
-	if (taskCount <= 0) {
-		out << "No tasks available to encode." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return;
+int findShortestRoute(const TaskGraph& graph, int startTaskId, int targetTaskId, vector<int>* route) {
+	route->clear();
+	int source = taskGraphIndex(graph, startTaskId);
+	int target = taskGraphIndex(graph, targetTaskId);
+	if (source < 0 || target < 0) {
+		return -1;
 	}
 
-	out << "Select a task to encode by entering its ID:" << endl;
-	for (int i = 0; i < taskCount; i++) {
-		out << "ID: " << tasks[i].id << " - " << tasks[i].name << endl;
+	vector<int> dist;
+	vector<int> parent;
+	dijkstraSearch(graph, source, target, dist, parent);
+	if (dist[target] == INT_MAX) {
+		return -1;
 	}
 
-	int selectedTaskId = getInput(in);
-	Task* selectedTask = nullptr;
-	for (int i = 0; i < taskCount; ++i) {
-		if (tasks[i].id == selectedTaskId) {
-			selectedTask = &tasks[i];
-			break;
-		}
+	for (int v = target; v >= 0; v = parent[v]) {
+		route->push_back(graph.ids[v]);
 	}
+	reverse(route->begin(), route->end());
+	return dist[target];
+}
 
-	if (!selectedTask) {
-		out << "Invalid task ID. Please try again." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return;
+/**
+ * @brief Computes the distance from a task to every task using Dijkstra's algorithm.
+ *
+ * @param graph The task graph.
+ * @param startTaskId The id of the starting task.
+ * @param dist Receives the distance of each vertex index, INT_MAX for vertices that cannot be reached.
+ * @return int The number of tasks reached, including the starting task; 0 if it is not in the graph.
+ */
+int dijkstraDistances(const TaskGraph& graph, int startTaskId, vector<int>* dist) {
+	int source = taskGraphIndex(graph, startTaskId);
+	if (source < 0) {
+		dist->assign(graph.ids.size(), INT_MAX);
+		return 0;
 	}
 
-	const char* taskDescription = selectedTask->description;
-	buildHuffmanTree(pathFileTasks, taskDescription, strlen(taskDescription));
-	string encoded = encode(taskDescription, strlen(taskDescription));
-
-	printCodes(out);
-	out << "\nEncoded description for \"" << selectedTask->name << "\": " << encoded << endl;
-	enterToContinue(in, out);
-	free(tasks);
+	vector<int> parent;
+	dijkstraSearch(graph, source, -1, *dist, parent);
+	return (int)(dist->size() - count(dist->begin(), dist->end(), INT_MAX));
 }
 
 /**
- * @brief Builds the transpose of a graph.
- *
- * This function constructs the transpose of a given graph, where all edges are reversed.
+ * @brief Prints the distance of every reached task.
  *
- * @param V Number of vertices in the graph.
- * @param adjLists Adjacency list of the original graph.
- * @param transpose Adjacency list of the transpose graph.
+ * @param graph The task graph.
+ * @param dist Distance of each vertex index, INT_MAX for vertices that were not reached.
+ * @param out Output stream for displaying the distances.
  */
-void buildTranspose(int V, list<int>* adjLists, list<int>* transpose) {
-	for (int v = 0; v < V; v++) {
-		for (int u : adjLists[v]) {
-			transpose[u].push_back(v);
+static void printDistances(const TaskGraph& graph, const vector<int>& dist, ostream& out) {
+	for (size_t i = 0; i < dist.size(); i++) {
+		if (dist[i] != INT_MAX) {
+			out << graph.ids[i] << "\t" << dist[i] << "\n";
 		}
 	}
 }
 
 /**
- * @brief Utility function for Depth-First Search (DFS) in SCCs.
+ * @brief Calculates and prints the shortest path from the start vertex using Dijkstra's algorithm.
  *
- * This function performs DFS on a graph, used to fill the stack with vertices in the order of completion times.
+ * This function calculates and prints the shortest path from the start task to all other tasks using Dijkstra's
+ * algorithm with an indexed heap. Graphs small enough for cachedTaskGraphDistances are answered from its cache.
  *
- * @param v Current vertex in DFS.
- * @param visited Array to track visited vertices.
- * @param Stack Stack to store the vertices by finish time.
- * @param graph Adjacency list of the graph.
+ * @param startVertex The id of the starting task.
+ * @param out Output stream for displaying the shortest paths.
  */
-void DFSUtilSCCs(int v, bool visited[], stack<int>& Stack, list<int>* graph) {
-	visited[v] = true;
+void calculateShortestPath(int startVertex, ostream& out) {
+	out << "Vertex\tDistance from Source\n";
+	int start = taskGraphIndex(taskGraph, startVertex);
+	if (start < 0) {
+		out << startVertex << "\t" << 0 << "\n";
+		return;
+	}
 
-	for (int i : graph[v]) {
-		if (!visited[i]) {
-			DFSUtilSCCs(i, visited, Stack, graph);
-		}
+	vector<int> dist;
+	const vector<int>* all = cachedTaskGraphDistances();
+	if (all) {
+		size_t V = taskGraph.ids.size();
+		dist.assign(all->begin() + start * V, all->begin() + (start + 1) * V);
 	}
-	Stack.push(v);
+	else {
+		dijkstraDistances(taskGraph, startVertex, &dist);
+	}
+	printDistances(taskGraph, dist, out);
 }
 
 /**
- * @brief Finds and prints all Strongly Connected Components (SCCs) in a graph.
- *
- * This function finds and prints all SCCs in a graph using Kosaraju's algorithm.
- *
- * @param V Number of vertices in the graph.
- * @param adjLists Adjacency list of the original graph.
- * @param out Output stream for displaying the SCCs.
+ * @brief Computes the distance from a task to every task with parallel delta-stepping.
+ *
+ * Vertices wait in buckets of distance width delta and the lowest non-empty bucket is settled at a time. Inside a
+ * bucket the light edges, of weight delta or less, are relaxed in parallel rounds until the bucket stops
+ * refilling, then the heavy edges of every vertex settled in it are relaxed once, also in parallel. Distances
+ * are lowered with an atomic compare-and-swap; each thread collects the vertices it improved and they are sorted
+ * into buckets between rounds. A small delta does little wasted work but needs many rounds, a large one needs
+ * few rounds but may relax a vertex several times. Edge weights must not be negative.
+ *
+ * @param graph The task graph.
+ * @param startTaskId The id of the starting task.
+ * @param threadCount Number of threads, or 0 to use one per hardware thread.
+ * @param delta Bucket width, or 0 to use the average edge weight.
+ * @param dist Receives the distance of each vertex index, INT_MAX for vertices that cannot be reached.
+ * @return int The number of tasks reached, including the starting task; 0 if it is not in the graph.
  */
-void findSCCs(int V, list<int>* adjLists, ostream& out) {
-	stack<int> Stack;
-
-	bool* visited = new bool[V];
-	memset(visited, 0, V * sizeof(bool));
-	for (int i = 0; i < V; ++i) {
-		if (!visited[i]) {
-			DFSUtilSCCs(i, visited, Stack, adjLists);
+int deltaSteppingDistances(const TaskGraph& graph, int startTaskId, int threadCount, int delta, vector<int>* dist) {
+	int V = (int)graph.ids.size();
+	dist->assign(V, INT_MAX);
+	int source = taskGraphIndex(graph, startTaskId);
+	if (source < 0) {
+		return 0;
+	}
+	threadCount = resolveThreadCount(threadCount);
+	if (delta <= 0) {
+		long long weightSum = 0;
+		for (size_t e = 0; e < graph.weights.size(); e++) {
+			weightSum += graph.weights[e];
 		}
+		delta = graph.weights.empty() ? 1 : (int)max(1LL, weightSum / (long long)graph.weights.size());
 	}
 
-	list<int>* transpose = new list<int>[V];
-	buildTranspose(V, adjLists, transpose);
-
-	memset(visited, 0, V * sizeof(bool));
-	int numSCC = 0;
-	while (!Stack.empty()) {
-		int v = Stack.top();
-		Stack.pop();
-
-		if (!visited[v]) {
-			stack<int> componentStack;
-			DFSUtilSCCs(v, visited, componentStack, transpose);
-			numSCC++;
-			out << "SCC #" << numSCC << ": ";
-			while (!componentStack.empty()) {
-				out << componentStack.top() << " ";
-				componentStack.pop();
+	vector<atomic<int>> distance(V);
+	for (int v = 0; v < V; v++) {
+		distance[v].store(INT_MAX, memory_order_relaxed);
+	}
+	distance[source].store(0, memory_order_relaxed);
+
+	map<int, vector<int>> buckets;
+	buckets[0].push_back(source);
+	vector<int> queuedRound(V, -1);
+	vector<int> settledBucket(V, -1);
+	vector<vector<int>> improved(threadCount);
+	int round = 0;
+
+	// Relaxes the light or the heavy edges of a list of vertices in parallel, collecting the improved vertices
+	auto relax = [&](const vector<int>& vertices, bool light, int bucket) -> vector<int> {
+		int workers = (int)min((size_t)threadCount, max((size_t)1, vertices.size() / 64));
+		size_t perThread = (vertices.size() + workers - 1) / workers;
+		runOnThreads(workers, [&](int t) {
+			size_t first = min(vertices.size(), t * perThread);
+			size_t last = min(vertices.size(), first + perThread);
+			for (size_t k = first; k < last; k++) {
+				int u = vertices[k];
+				int du = distance[u].load(memory_order_relaxed);
+				if (light && du / delta != bucket) {
+					continue;
+				}
+				for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+					int weight = graph.weights[e];
+					if ((weight <= delta) != light) {
+						continue;
+					}
+					int v = graph.targets[e];
+					int candidate = du + weight;
+					int current = distance[v].load(memory_order_relaxed);
+					while (candidate < current) {
+						if (distance[v].compare_exchange_weak(current, candidate, memory_order_relaxed)) {
+							improved[t].push_back(v);
+							break;
+						}
+					}
+				}
 			}
-			out << "\n";
+		});
+
+		// A vertex improved several times in this round is queued once, at its final distance
+		vector<int> next;
+		for (int t = 0; t < workers; t++) {
+			for (size_t k = 0; k < improved[t].size(); k++) {
+				int v = improved[t][k];
+				if (queuedRound[v] == round) {
+					continue;
+				}
+				queuedRound[v] = round;
+				int target = distance[v].load(memory_order_relaxed) / delta;
+				if (target == bucket) {
+					next.push_back(v);
+				}
+				else {
+					buckets[target].push_back(v);
+				}
+			}
+			improved[t].clear();
 		}
+		round++;
+		return next;
+	};
+
+	while (!buckets.empty()) {
+		int bucket = buckets.begin()->first;
+		vector<int> frontier;
+		frontier.swap(buckets.begin()->second);
+		buckets.erase(buckets.begin());
+
+		vector<int> settled;
+		while (!frontier.empty()) {
+			for (size_t k = 0; k < frontier.size(); k++) {
+				int u = frontier[k];
+				if (settledBucket[u] != bucket && distance[u].load(memory_order_relaxed) / delta == bucket) {
+					settledBucket[u] = bucket;
+					settled.push_back(u);
+				}
+			}
+			frontier = relax(frontier, true, bucket);
+		}
+
+		// Heavy edges lead past this bucket, so they never refill it
+		relax(settled, false, bucket);
 	}
 
-	delete[] visited;
-	delete[] transpose;
+	int reached = 0;
+	for (int v = 0; v < V; v++) {
+		(*dist)[v] = distance[v].load(memory_order_relaxed);
+		reached += (*dist)[v] != INT_MAX;
+	}
+	return reached;
 }
 
 /**
- * @brief Analyzes and prints Strongly Connected Components (SCCs) of tasks.
+ * @brief Calculates and prints the shortest path from the start vertex using parallel delta-stepping.
  *
- * This function loads tasks, builds the task graph, and finds SCCs.
+ * This function calculates and prints the shortest path from the start task to all other tasks using
+ * deltaSteppingDistances on one thread per hardware thread.
  *
- * @param pathFileTasks Path to the binary file containing tasks.
- * @param in Input stream for reading user input.
- * @param out Output stream for displaying the SCCs.
- * @return bool Returns true if SCCs are analyzed successfully, otherwise false.
+ * @param startVertex The id of the starting task.
+ * @param out Output stream for displaying the shortest paths.
  */
-bool analyzeSCC(const char* pathFileTasks, istream& in, ostream& out) {
-	clearScreen();
-	Task* tasks = nullptr;
-	int taskCount = loadOwnedTasks(pathFileTasks, &tasks, loggedUser.id);
-	loadTasksAndDependencies(pathFileTasks);
-
-	if (taskCount <= 0) {
-		out << "There is no task." << endl;
-		enterToContinue(in, out);
-		free(tasks);
-		return false;
+void calculateDeltaStepping(int startVertex, ostream& out) {
+	out << "Vertex\tDistance from Source\n";
+	vector<int> dist;
+	if (deltaSteppingDistances(taskGraph, startVertex, 0, 0, &dist) == 0) {
+		out << startVertex << "\t" << 0 << "\n";
+		return;
 	}
-
-	int V = taskCount;
-	findSCCs(V, adjLists, out);
-	enterToContinue(in, out);
-	return true;
+	printDistances(taskGraph, dist, out);
 }
 
 /**
- * @brief Adds an edge with a specified weight to the adjacency list.
- *
- * This function adds a directed edge with a specified weight to the adjacency list of the graph.
- *
- * @param u Source vertex of the edge.
- * @param v Destination vertex of the edge.
- * @param weight Weight of the edge.
+ * @brief Looks for a cycle among the parent pointers above a vertex.
+ *
+ * @param parent Parent of each vertex, -1 for the root and vertices not reached.
+ * @param v The vertex to walk up from.
+ * @param stamp Walk that last visited each vertex; updated.
+ * @param walk Number of this walk, distinct from every earlier one.
+ * @param depth Receives the number of parent steps to the root if there is no cycle.
+ * @return int A vertex on the cycle, or -1 if the walk reached the root.
  */
-void addEdgeWithWeight(int u, int v, int weight) {
-	adj[u].emplace_back(v, weight);
-	adj[v].emplace_back(u, weight);
+static int findParentCycle(const vector<int>& parent, int v, vector<int>& stamp, int walk, int* depth) {
+	int steps = 0;
+	while (v >= 0 && stamp[v] != walk) {
+		stamp[v] = walk;
+		v = parent[v];
+		steps++;
+	}
+	*depth = steps - 1;
+	return v;
 }
 
 /**
- * @brief Finds and prints the Minimum Spanning Tree (MST) using Prim's algorithm.
- *
- * This function finds and prints the MST of the graph starting from the given vertex using Prim's algorithm.
- *
- * @param startVertex The starting vertex for Prim's algorithm.
- * @param out Output stream for displaying the MST.
+ * @brief Computes the distance from a task to every task with a queue-based Bellman-Ford (SPFA).
+ *
+ * Only vertices whose distance dropped are queued to relax their edges again, so the search ends as soon as a
+ * round relaxes nothing instead of after V - 1 full passes. A negative cycle is caught on the parent pointers:
+ * they are walked when a vertex's path grows to V edges, and a vertex whose distance falls below the sum of all
+ * negative weights can only be reached through a cycle, so the search always ends.
+ *
+ * @param graph The task graph.
+ * @param startTaskId The id of the starting task.
+ * @param V Number of vertices of the task graph to consider, the first V in index order.
+ * @param dist Receives the distance of each of the V vertices, INT_MAX for vertices that cannot be reached.
+ * @param cycle Receives the task ids of a negative cycle in edge order if one is reachable, otherwise cleared.
+ * @return int The number of tasks reached, 0 if the starting task is not among the V vertices, or -1 if a
+ * negative cycle is reachable.
  */
-void primMST(int startVertex, ostream& out) {
-	int key[MAX_TASKS];
-	int parent[MAX_TASKS];
-	bool inMST[MAX_TASKS];
-
-	for (int i = 0; i < MAX_TASKS; i++) {
-		key[i] = INT_MAX;
-		parent[i] = -1;
-		inMST[i] = false;
+int bellmanFordDistances(const TaskGraph& graph, int startTaskId, int V, vector<int>* dist, vector<int>* cycle) {
+	V = min(max(V, 0), (int)graph.ids.size());
+	dist->assign(V, INT_MAX);
+	cycle->clear();
+	int start = taskGraphIndex(graph, startTaskId);
+	if (start < 0 || start >= V) {
+		return 0;
 	}
 
-	set<pair<int, int>> pq;
-	pq.insert(make_pair(0, startVertex));
-	key[startVertex] = 0;
-
-	while (!pq.empty()) {
-		int u = pq.begin()->second;
-		pq.erase(pq.begin());
+	long long lowerBound = 0;
+	for (int u = 0; u < V; u++) {
+		for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+			if (graph.targets[e] < V && graph.weights[e] < 0) {
+				lowerBound += graph.weights[e];
+			}
+		}
+	}
 
-		inMST[u] = true;
+	vector<long long> distance(V, LLONG_MAX);
+	vector<int> parent(V, -1);
+	vector<int> length(V, 0);
+	vector<char> queued(V, 0);
+	vector<int> stamp(V, -1);
+	int walks = 0;
+	deque<int> queue(1, start);
+	distance[start] = 0;
+	queued[start] = 1;
 
-		for (auto x : adj[u]) {
-			int v = x.first;
-			int weight = x.second;
+	while (!queue.empty()) {
+		int u = queue.front();
+		queue.pop_front();
+		queued[u] = 0;
 
-			if (!inMST[v] && key[v] > weight) {
-				if (key[v] != INT_MAX) {
-					pq.erase(pq.find(make_pair(key[v], v)));
+		for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+			int v = graph.targets[e];
+			if (v >= V || distance[u] + graph.weights[e] >= distance[v]) {
+				continue;
+			}
+			distance[v] = distance[u] + graph.weights[e];
+			parent[v] = u;
+			length[v] = length[u] + 1;
+
+			if (length[v] >= V || distance[v] < lowerBound) {
+				int depth;
+				int onCycle = findParentCycle(parent, v, stamp, walks++, &depth);
+				if (onCycle >= 0) {
+					for (int x = onCycle; cycle->empty() || x != onCycle; x = parent[x]) {
+						cycle->push_back(graph.ids[x]);
+					}
+					reverse(cycle->begin(), cycle->end());
+					return -1;
 				}
+				length[v] = depth;
+			}
 
-				key[v] = weight;
-				pq.insert(make_pair(key[v], v));
-				parent[v] = u;
+			if (!queued[v]) {
+				queued[v] = 1;
+				queue.push_back(v);
 			}
 		}
 	}
 
-	out << "Edge \tWeight\n";
-	for (int i = 1; i < MAX_TASKS; ++i) {
-		if (parent[i] != -1) {
-			out << parent[i] << " - " << i << "\t" << key[i] << " \n";
+	int reached = 0;
+	for (int v = 0; v < V; v++) {
+		if (distance[v] != LLONG_MAX) {
+			(*dist)[v] = (int)distance[v];
+			reached++;
 		}
 	}
+	return reached;
 }
 
 /**
- * @brief Compares two edges based on their weight.
+ * @brief Calculates and prints the shortest path from the start vertex using Bellman-Ford algorithm.
  *
- * This function compares two edges and returns true if the first edge has a smaller weight than the second edge.
+ * This function calculates and prints the shortest path from the start task to all other tasks using the
+ * queue-based Bellman-Ford of bellmanFordDistances. If a negative cycle is reachable its tasks are printed instead.
  *
- * @param a The first edge.
- * @param b The second edge.
- * @return bool Returns true if the first edge has a smaller weight, otherwise false.
+ * @param startVertex The id of the starting task.
+ * @param V Number of vertices of the task graph to consider.
+ * @param out Output stream for displaying the shortest paths.
  */
-bool compareEdges(const Edge& a, const Edge& b) {
-	return a.weight < b.weight;
+void calculateBellmanFord(int startVertex, int V, ostream& out) {
+	vector<int> dist;
+	vector<int> cycle;
+	int reached = bellmanFordDistances(taskGraph, startVertex, V, &dist, &cycle);
+
+	if (reached < 0) {
+		out << "Graph contains negative weight cycle:";
+		for (size_t i = 0; i < cycle.size(); i++) {
+			out << " " << cycle[i] << " ->";
+		}
+		out << " " << cycle[0] << endl;
+		return;
+	}
+
+	out << "Vertex\tDistance from Source\n";
+	if (reached == 0) {
+		out << startVertex << "\t" << 0 << "\n";
+		return;
+	}
+	printDistances(taskGraph, dist, out);
 }
 
 /**
- * @brief Finds the root of a set in the union-find data structure.
- *
- * This function finds the root of the set containing the given element.
- *
- * @param parent The array representing the union-find data structure.
- * @param i The element whose root is to be found.
- * @return int The root of the set containing the element.
+ * @brief Distance standing for "no path" inside the all-pairs matrix; twice it still fits in an int.
  */
-int find(int parent[], int i) {
-	if (parent[i] == -1) {
-		return i;
-	}
-	return find(parent, parent[i]);
-}
+static const int DISTANCE_INFINITY = INT_MAX / 2;
 
 /**
- * @brief Unites two sets in the union-find data structure.
- *
- * This function unites the sets containing the two given elements.
+ * @brief Tile width of the blocked Floyd-Warshall, 64 x 64 distances or 16 KB per tile.
+ */
+static const int FLOYD_WARSHALL_TILE = 64;
+
+/**
+ * @brief Lowers each distance of a row to a path through one vertex: row[j] = min(row[j], through + via[j]).
  *
- * @param parent The array representing the union-find data structure.
- * @param x The first element.
- * @param y The second element.
+ * @param row Distances from a vertex i.
+ * @param via Distances from the intermediate vertex k.
+ * @param through Distance from i to k.
+ * @param count Number of distances.
  */
-void unionSets(int parent[], int x, int y) {
-	int xset = find(parent, x);
-	int yset = find(parent, y);
-	if (xset != yset) {
-		parent[xset] = yset;
+static inline void minPlusRow(int* row, const int* via, int through, int count) {
+	for (int j = 0; j < count; j++) {
+		row[j] = min(row[j], through + via[j]);
 	}
 }
 
 /**
- * @brief Finds and prints the Minimum Spanning Tree (MST) using Kruskal's algorithm.
- *
- * This function finds and prints the MST of the graph using Kruskal's algorithm.
- *
- * @param V Number of vertices in the graph.
- * @param out Output stream for displaying the MST.
+ * @brief Relaxes one tile of the distance matrix through the intermediate vertices of another.
+ *
+ * With throughOwn set the intermediate vertex is the outer loop, so a tile may be relaxed through vertices
+ * whose distances it changes itself. Otherwise the distances through the intermediate vertices must already be
+ * final; each row is then relaxed through all of them in turn while it stays in cache.
+ *
+ * @param dist The n x n distance matrix, row by row.
+ * @param n Number of vertices.
+ * @param i0 First row of the tile.
+ * @param j0 First column of the tile.
+ * @param k0 First intermediate vertex.
+ * @param throughOwn True if the tile holds distances from or to the intermediate vertices.
  */
-void kruskalMST(int V, ostream& out) {
-	Edge edges[MAX_TASKS * MAX_TASKS];
-	int edgeCount = 0;
-
-	for (int u = 0; u < V; u++) {
-		for (list<pair<int, int>>::iterator it = adj[u].begin(); it != adj[u].end(); ++it) {
-			edges[edgeCount++] = { u, it->first, it->second };
+static void floydWarshallTile(int* dist, int n, int i0, int j0, int k0, bool throughOwn) {
+	int i1 = min(n, i0 + FLOYD_WARSHALL_TILE);
+	int j1 = min(n, j0 + FLOYD_WARSHALL_TILE);
+	int k1 = min(n, k0 + FLOYD_WARSHALL_TILE);
+
+	if (throughOwn) {
+		for (int k = k0; k < k1; k++) {
+			for (int i = i0; i < i1; i++) {
+				int through = dist[(size_t)i * n + k];
+				if (through < DISTANCE_INFINITY) {
+					minPlusRow(dist + (size_t)i * n + j0, dist + (size_t)k * n + j0, through, j1 - j0);
+				}
+			}
 		}
+		return;
 	}
 
-	for (int i = 0; i < edgeCount - 1; i++) {
-		for (int j = 0; j < edgeCount - i - 1; j++) {
-			if (compareEdges(edges[j + 1], edges[j])) {
-				Edge temp = edges[j];
-				edges[j] = edges[j + 1];
-				edges[j + 1] = temp;
+	for (int i = i0; i < i1; i++) {
+		int* row = dist + (size_t)i * n;
+		for (int k = k0; k < k1; k++) {
+			if (row[k] < DISTANCE_INFINITY) {
+				minPlusRow(row + j0, dist + (size_t)k * n + j0, row[k], j1 - j0);
 			}
 		}
 	}
+}
 
-	Edge result[MAX_TASKS];
-	int resultIndex = 0;
-	int parent[MAX_TASKS];
-	memset(parent, -1, sizeof(parent));
-
-	for (int i = 0; i < edgeCount; i++) {
-		int x = find(parent, edges[i].src);
-		int y = find(parent, edges[i].dest);
-
-		if (x != y) {
-			result[resultIndex++] = edges[i];
-			unionSets(parent, x, y);
-		}
+#if TASKSCHEDULER_AVX2
+/**
+ * @brief floydWarshallTile with AVX2; a full row of a tile is relaxed in eight registers.
+ */
+__attribute__((target("avx2"))) static void floydWarshallTileAvx2(int* dist, int n, int i0, int j0, int k0, bool throughOwn) {
+	if (throughOwn || n - j0 < FLOYD_WARSHALL_TILE) {
+		floydWarshallTile(dist, n, i0, j0, k0, throughOwn);
+		return;
 	}
-
-	out << "Edge \tWeight\n";
-	for (int i = 0; i < resultIndex; i++) {
-		out << result[i].src << " - " << result[i].dest << "\t" << result[i].weight << " \n";
+	int i1 = min(n, i0 + FLOYD_WARSHALL_TILE);
+	int k1 = min(n, k0 + FLOYD_WARSHALL_TILE);
+
+	for (int i = i0; i < i1; i++) {
+		int* row = dist + (size_t)i * n;
+		__m256i best[FLOYD_WARSHALL_TILE / 8];
+		for (int v = 0; v < FLOYD_WARSHALL_TILE / 8; v++) {
+			best[v] = _mm256_loadu_si256((const __m256i*)(row + j0) + v);
+		}
+		for (int k = k0; k < k1; k++) {
+			if (row[k] >= DISTANCE_INFINITY) {
+				continue;
+			}
+			__m256i through = _mm256_set1_epi32(row[k]);
+			const __m256i* via = (const __m256i*)(dist + (size_t)k * n + j0);
+			for (int v = 0; v < FLOYD_WARSHALL_TILE / 8; v++) {
+				best[v] = _mm256_min_epi32(best[v], _mm256_add_epi32(through, _mm256_loadu_si256(via + v)));
+			}
+		}
+		for (int v = 0; v < FLOYD_WARSHALL_TILE / 8; v++) {
+			_mm256_storeu_si256((__m256i*)(row + j0) + v, best[v]);
+		}
 	}
 }
+#endif
 
 /**
- * @brief Calculates and prints the shortest path from the start vertex using Dijkstra's algorithm.
- *
- * This function calculates and prints the shortest path from the start vertex to all other vertices using Dijkstra's algorithm.
- *
- * @param startVertex The starting vertex.
- * @param out Output stream for displaying the shortest paths.
+ * @brief Computes all-pairs distances of a task graph with a cache-blocked Floyd-Warshall.
+ *
+ * The matrix is processed in FLOYD_WARSHALL_TILE tiles: for each block of intermediate vertices the diagonal
+ * tile goes first, then the tiles in its row and column, then all the others, which only read those and are
+ * split among threads. Every step works on three tiles that stay in cache, and the innermost min-plus runs
+ * over a contiguous row, with AVX2 where the processor has it. Graphs with more than
+ * DISTANCE_CACHE_MAX_VERTICES vertices, negative weights, or paths that could reach DISTANCE_INFINITY are
+ * refused.
+ *
+ * @param graph The task graph.
+ * @param threadCount Number of threads, or 0 to use one per hardware thread.
+ * @param dist Receives the V x V distances row by row, INT_MAX where there is no path.
+ * @return bool Returns true if the distances were computed, otherwise false.
  */
-void calculateShortestPath(int startVertex, ostream& out) {
-	int dist[MAX_TASKS];
-	bool sptSet[MAX_TASKS];
-
-	for (int i = 0; i < MAX_TASKS; i++) {
-		dist[i] = INT_MAX;
-		sptSet[i] = false;
+bool allPairsDistances(const TaskGraph& graph, int threadCount, vector<int>* dist) {
+	int n = (int)graph.ids.size();
+	if (n > DISTANCE_CACHE_MAX_VERTICES) {
+		return false;
 	}
 
-	dist[startVertex] = 0;
-
-	for (int count = 0; count < MAX_TASKS - 1; count++) {
-		int u = -1;
-
-		for (int i = 0; i < MAX_TASKS; i++) {
-			if (!sptSet[i] && (u == -1 || dist[i] < dist[u])) {
-				u = i;
+	// A shortest path leaves each vertex at most once, so the heaviest edge of every vertex bounds its length
+	long long longest = 0;
+	for (int u = 0; u < n; u++) {
+		int heaviest = 0;
+		for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+			if (graph.weights[e] < 0) {
+				return false;
 			}
+			heaviest = max(heaviest, graph.weights[e]);
 		}
+		longest += heaviest;
+	}
+	if (longest >= DISTANCE_INFINITY) {
+		return false;
+	}
 
-		if (u == -1 || dist[u] == INT_MAX) {
-			break;
+	dist->assign((size_t)n * n, DISTANCE_INFINITY);
+	int* d = dist->data();
+	for (int u = 0; u < n; u++) {
+		d[(size_t)u * n + u] = 0;
+		for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+			int& edge = d[(size_t)u * n + graph.targets[e]];
+			edge = min(edge, graph.weights[e]);
 		}
+	}
 
-		sptSet[u] = true;
-
-		for (const auto& adjPair : adj[u]) {
-			int v = adjPair.first;
-			int weight = adjPair.second;
-
-			if (!sptSet[v] && dist[u] != INT_MAX && dist[u] + weight < dist[v]) {
-				dist[v] = dist[u] + weight;
+#if TASKSCHEDULER_AVX2
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+	void (*relaxTile)(int*, int, int, int, int, bool) = avx2 ? floydWarshallTileAvx2 : floydWarshallTile;
+#else
+	void (*relaxTile)(int*, int, int, int, int, bool) = floydWarshallTile;
+#endif
+	int tiles = (n + FLOYD_WARSHALL_TILE - 1) / FLOYD_WARSHALL_TILE;
+	int workers = max(1, min(resolveThreadCount(threadCount), tiles - 1));
+	for (int kt = 0; kt < tiles; kt++) {
+		int k0 = kt * FLOYD_WARSHALL_TILE;
+		relaxTile(d, n, k0, k0, k0, true);
+		for (int t = 0; t < tiles; t++) {
+			if (t != kt) {
+				relaxTile(d, n, k0, t * FLOYD_WARSHALL_TILE, k0, true);
+				relaxTile(d, n, t * FLOYD_WARSHALL_TILE, k0, k0, false);
 			}
 		}
+		runOnThreads(workers, [&](int w) {
+			for (int it = w; it < tiles; it += workers) {
+				for (int jt = 0; jt < tiles && it != kt; jt++) {
+					if (jt != kt) {
+						relaxTile(d, n, it * FLOYD_WARSHALL_TILE, jt * FLOYD_WARSHALL_TILE, k0, false);
+					}
+				}
+			}
+		});
 	}
 
-	out << "Vertex\tDistance from Source\n";
-	for (int i = 0; i < MAX_TASKS; i++) {
-		if (dist[i] != INT_MAX) {
-			out << i << "\t" << dist[i] << "\n";
+	for (size_t i = 0; i < dist->size(); i++) {
+		if (d[i] >= DISTANCE_INFINITY) {
+			d[i] = INT_MAX;
 		}
 	}
+	return true;
 }
 
 /**
- * @brief Calculates and prints the shortest path from the start vertex using Bellman-Ford algorithm.
- *
- * This function calculates and prints the shortest path from the start vertex to all other vertices using the Bellman-Ford algorithm.
+ * @brief Computes a checksum of a task graph's vertices and edges (FNV-1a, 64 bits).
  *
- * @param startVertex The starting vertex.
- * @param V Number of vertices in the graph.
- * @param out Output stream for displaying the shortest paths.
+ * @param graph The task graph.
+ * @return uint64_t The checksum.
  */
-void calculateBellmanFord(int startVertex, int V, ostream& out) {
-	int dist[MAX_TASKS];
-
-	for (int i = 0; i < V; i++) {
-		dist[i] = INT_MAX;
-	}
-
-	dist[startVertex] = 0;
-
-	for (int i = 1; i <= V - 1; i++) {
-		for (int u = 0; u < V; u++) {
-			for (auto adjPair : adj[u]) {
-				int v = adjPair.first;
-				int weight = adjPair.second;
-				if (dist[u] != INT_MAX && dist[u] + weight < dist[v]) {
-					dist[v] = dist[u] + weight;
-				}
+static uint64_t taskGraphChecksum(const TaskGraph& graph) {
+	uint64_t hash = 14695981039346656037ULL;
+	const vector<int>* parts[] = { &graph.ids, &graph.offsets, &graph.targets, &graph.weights };
+	for (const vector<int>* part : parts) {
+		for (size_t i = 0; i < part->size(); i++) {
+			uint32_t value = (uint32_t)(*part)[i];
+			for (int b = 0; b < 4; b++) {
+				hash = (hash ^ ((value >> (8 * b)) & 0xff)) * 1099511628211ULL;
 			}
 		}
+		hash = (hash ^ 0xff) * 1099511628211ULL;
 	}
+	return hash;
+}
 
-	for (int u = 0; u < V; u++) {
-		for (auto adjPair : adj[u]) {
-			int v = adjPair.first;
-			int weight = adjPair.second;
-			if (dist[u] != INT_MAX && dist[u] + weight < dist[v]) {
-				out << "Graph contains negative weight cycle" << endl;
-				return;
-			}
+/**
+ * @brief Header of a saved distance cache file; the fields are written one by one, without padding.
+ */
+struct DistanceCacheHeader {
+	char magic[4];          /**< DISTANCE_CACHE_MAGIC */
+	uint32_t version;       /**< DISTANCE_CACHE_VERSION */
+	uint32_t intSize;       /**< sizeof(int) of the writer */
+	uint32_t byteOrder;     /**< 0x01020304 as the writer stores it */
+	uint64_t checksum;      /**< taskGraphChecksum of the graph */
+	int32_t vertexCount;    /**< Number of vertices, the matrix has vertexCount^2 entries */
+};
+
+/**
+ * @brief Reads a distance cache header and checks that it was written by this layout on a compatible machine.
+ *
+ * @param file File positioned at the start of the header.
+ * @param header Receives the header.
+ * @return bool Returns true if the header was read and its magic, version, int size and byte order match.
+ */
+static bool readDistanceCacheHeader(FILE* file, DistanceCacheHeader* header) {
+	return fread(header->magic, sizeof(header->magic), 1, file) == 1
+		&& fread(&header->version, sizeof(header->version), 1, file) == 1
+		&& fread(&header->intSize, sizeof(header->intSize), 1, file) == 1
+		&& fread(&header->byteOrder, sizeof(header->byteOrder), 1, file) == 1
+		&& fread(&header->checksum, sizeof(header->checksum), 1, file) == 1
+		&& fread(&header->vertexCount, sizeof(header->vertexCount), 1, file) == 1
+		&& memcmp(header->magic, DISTANCE_CACHE_MAGIC, sizeof(header->magic)) == 0
+		&& header->version == DISTANCE_CACHE_VERSION
+		&& header->intSize == sizeof(int)
+		&& header->byteOrder == 0x01020304u;
+}
+
+/**
+ * @brief Writes a distance cache header for a graph.
+ *
+ * @param file File positioned at the start of the header.
+ * @param checksum taskGraphChecksum of the graph.
+ * @param vertexCount Number of vertices of the graph.
+ * @return bool Returns true if the header was written.
+ */
+static bool writeDistanceCacheHeader(FILE* file, uint64_t checksum, int32_t vertexCount) {
+	uint32_t version = DISTANCE_CACHE_VERSION;
+	uint32_t intSize = sizeof(int);
+	uint32_t byteOrder = 0x01020304u;
+	return fwrite(DISTANCE_CACHE_MAGIC, sizeof(DISTANCE_CACHE_MAGIC), 1, file) == 1
+		&& fwrite(&version, sizeof(version), 1, file) == 1
+		&& fwrite(&intSize, sizeof(intSize), 1, file) == 1
+		&& fwrite(&byteOrder, sizeof(byteOrder), 1, file) == 1
+		&& fwrite(&checksum, sizeof(checksum), 1, file) == 1
+		&& fwrite(&vertexCount, sizeof(vertexCount), 1, file) == 1;
+}
+
+/**
+ * @brief Returns the all-pairs distances of taskGraph, computing them at most once per graph generation.
+ *
+ * The distances are also saved next to the task file taskGraph was loaded from, behind a DistanceCacheHeader. A
+ * later run on an unchanged file reads them back instead of computing them; a file with another layout, int size,
+ * byte order or graph is ignored and replaced.
+ *
+ * @return const vector<int>* The V x V distances row by row, INT_MAX where there is no path, or nullptr if
+ * allPairsDistances refuses the graph.
+ */
+const vector<int>* cachedTaskGraphDistances() {
+	if (taskGraphDistanceGeneration != 0 && taskGraphDistanceGeneration == taskGraph.generation) {
+		return &taskGraphDistanceCache;
+	}
+	taskGraphDistanceGeneration = 0;
+
+	int n = (int)taskGraph.ids.size();
+	uint64_t checksum = taskGraphChecksum(taskGraph);
+	string path = taskGraphPath.empty() ? string() : taskGraphPath + ".dist";
+
+	FILE* file = path.empty() ? nullptr : fopen(path.c_str(), "rb");
+	if (file) {
+		DistanceCacheHeader header;
+		bool loaded = readDistanceCacheHeader(file, &header) && header.checksum == checksum && header.vertexCount == n;
+		if (loaded) {
+			taskGraphDistanceCache.resize((size_t)n * n);
+			loaded = fread(taskGraphDistanceCache.data(), sizeof(int), taskGraphDistanceCache.size(), file) == taskGraphDistanceCache.size();
+		}
+		fclose(file);
+		if (loaded) {
+			taskGraphDistanceGeneration = taskGraph.generation;
+			return &taskGraphDistanceCache;
 		}
 	}
 
-	out << "Vertex\tDistance from Source\n";
-	for (int i = 0; i < V; i++) {
-		if (dist[i] != INT_MAX) {
-			out << i << "\t" << dist[i] << "\n";
+	if (!allPairsDistances(taskGraph, 0, &taskGraphDistanceCache)) {
+		taskGraphDistanceCache.clear();
+		return nullptr;
+	}
+	taskGraphDistanceGeneration = taskGraph.generation;
+
+	file = path.empty() ? nullptr : fopen(path.c_str(), "wb");
+	if (file) {
+		bool saved = writeDistanceCacheHeader(file, checksum, n)
+			&& fwrite(taskGraphDistanceCache.data(), sizeof(int), taskGraphDistanceCache.size(), file) == taskGraphDistanceCache.size();
+		if (fclose(file) != 0 || !saved) {
+			remove(path.c_str());
 		}
 	}
+	return &taskGraphDistanceCache;
 }
 
 /**
@@ -2260,26 +5414,164 @@ int fordFulkerson(int** graph, int source, int sink, int V) {
 	return maxFlow;
 }
 
-/*
+/**
+ * @brief Returns the expanded AES key used for record encryption.
+ *
+ * The key is expanded once on first use and the handle is reused by every later call, so
+ * encrypting many records does not repeat the key expansion.
+ *
+ * @return const AES_key* The shared key handle.
+ */
+static const struct AES_key* recordKey() {
+	static struct AES_key key;
+	static const int ready = AES_key_init(&key, AES_KEY, sizeof(AES_KEY));
+	(void)ready;
+	return &key;
+}
+
+/**
+ * @brief Encrypts data in place with AES-CBC.
+ *
+ * @param data The data to encrypt.
+ * @param length Length of the data in bytes, a multiple of AES_BLOCKLEN.
+ */
 void encryptData(uint8_t* data, size_t length) {
-	struct AES_ctx ctx;
-	AES_init_ctx_iv(&ctx, AES_KEY, AES_IV);
-	AES_CBC_encrypt_buffer(&ctx, data, length);
+	uint8_t iv[AES_BLOCKLEN];
+	memcpy(iv, AES_IV, sizeof(iv));
+	AES_CBC_encrypt_buffer_key(recordKey(), iv, data, length);
 }
 
+/**
+ * @brief Decrypts data in place that was encrypted with encryptData.
+ *
+ * @param data The data to decrypt.
+ * @param length Length of the data in bytes, a multiple of AES_BLOCKLEN.
+ */
 void decryptData(uint8_t* data, size_t length) {
-	struct AES_ctx ctx;
-	AES_init_ctx_iv(&ctx, AES_KEY, AES_IV);
-	AES_CBC_decrypt_buffer(&ctx, data, length);
+	uint8_t iv[AES_BLOCKLEN];
+	memcpy(iv, AES_IV, sizeof(iv));
+	AES_CBC_decrypt_buffer_key(recordKey(), iv, data, length);
 }
 
-*/
 
 //Algorithms
 
 
 //LOGIN REGISTER
 
+/**
+ * @brief Encrypts an email with AES-SIV.
+ *
+ * The encryption is deterministic, so the same email always gives the same ciphertext and the ciphertext can be
+ * used as a lookup key without ever storing the plain email in the index.
+ *
+ * @param email The email, a null terminated string.
+ * @param out Receives the ciphertext, room for strlen(email) + AES_SIV_IVLEN bytes.
+ * @return size_t Length of the ciphertext in bytes.
+ */
+size_t encryptEmail(const char* email, uint8_t* out) {
+	static struct AES_SIV_ctx ctx;
+	static const int ready = AES_SIV_init_ctx(&ctx, EMAIL_KEY, sizeof(EMAIL_KEY));
+	(void)ready;
+	size_t length = strlen(email);
+	AES_SIV_encrypt(&ctx, nullptr, 0, reinterpret_cast<const uint8_t*>(email), length, out);
+	return length + AES_SIV_IVLEN;
+}
+
+/**
+ * @brief Returns the login index key of an email.
+ *
+ * @param email The email, a null terminated string.
+ * @return string The encrypted email.
+ */
+static string emailIndexKey(const char* email) {
+	vector<uint8_t> cipher(strlen(email) + AES_SIV_IVLEN);
+	size_t length = encryptEmail(email, cipher.data());
+	return string(reinterpret_cast<const char*>(cipher.data()), length);
+}
+
+/**
+ * @brief Rebuilds the login index from the user file.
+ *
+ * Users whose tag does not verify are left out. If an email appears more than once the first user keeps it.
+ *
+ * @param file The user file in the current layout, opened for reading.
+ * @param pathFileUsers Path to the binary file containing user data.
+ */
+static void buildUserIndex(istream& file, const char* pathFileUsers) {
+	userIndex.clear();
+	userIndexPath = pathFileUsers;
+	if (!fileStamp(pathFileUsers, &userIndexFileSize, &userIndexFileTime)) {
+		userIndexFileSize = -1;
+		userIndexFileTime = -1;
+	}
+
+	int userCount = 0;
+	file.clear();
+	file.seekg(sizeof(RecordFileHeader), ios::beg);
+	file.read(reinterpret_cast<char*>(&userCount), sizeof(int));
+
+	User user;
+	for (int i = 0; i < userCount && file.read(reinterpret_cast<char*>(&user), sizeof(User)); i++) {
+		user.email[sizeof(user.email) - 1] = '\0';
+		if (verifyUser(&user)) {
+			userIndex.emplace(emailIndexKey(user.email), i);
+		}
+	}
+}
+
+/**
+ * @brief Finds a user by email through the login index.
+ *
+ * A hit costs one index lookup and one record read. The index is rebuilt when it belongs to another file, when the
+ * file's size or modification time changed since it was built, or when the record it points to no longer holds the
+ * email. A miss on an index that matches the file is final, so an unknown email costs no scan of the file.
+ *
+ * @param pathFileUsers Path to the binary file containing user data.
+ * @param email The email to look for.
+ * @param user Receives the user.
+ * @return bool Returns true if a user with the email exists and its tag verifies, otherwise false.
+ */
+bool findUserByEmail(const char* pathFileUsers, const char* email, User* user) {
+	ifstream file(pathFileUsers, ios::binary);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	string key = emailIndexKey(email);
+	long long fileSize = -1;
+	long long fileTime = -1;
+	fileStamp(pathFileUsers, &fileSize, &fileTime);
+	bool rebuilt = false;
+	if (userIndexPath != pathFileUsers || fileSize != userIndexFileSize || fileTime != userIndexFileTime) {
+		file.close();
+		if (openUsersFile(file, pathFileUsers) == RECORD_FILE_UNSUPPORTED || !file.is_open()) {
+			userIndex.clear();
+			userIndexPath.clear();
+			return false;
+		}
+		buildUserIndex(file, pathFileUsers);
+		rebuilt = true;
+	}
+
+	while (true) {
+		unordered_map<string, int>::const_iterator it = userIndex.find(key);
+		if (it == userIndex.end()) {
+			return false;
+		}
+		file.clear();
+		file.seekg(sizeof(RecordFileHeader) + sizeof(int) + (streamoff)it->second * sizeof(User), ios::beg);
+		if (file.read(reinterpret_cast<char*>(user), sizeof(User)) && verifyUser(user) && strncmp(user->email, email, sizeof(user->email)) == 0) {
+			return true;
+		}
+		if (rebuilt) {
+			return false;
+		}
+		buildUserIndex(file, pathFileUsers);
+		rebuilt = true;
+	}
+}
+
 /**
  * @brief Logs in a user by verifying email and password.
  *
@@ -2292,7 +5584,12 @@ void decryptData(uint8_t* data, size_t length) {
  * @return int Returns 1 if login is successful, otherwise 0.
  */
 int loginUser(User loginUser, const char* pathFileUsers, istream& in, ostream& out) {
-	ifstream file(pathFileUsers, ios::binary);
+	ifstream file;
+	if (openUsersFile(file, pathFileUsers) == RECORD_FILE_UNSUPPORTED) {
+		out << "The user file is not in a record format this version can read." << endl;
+		enterToContinue(in, out);
+		return 0;
+	}
 	if (!file.is_open()) {
 		out << "Failed to open user file." << endl;
 		return 0;
@@ -2300,27 +5597,22 @@ int loginUser(User loginUser, const char* pathFileUsers, istream& in, ostream& o
 
 	int userCount = 0;
 	file.read(reinterpret_cast<char*>(&userCount), sizeof(int));
+	file.close();
 	if (userCount == 0) {
 		out << "No users registered." << endl;
-		file.close();
 		enterToContinue(in, out);
 		return 0;
 	}
 
 	User userFromFile;
-	for (int i = 0; i < userCount; i++) {
-		file.read(reinterpret_cast<char*>(&userFromFile), sizeof(User));
-		if (strcmp(userFromFile.email, loginUser.email) == 0 && strcmp(userFromFile.password, loginUser.password) == 0) {
-			out << "Login successful. Welcome " << endl;
-			file.close();
-			enterToContinue(in, out);
-			loggedUser = userFromFile;
-			return 1;
-		}
+	if (findUserByEmail(pathFileUsers, loginUser.email, &userFromFile) && strcmp(userFromFile.password, loginUser.password) == 0) {
+		out << "Login successful. Welcome " << endl;
+		enterToContinue(in, out);
+		loggedUser = userFromFile;
+		return 1;
 	}
 
 	out << "Incorrect email or password." << endl;
-	file.close();
 	enterToContinue(in, out);
 	return 0;
 }
@@ -2360,7 +5652,12 @@ int loginUserMenu(const char* pathFileUsers, istream& in, ostream& out) {
  * @return int Returns 1 if registration is successful, otherwise 0.
  */
 int registerUser(User user, const char* pathFileUser, istream& in, ostream& out) {
-	fstream file(pathFileUser, ios::binary | ios::in | ios::out);
+	ifstream file;
+	if (openUsersFile(file, pathFileUser) == RECORD_FILE_UNSUPPORTED) {
+		out << "The user file is not in a record format this version can read." << endl;
+		enterToContinue(in, out);
+		return 0;
+	}
 	int userCount = 0;
 	User* users = nullptr;
 
@@ -2380,13 +5677,11 @@ int registerUser(User user, const char* pathFileUser, istream& in, ostream& out)
 				}
 			}
 		}
-		file.seekg(0, ios::beg);
-	}
-	else {
-		file.open(pathFileUser, ios::binary | ios::out);
+		file.close();
 	}
 
 	user.id = getNewUserId(users, userCount);
+	tagUser(&user);
 	userCount++;
 	User* updatedUsers = new User[userCount];
 	if (users) {
@@ -2395,13 +5690,16 @@ int registerUser(User user, const char* pathFileUser, istream& in, ostream& out)
 	}
 	updatedUsers[userCount - 1] = user;
 
-	file.write(reinterpret_cast<const char*>(&userCount), sizeof(int));
-	file.write(reinterpret_cast<const char*>(updatedUsers), sizeof(User) * userCount);
+	bool saved = saveUsers(pathFileUser, updatedUsers, userCount);
+	delete[] updatedUsers;
+	userIndexPath.clear();
+	if (!saved) {
+		out << "Failed to write user file." << endl;
+		enterToContinue(in, out);
+		return 0;
+	}
 
 	out << "User registered successfully " << endl;
-
-	delete[] updatedUsers;
-	file.close();
 	enterToContinue(in, out);
 	return 1;
 }
@@ -2545,6 +5843,7 @@ int userOperations(istream& in, ostream& out) {
  * @brief Handles the main menu.
  *
  * This function displays the main menu, processes user input, and performs actions based on the user's choice.
+ * User and task files from before records were tagged are converted first.
  *
  * @param in Input stream for reading user input.
  * @param out Output stream for displaying the menu and messages.
@@ -2552,6 +5851,7 @@ int userOperations(istream& in, ostream& out) {
  */
 int mainMenu(istream& in, ostream& out) {
 	int choice;
+	upgradeRecordFiles(pathFileUsers, pathFileTasks, out);
 
 	while (true) {
 		printMainMenu(out);
@@ -8,7 +8,13 @@
 //
 // CBC enables AES encryption in CBC-mode of operation.
 // CTR enables encryption in counter-mode.
-// ECB enables the basic ECB 16-byte block algorithm. All can be enabled simultaneously.
+// ECB enables the basic ECB 16-byte block algorithm.
+// GCM enables authenticated encryption in Galois/Counter mode.
+// XTS enables the IEEE 1619 tweakable mode for fixed-size records.
+// CMAC enables the NIST SP 800-38B message authentication code.
+// SIV enables deterministic authenticated encryption (RFC 5297), built on CMAC and CTR.
+// DRBG enables the NIST SP 800-90A CTR_DRBG random generator, built on CTR.
+// All can be enabled simultaneously.
 
 // The #ifndef-guard allows it to be configured before #include'ing or at compile time.
 #ifndef CBC
@@ -23,7 +29,42 @@
   #define CTR 1
 #endif
 
+#ifndef GCM
+  #define GCM 1
+#endif
+
+#ifndef XTS
+  #define XTS 1
+#endif
+
+#ifndef CMAC
+  #define CMAC 1
+#endif
+
+#ifndef SIV
+  #define SIV 1
+#endif
+
+#ifndef DRBG
+  #define DRBG 1
+#endif
+
+// GCM_CLMUL lets GHASH use the PCLMULQDQ carry-less multiply on x86 CPUs that support it.
+// The choice is made at runtime; the table-driven GHASH is used everywhere else.
+#ifndef GCM_CLMUL
+  #define GCM_CLMUL 1
+#endif
 
+// AES_NI lets CTR and the multi-buffer *_jobs functions use the AES-NI instructions on x86 CPUs
+// that support them. The choice is made at runtime; the portable Cipher is used everywhere else.
+#ifndef AES_NI
+  #define AES_NI 1
+#endif
+
+
+// The macros below only pick the default key size used by AES_init_ctx() and the other
+// init functions without a key length. Every context carries its own key size, so
+// AES-128, AES-192 and AES-256 keys can be mixed in one binary through the *_keylen functions.
 #define AES128 1
 //#define AES192 1
 //#define AES256 1
@@ -32,35 +73,108 @@
 
 #if defined(AES256) && (AES256 == 1)
     #define AES_KEYLEN 32
-    #define AES_keyExpSize 240
 #elif defined(AES192) && (AES192 == 1)
     #define AES_KEYLEN 24
-    #define AES_keyExpSize 208
 #else
-    #define AES_KEYLEN 16   // Key length in bytes
-    #define AES_keyExpSize 176
+    #define AES_KEYLEN 16   // Default key length in bytes
 #endif
 
+#define AES_keyExpSize 240  // Room for the largest (AES-256) key schedule
+
 struct AES_ctx
 {
   uint8_t RoundKey[AES_keyExpSize];
 #if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
   uint8_t Iv[AES_BLOCKLEN];
 #endif
+  uint8_t Nr;  // Number of rounds: 10, 12 or 14 for 16, 24 or 32 byte keys
 };
 
 void AES_init_ctx(struct AES_ctx* ctx, const uint8_t* key);
+// keyLen is 16, 24 or 32 bytes; returns 0 (and leaves ctx untouched) for any other length.
+int AES_init_ctx_keylen(struct AES_ctx* ctx, const uint8_t* key, size_t keyLen);
 #if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
 void AES_init_ctx_iv(struct AES_ctx* ctx, const uint8_t* key, const uint8_t* iv);
+int AES_init_ctx_iv_keylen(struct AES_ctx* ctx, const uint8_t* key, size_t keyLen, const uint8_t* iv);
 void AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv);
 #endif
 
+// Key handles: a key is expanded once by AES_key_init() and the handle is then reused for any
+// number of operations. The handle also holds the decryption key schedule, precomputed for the
+// equivalent inverse cipher, so decryption does not pay for the expansion either.
+// The *_key functions take the handle as const and the IV / counter as a separate argument, so
+// one handle can be shared by several threads as long as each uses its own IV buffer.
+struct AES_key
+{
+  uint8_t RoundKey[AES_keyExpSize];
+#if (defined(CBC) && (CBC == 1)) || (defined(ECB) && (ECB == 1))
+  uint8_t DecRoundKey[AES_keyExpSize];
+#endif
+  uint8_t Nr;
+};
+
+// keyLen is 16, 24 or 32 bytes; returns 0 for any other length.
+int AES_key_init(struct AES_key* handle, const uint8_t* key, size_t keyLen);
+// Loads an expanded key into a context (e.g. for the CBC stream or GCM) without expanding it again.
+void AES_ctx_set_key(struct AES_ctx* ctx, const struct AES_key* handle);
+
+// A small LRU cache of key handles for code that sees many records under a few keys (per user,
+// per file) and only has the raw key bytes at hand.
+// AES_key_cache_get returns the cached handle, expanding the key into the least recently used slot
+// on a miss, or NULL for an invalid key length. The handle stays valid until its slot is evicted,
+// i.e. for at least the next AES_KEY_CACHE_SIZE - 1 lookups of other keys.
+#ifndef AES_KEY_CACHE_SIZE
+  #define AES_KEY_CACHE_SIZE 8
+#endif
+
+struct AES_key_cache
+{
+  struct AES_key Keys[AES_KEY_CACHE_SIZE];
+  uint8_t KeyBytes[AES_KEY_CACHE_SIZE][32];
+  uint8_t KeyLen[AES_KEY_CACHE_SIZE];   // 0 marks a free slot
+  uint32_t LastUse[AES_KEY_CACHE_SIZE];
+  uint32_t Clock;
+  uint32_t Hits;
+  uint32_t Misses;
+};
+
+void AES_key_cache_init(struct AES_key_cache* cache);
+const struct AES_key* AES_key_cache_get(struct AES_key_cache* cache, const uint8_t* key, size_t keyLen);
+// Wipes every cached key schedule; the cache can be reused afterwards.
+void AES_key_cache_clear(struct AES_key_cache* cache);
+
+// Multi-buffer interface: each job is an independent (key, IV, buffer) triple, e.g. one record.
+// The *_jobs functions keep up to AES_MB_LANES jobs in flight and advance one block of each
+// per step, so the rounds of different jobs overlap in the pipeline instead of waiting on the
+// previous block of the same job. A lane that finishes its job picks up the next one.
+// Iv is the CBC chaining value or the CTR counter block of the job and is updated in place,
+// exactly like the single-buffer *_key functions. Jobs must not share a Buf or an Iv.
+#define AES_MB_LANES 8
+
+struct AES_job
+{
+  const struct AES_key* Key;
+  uint8_t* Iv;
+  uint8_t* Buf;
+  size_t Length;
+};
+
+#define AES_BACKEND_PORTABLE 0
+#define AES_BACKEND_AESNI    1
+
+// The backend used by the *_jobs functions and by CTR, the best one available unless changed.
+int AES_jobs_backend(void);
+// Returns 0 (and keeps the current backend) if the requested one is not available.
+int AES_jobs_set_backend(int backend);
+
 #if defined(ECB) && (ECB == 1)
 // buffer size is exactly AES_BLOCKLEN bytes; 
 // you need only AES_init_ctx as IV is not used in ECB 
 // NB: ECB is considered insecure for most uses
 void AES_ECB_encrypt(const struct AES_ctx* ctx, uint8_t* buf);
 void AES_ECB_decrypt(const struct AES_ctx* ctx, uint8_t* buf);
+void AES_ECB_encrypt_key(const struct AES_key* handle, uint8_t* buf);
+void AES_ECB_decrypt_key(const struct AES_key* handle, uint8_t* buf);
 
 #endif // #if defined(ECB) && (ECB == !)
 
@@ -72,6 +186,36 @@ void AES_ECB_decrypt(const struct AES_ctx* ctx, uint8_t* buf);
 //        no IV should ever be reused with the same key 
 void AES_CBC_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
 void AES_CBC_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
+// iv is read as the chaining value and updated in place for the next call.
+void AES_CBC_encrypt_buffer_key(const struct AES_key* handle, uint8_t* iv, uint8_t* buf, size_t length);
+void AES_CBC_decrypt_buffer_key(const struct AES_key* handle, uint8_t* iv, uint8_t* buf, size_t length);
+// Job lengths MUST be multiples of AES_BLOCKLEN.
+void AES_CBC_encrypt_jobs(struct AES_job* jobs, size_t count);
+void AES_CBC_decrypt_jobs(struct AES_job* jobs, size_t count);
+
+// Streaming CBC with PKCS#7 padding: input of any length is fed through init -> update* -> final
+// and partial blocks are buffered inside the stream context, so large files can be processed
+// with a fixed-size buffer.
+// update writes at most (inLen + AES_BLOCKLEN) bytes to out and returns the number written.
+// Encryption final always writes one padded block; decryption keeps the last block back until
+// final, which strips the padding and returns 0 if it is malformed.
+// NOTES: in and out must not overlap; no IV should ever be reused with the same key
+struct AES_CBC_stream_ctx
+{
+  struct AES_ctx Ctx;
+  uint8_t Buffer[AES_BLOCKLEN];
+  uint8_t BufferLen;
+};
+
+void AES_CBC_encrypt_init(struct AES_CBC_stream_ctx* stream, const uint8_t* key, const uint8_t* iv);
+int AES_CBC_encrypt_init_keylen(struct AES_CBC_stream_ctx* stream, const uint8_t* key, size_t keyLen, const uint8_t* iv);
+size_t AES_CBC_encrypt_update(struct AES_CBC_stream_ctx* stream, const uint8_t* in, size_t inLen, uint8_t* out);
+size_t AES_CBC_encrypt_final(struct AES_CBC_stream_ctx* stream, uint8_t* out);
+
+void AES_CBC_decrypt_init(struct AES_CBC_stream_ctx* stream, const uint8_t* key, const uint8_t* iv);
+int AES_CBC_decrypt_init_keylen(struct AES_CBC_stream_ctx* stream, const uint8_t* key, size_t keyLen, const uint8_t* iv);
+size_t AES_CBC_decrypt_update(struct AES_CBC_stream_ctx* stream, const uint8_t* in, size_t inLen, uint8_t* out);
+int AES_CBC_decrypt_final(struct AES_CBC_stream_ctx* stream, uint8_t* out, size_t* outLen);
 
 #endif // #if defined(CBC) && (CBC == 1)
 
@@ -84,8 +228,186 @@ void AES_CBC_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
 // NOTES: you need to set IV in ctx with AES_init_ctx_iv() or AES_ctx_set_iv()
 //        no IV should ever be reused with the same key 
 void AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
+// iv is the counter block and is advanced in place.
+void AES_CTR_xcrypt_buffer_key(const struct AES_key* handle, uint8_t* iv, uint8_t* buf, size_t length);
+// Job lengths may be anything; a partial last block uses part of a keystream block.
+void AES_CTR_xcrypt_jobs(struct AES_job* jobs, size_t count);
 
 #endif // #if defined(CTR) && (CTR == 1)
 
 
+#if defined(XTS) && (XTS == 1) && ((defined(CBC) && (CBC == 1)) || (defined(ECB) && (ECB == 1)))
+
+// XTS-AES (IEEE 1619) for records stored at a fixed position: the record index is the tweak, so
+// any record can be encrypted or decrypted on its own and no IV is stored next to it.
+// The key is the data key followed by the tweak key, 32, 48 or 64 bytes in total; init returns 0
+// for any other length or when both halves are equal.
+// Records of any length >= AES_BLOCKLEN are supported; a final partial block uses ciphertext
+// stealing, so the ciphertext is exactly as long as the plaintext. The encrypt/decrypt functions
+// return 0 (and leave buf untouched) for shorter records.
+// NOTES: XTS gives confidentiality only; a modified record decrypts to garbage but is not detected.
+struct AES_XTS_ctx
+{
+  struct AES_key DataKey;
+  struct AES_key TweakKey;
+};
+
+int AES_XTS_init_ctx(struct AES_XTS_ctx* ctx, const uint8_t* key, size_t keyLen);
+int AES_XTS_encrypt_record(const struct AES_XTS_ctx* ctx, uint64_t recordIndex, uint8_t* buf, size_t length);
+int AES_XTS_decrypt_record(const struct AES_XTS_ctx* ctx, uint64_t recordIndex, uint8_t* buf, size_t length);
+
+#endif // #if defined(XTS) && (XTS == 1) && ...
+
+
+#if defined(CMAC) && (CMAC == 1)
+
+// AES-CMAC (NIST SP 800-38B, RFC 4493) computes a 16-byte tag over a message of any length.
+// The key holds the expanded cipher key and both subkeys and is only read while tagging, so one
+// AES_CMAC_key can be shared by several threads, each with its own AES_CMAC_ctx.
+#define AES_CMAC_TAGLEN 16 // Tag length in bytes
+
+struct AES_CMAC_key
+{
+  struct AES_key Key;
+  uint8_t K1[AES_BLOCKLEN];         // subkey for a complete last block
+  uint8_t K2[AES_BLOCKLEN];         // subkey for a padded last block
+};
+
+struct AES_CMAC_ctx
+{
+  const struct AES_CMAC_key* Key;
+  uint8_t X[AES_BLOCKLEN];          // running CBC-MAC value
+  uint8_t Block[AES_BLOCKLEN];      // last block seen, held back until more data arrives
+  uint8_t BlockLen;
+};
+
+// keyLen is 16, 24 or 32 bytes; returns 0 for any other length.
+int AES_CMAC_key_init(struct AES_CMAC_key* key, const uint8_t* rawKey, size_t keyLen);
+
+// Streaming interface: start -> update* -> finish / check_tag.
+void AES_CMAC_start(struct AES_CMAC_ctx* ctx, const struct AES_CMAC_key* key);
+void AES_CMAC_update(struct AES_CMAC_ctx* ctx, const uint8_t* msg, size_t length);
+void AES_CMAC_finish(struct AES_CMAC_ctx* ctx, uint8_t* tag);
+// Returns 1 if tag matches the computed tag (constant-time compare), 0 otherwise.
+int AES_CMAC_check_tag(struct AES_CMAC_ctx* ctx, const uint8_t* tag);
+
+// One-shot interface.
+void AES_CMAC_buffer(const struct AES_CMAC_key* key, const uint8_t* msg, size_t length, uint8_t* tag);
+int AES_CMAC_verify_buffer(const struct AES_CMAC_key* key, const uint8_t* msg, size_t length, const uint8_t* tag);
+
+#endif // #if defined(CMAC) && (CMAC == 1)
+
+
+#if defined(SIV) && (SIV == 1) && defined(CMAC) && (CMAC == 1) && defined(CTR) && (CTR == 1)
+
+// AES-SIV (RFC 5297): the IV is a CMAC-based PRF of the associated data and the plaintext, so the
+// same input always gives the same ciphertext. That makes encrypted values usable as lookup keys
+// (e.g. an encrypted email in a hash index) while any modification is still detected.
+// The key is the CMAC key followed by the CTR key, 32, 48 or 64 bytes in total; init returns 0
+// for any other length.
+// The ciphertext is the 16-byte synthetic IV followed by the encrypted text, so out must have room
+// for length + AES_SIV_IVLEN bytes. aad is one associated data string, or NULL for none.
+// plain and out + AES_SIV_IVLEN may be the same buffer.
+// NOTES: equal plaintexts give equal ciphertexts by design; only use SIV where that is wanted
+#define AES_SIV_IVLEN 16 // Synthetic IV length in bytes
+
+struct AES_SIV_ctx
+{
+  struct AES_CMAC_key MacKey;
+  struct AES_key CtrKey;
+};
+
+int AES_SIV_init_ctx(struct AES_SIV_ctx* ctx, const uint8_t* key, size_t keyLen);
+void AES_SIV_encrypt(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aadLen,
+                     const uint8_t* plain, size_t length, uint8_t* out);
+// length is the ciphertext length including the synthetic IV. Returns 1 and writes
+// length - AES_SIV_IVLEN bytes to plain on success; returns 0 for an input shorter than the IV,
+// and on a mismatch wipes plain and returns 0.
+int AES_SIV_decrypt(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aadLen,
+                    const uint8_t* in, size_t length, uint8_t* plain);
+
+#endif // #if defined(SIV) && (SIV == 1) && ...
+
+
+#if defined(DRBG) && (DRBG == 1) && defined(CTR) && (CTR == 1)
+
+// CTR_DRBG (NIST SP 800-90A, 10.2) with AES-256 and no derivation function: a fast generator of
+// random bytes, e.g. per-record nonces or synthetic data, seeded from a real entropy source.
+// The output is the AES_CTR_xcrypt_buffer_key keystream of the internal key, so it runs on AES-NI
+// where the CPU has it.
+// entropy is always AES_DRBG_SEEDLEN bytes. Personalization and additional input are optional
+// (NULL), at most AES_DRBG_SEEDLEN bytes long and zero padded; the functions return 0 for longer ones.
+// Requests over AES_DRBG_MAX_REQUEST bytes are served as consecutive requests of that size, with the
+// additional input applied to the first. generate returns 0 once AES_DRBG_RESEED_INTERVAL requests
+// have been served since the last (re)seed.
+// Every request ends with a new key schedule, so small values such as per-record nonces are
+// cheapest when drawn from one larger request.
+// NOTES: the generator is only as unpredictable as its seed; never seed it from rand() or the time
+#define AES_DRBG_SEEDLEN          48                  // key + block length in bytes
+#define AES_DRBG_MAX_REQUEST      65536               // bytes per request, 2^19 bits
+#define AES_DRBG_RESEED_INTERVAL  (1ULL << 48)        // requests between reseeds
+
+struct AES_DRBG_ctx
+{
+  struct AES_key Key;
+  uint8_t V[AES_BLOCKLEN];
+  uint64_t ReseedCounter;
+};
+
+int AES_DRBG_init(struct AES_DRBG_ctx* ctx, const uint8_t* entropy, const uint8_t* personalization, size_t personalizationLen);
+int AES_DRBG_reseed(struct AES_DRBG_ctx* ctx, const uint8_t* entropy, const uint8_t* additional, size_t additionalLen);
+int AES_DRBG_generate(struct AES_DRBG_ctx* ctx, uint8_t* out, size_t length, const uint8_t* additional, size_t additionalLen);
+// Wipes the internal state; init must be called again before the next generate.
+void AES_DRBG_clear(struct AES_DRBG_ctx* ctx);
+
+#endif // #if defined(DRBG) && (DRBG == 1) && ...
+
+
+#if defined(GCM) && (GCM == 1)
+
+#define AES_GCM_IVLEN  12 // Recommended IV length in bytes; other lengths are hashed into J0
+#define AES_GCM_TAGLEN 16 // Authentication tag length in bytes
+
+struct AES_GCM_ctx
+{
+  struct AES_ctx Aes;
+  uint64_t HL[16];                  // 4-bit multiplication table for the hash subkey H (low halves)
+  uint64_t HH[16];                  // 4-bit multiplication table for the hash subkey H (high halves)
+  uint8_t H[AES_BLOCKLEN];          // hash subkey, E(K, 0^128)
+  uint8_t J0[AES_BLOCKLEN];         // pre-counter block, used to encrypt the tag
+  uint8_t Counter[AES_BLOCKLEN];
+  uint8_t KeyStream[AES_BLOCKLEN];
+  uint8_t Xi[AES_BLOCKLEN];         // running GHASH value
+  uint64_t AadLen;
+  uint64_t TextLen;
+  uint8_t KeyStreamUsed;
+  uint8_t AadClosed;
+  uint8_t UseClmul;
+};
+
+// Expands the key and derives the hash subkey; call once per key.
+void AES_GCM_init_ctx(struct AES_GCM_ctx* ctx, const uint8_t* key);
+int AES_GCM_init_ctx_keylen(struct AES_GCM_ctx* ctx, const uint8_t* key, size_t keyLen);
+
+// Streaming interface: start -> update_aad* -> encrypt/decrypt_update* -> finish / check_tag.
+// All additional authenticated data must be supplied before the first encrypt/decrypt call.
+// NOTES: no IV should ever be reused with the same key
+void AES_GCM_start(struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t ivLen);
+void AES_GCM_update_aad(struct AES_GCM_ctx* ctx, const uint8_t* aad, size_t length);
+void AES_GCM_encrypt_update(struct AES_GCM_ctx* ctx, uint8_t* buf, size_t length);
+void AES_GCM_decrypt_update(struct AES_GCM_ctx* ctx, uint8_t* buf, size_t length);
+void AES_GCM_finish(struct AES_GCM_ctx* ctx, uint8_t* tag);
+// Returns 1 if tag matches the computed tag (constant-time compare), 0 otherwise.
+int AES_GCM_check_tag(struct AES_GCM_ctx* ctx, const uint8_t* tag);
+
+// One-shot interface, buf is encrypted/decrypted in place and may have any length.
+// AES_GCM_decrypt_buffer returns 1 on success; on tag mismatch it wipes buf and returns 0.
+void AES_GCM_encrypt_buffer(struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t ivLen,
+                            const uint8_t* aad, size_t aadLen, uint8_t* buf, size_t length, uint8_t* tag);
+int AES_GCM_decrypt_buffer(struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t ivLen,
+                           const uint8_t* aad, size_t aadLen, uint8_t* buf, size_t length, const uint8_t* tag);
+
+#endif // #if defined(GCM) && (GCM == 1)
+
+
 #endif // _AES_H_
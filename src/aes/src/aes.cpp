@@ -1,7 +1,9 @@
 /*
 
-This is an implementation of the AES algorithm, specifically ECB, CTR and CBC mode.
-Block size can be chosen in aes.h - available choices are AES128, AES192, AES256.
+This is an implementation of the AES algorithm, specifically ECB, CTR and CBC mode,
+plus GCM authenticated encryption, XTS, CMAC, SIV and CTR_DRBG built on the same Cipher.
+Each context carries its own key size (AES-128, AES-192 or AES-256); AES128, AES192 and
+AES256 in aes.h only choose the default used by the init functions without a key length.
 
 The implementation is verified against the test vectors in:
   National Institute of Standards and Technology Special Publication 800-38A 2001 ED
@@ -36,24 +38,33 @@ NOTE:   String length must be evenly divisible by 16byte (str_len % 16 == 0)
 /* Includes:                                                                 */
 /*****************************************************************************/
 #include <string.h> // CBC mode, for memset
+#include <atomic>   // multi-buffer backend selection
 #include "aes.h"
 
+// x86 SIMD paths are compiled per function with target attributes, so the rest of
+// the file keeps the default instruction set and the choice is made at runtime.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  #define AES_X86 1
+  #define AES_TARGET(isa) __attribute__((target(isa)))
+  #include <cpuid.h>
+  #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #define AES_X86 1
+  #define AES_TARGET(isa)
+  #include <intrin.h>
+  #include <immintrin.h>
+#else
+  #define AES_X86 0
+#endif
+
 /*****************************************************************************/
 /* Defines:                                                                  */
 /*****************************************************************************/
 // The number of columns comprising a state in AES. This is a constant in AES. Value=4
 #define Nb 4
 
-#if defined(AES256) && (AES256 == 1)
-    #define Nk 8
-    #define Nr 14
-#elif defined(AES192) && (AES192 == 1)
-    #define Nk 6
-    #define Nr 12
-#else
-    #define Nk 4        // The number of 32 bit words in a key.
-    #define Nr 10       // The number of rounds in AES Cipher.
-#endif
+// The number of 32 bit words in a key (Nk) and the number of rounds (Nr) follow from the
+// key length of each context: Nk = keyLen / 4 and Nr = Nk + 6.
 
 // jcallan@github points out that declaring Multiply as a function 
 // reduces code size considerably with the Keil ARM compiler.
@@ -62,6 +73,18 @@ NOTE:   String length must be evenly divisible by 16byte (str_len % 16 == 0)
   #define MULTIPLY_AS_A_FUNCTION 0
 #endif
 
+#if defined(GCM) && (GCM == 1) && defined(GCM_CLMUL) && (GCM_CLMUL == 1) && AES_X86
+  #define GCM_HAS_CLMUL 1
+#else
+  #define GCM_HAS_CLMUL 0
+#endif
+
+#if defined(AES_NI) && (AES_NI == 1) && AES_X86
+  #define AES_HAS_NI 1
+#else
+  #define AES_HAS_NI 0
+#endif
+
 
 
 
@@ -142,9 +165,29 @@ static uint8_t getSBoxValue(uint8_t num)
 */
 #define getSBoxValue(num) (sbox[(num)])
 
+#if GCM_HAS_CLMUL || AES_HAS_NI
+// Returns CPUID leaf 1 ECX, which carries the SSSE3, PCLMULQDQ and AES-NI feature bits.
+static uint32_t cpuFeaturesEcx(void)
+{
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  return (uint32_t)info[2];
+#else
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+  {
+    return 0;
+  }
+  return ecx;
+#endif
+}
+#endif // #if GCM_HAS_CLMUL || AES_HAS_NI
+
 // This function produces Nb(Nr+1) round keys. The round keys are used in each round to decrypt the states. 
-static void KeyExpansion(uint8_t* RoundKey, const uint8_t* Key)
+static void KeyExpansion(uint8_t* RoundKey, const uint8_t* Key, unsigned Nk)
 {
+  const unsigned Nr = Nk + 6;
   unsigned i, j, k;
   uint8_t tempa[4]; // Used for the column/row operations
   
@@ -196,8 +239,7 @@ static void KeyExpansion(uint8_t* RoundKey, const uint8_t* Key)
 
       tempa[0] = tempa[0] ^ Rcon[i/Nk];
     }
-#if defined(AES256) && (AES256 == 1)
-    if (i % Nk == 4)
+    if (Nk == 8 && i % Nk == 4) // AES-256 only
     {
       // Function Subword()
       {
@@ -207,7 +249,6 @@ static void KeyExpansion(uint8_t* RoundKey, const uint8_t* Key)
         tempa[3] = getSBoxValue(tempa[3]);
       }
     }
-#endif
     j = i * 4; k=(i - Nk) * 4;
     RoundKey[j + 0] = RoundKey[k + 0] ^ tempa[0];
     RoundKey[j + 1] = RoundKey[k + 1] ^ tempa[1];
@@ -216,15 +257,34 @@ static void KeyExpansion(uint8_t* RoundKey, const uint8_t* Key)
   }
 }
 
+int AES_init_ctx_keylen(struct AES_ctx* ctx, const uint8_t* key, size_t keyLen)
+{
+  if (keyLen != 16 && keyLen != 24 && keyLen != 32)
+  {
+    return 0;
+  }
+  KeyExpansion(ctx->RoundKey, key, (unsigned)(keyLen / 4));
+  ctx->Nr = (uint8_t)(keyLen / 4 + 6);
+  return 1;
+}
+
 void AES_init_ctx(struct AES_ctx* ctx, const uint8_t* key)
 {
-  KeyExpansion(ctx->RoundKey, key);
+  AES_init_ctx_keylen(ctx, key, AES_KEYLEN);
 }
 #if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
-void AES_init_ctx_iv(struct AES_ctx* ctx, const uint8_t* key, const uint8_t* iv)
+int AES_init_ctx_iv_keylen(struct AES_ctx* ctx, const uint8_t* key, size_t keyLen, const uint8_t* iv)
 {
-  KeyExpansion(ctx->RoundKey, key);
+  if (!AES_init_ctx_keylen(ctx, key, keyLen))
+  {
+    return 0;
+  }
   memcpy (ctx->Iv, iv, AES_BLOCKLEN);
+  return 1;
+}
+void AES_init_ctx_iv(struct AES_ctx* ctx, const uint8_t* key, const uint8_t* iv)
+{
+  AES_init_ctx_iv_keylen(ctx, key, AES_KEYLEN, iv);
 }
 void AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv)
 {
@@ -409,8 +469,10 @@ static void InvShiftRows(state_t* state)
 }
 #endif // #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
 
-// Cipher is the main function that encrypts the PlainText.
-static void Cipher(state_t* state, const uint8_t* RoundKey)
+// CipherRounds is the main function that encrypts the PlainText.
+// It is instantiated once per key size so Nr is a compile-time constant in the round loop.
+template <uint8_t Nr>
+static void CipherRounds(state_t* state, const uint8_t* RoundKey)
 {
   uint8_t round = 0;
 
@@ -435,8 +497,26 @@ static void Cipher(state_t* state, const uint8_t* RoundKey)
   AddRoundKey(Nr, state, RoundKey);
 }
 
+// Cipher selects the round loop for the key size once per block.
+static void Cipher(state_t* state, const uint8_t* RoundKey, uint8_t Nr)
+{
+  switch (Nr)
+  {
+  case 14:
+    CipherRounds<14>(state, RoundKey);
+    break;
+  case 12:
+    CipherRounds<12>(state, RoundKey);
+    break;
+  default:
+    CipherRounds<10>(state, RoundKey);
+    break;
+  }
+}
+
 #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
-static void InvCipher(state_t* state, const uint8_t* RoundKey)
+template <uint8_t Nr>
+static void InvCipherRounds(state_t* state, const uint8_t* RoundKey)
 {
   uint8_t round = 0;
 
@@ -459,24 +539,181 @@ static void InvCipher(state_t* state, const uint8_t* RoundKey)
   }
 
 }
+
+static void InvCipher(state_t* state, const uint8_t* RoundKey, uint8_t Nr)
+{
+  switch (Nr)
+  {
+  case 14:
+    InvCipherRounds<14>(state, RoundKey);
+    break;
+  case 12:
+    InvCipherRounds<12>(state, RoundKey);
+    break;
+  default:
+    InvCipherRounds<10>(state, RoundKey);
+    break;
+  }
+}
+
+// EqInvCipherRounds is the "equivalent inverse cipher" of FIPS-197 5.3.5. It runs the rounds in
+// the same order as Cipher, using a decryption key schedule that already has InvMixColumns
+// applied to the middle round keys (see AES_key_init).
+template <uint8_t Nr>
+static void EqInvCipherRounds(state_t* state, const uint8_t* DecRoundKey)
+{
+  uint8_t round;
+
+  AddRoundKey(0, state, DecRoundKey);
+
+  for (round = 1; ; ++round)
+  {
+    InvSubBytes(state);
+    InvShiftRows(state);
+    if (round == Nr) {
+      break;
+    }
+    InvMixColumns(state);
+    AddRoundKey(round, state, DecRoundKey);
+  }
+  // Add round key to last round
+  AddRoundKey(Nr, state, DecRoundKey);
+}
+
+static void EqInvCipher(state_t* state, const uint8_t* DecRoundKey, uint8_t Nr)
+{
+  switch (Nr)
+  {
+  case 14:
+    EqInvCipherRounds<14>(state, DecRoundKey);
+    break;
+  case 12:
+    EqInvCipherRounds<12>(state, DecRoundKey);
+    break;
+  default:
+    EqInvCipherRounds<10>(state, DecRoundKey);
+    break;
+  }
+}
 #endif // #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
 
 /*****************************************************************************/
 /* Public functions:                                                         */
 /*****************************************************************************/
+int AES_key_init(struct AES_key* handle, const uint8_t* key, size_t keyLen)
+{
+  if (keyLen != 16 && keyLen != 24 && keyLen != 32)
+  {
+    return 0;
+  }
+  handle->Nr = (uint8_t)(keyLen / 4 + 6);
+  KeyExpansion(handle->RoundKey, key, (unsigned)(keyLen / 4));
+
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+  // Decryption schedule for the equivalent inverse cipher: the round keys in reverse order,
+  // with InvMixColumns applied to every key except the first and the last.
+  uint8_t round;
+  for (round = 0; round <= handle->Nr; ++round)
+  {
+    memcpy(handle->DecRoundKey + round * AES_BLOCKLEN, handle->RoundKey + (handle->Nr - round) * AES_BLOCKLEN, AES_BLOCKLEN);
+    if (round != 0 && round != handle->Nr)
+    {
+      InvMixColumns((state_t*)(handle->DecRoundKey + round * AES_BLOCKLEN));
+    }
+  }
+#endif
+  return 1;
+}
+
+void AES_ctx_set_key(struct AES_ctx* ctx, const struct AES_key* handle)
+{
+  memcpy(ctx->RoundKey, handle->RoundKey, AES_keyExpSize);
+  ctx->Nr = handle->Nr;
+}
+
+void AES_key_cache_init(struct AES_key_cache* cache)
+{
+  memset(cache, 0, sizeof(struct AES_key_cache));
+}
+
+void AES_key_cache_clear(struct AES_key_cache* cache)
+{
+  // Round keys are key material, so wipe them rather than only marking the slots free
+  volatile uint8_t* p = (volatile uint8_t*)cache;
+  size_t i;
+  for (i = 0; i < sizeof(struct AES_key_cache); ++i)
+  {
+    p[i] = 0;
+  }
+}
+
+const struct AES_key* AES_key_cache_get(struct AES_key_cache* cache, const uint8_t* key, size_t keyLen)
+{
+  uint8_t i, victim = 0;
+  size_t j;
+  uint8_t diff;
+
+  if (keyLen != 16 && keyLen != 24 && keyLen != 32)
+  {
+    return NULL;
+  }
+
+  ++cache->Clock;
+  for (i = 0; i < AES_KEY_CACHE_SIZE; ++i)
+  {
+    if (cache->KeyLen[i] == keyLen)
+    {
+      // Compare without an early exit so the lookup time does not depend on where keys differ
+      diff = 0;
+      for (j = 0; j < keyLen; ++j)
+      {
+        diff |= (uint8_t)(cache->KeyBytes[i][j] ^ key[j]);
+      }
+      if (diff == 0)
+      {
+        cache->LastUse[i] = cache->Clock;
+        ++cache->Hits;
+        return &cache->Keys[i];
+      }
+    }
+    // Prefer a free slot, otherwise evict the least recently used one
+    if (cache->KeyLen[victim] != 0 && (cache->KeyLen[i] == 0 || cache->LastUse[i] < cache->LastUse[victim]))
+    {
+      victim = i;
+    }
+  }
+
+  ++cache->Misses;
+  AES_key_init(&cache->Keys[victim], key, keyLen);
+  memcpy(cache->KeyBytes[victim], key, keyLen);
+  cache->KeyLen[victim] = (uint8_t)keyLen;
+  cache->LastUse[victim] = cache->Clock;
+  return &cache->Keys[victim];
+}
+
 #if defined(ECB) && (ECB == 1)
 
 
 void AES_ECB_encrypt(const struct AES_ctx* ctx, uint8_t* buf)
 {
   // The next function call encrypts the PlainText with the Key using AES algorithm.
-  Cipher((state_t*)buf, ctx->RoundKey);
+  Cipher((state_t*)buf, ctx->RoundKey, ctx->Nr);
 }
 
 void AES_ECB_decrypt(const struct AES_ctx* ctx, uint8_t* buf)
 {
   // The next function call decrypts the PlainText with the Key using AES algorithm.
-  InvCipher((state_t*)buf, ctx->RoundKey);
+  InvCipher((state_t*)buf, ctx->RoundKey, ctx->Nr);
+}
+
+void AES_ECB_encrypt_key(const struct AES_key* handle, uint8_t* buf)
+{
+  Cipher((state_t*)buf, handle->RoundKey, handle->Nr);
+}
+
+void AES_ECB_decrypt_key(const struct AES_key* handle, uint8_t* buf)
+{
+  EqInvCipher((state_t*)buf, handle->DecRoundKey, handle->Nr);
 }
 
 
@@ -505,7 +742,7 @@ void AES_CBC_encrypt_buffer(struct AES_ctx *ctx, uint8_t* buf, size_t length)
   for (i = 0; i < length; i += AES_BLOCKLEN)
   {
     XorWithIv(buf, Iv);
-    Cipher((state_t*)buf, ctx->RoundKey);
+    Cipher((state_t*)buf, ctx->RoundKey, ctx->Nr);
     Iv = buf;
     buf += AES_BLOCKLEN;
   }
@@ -520,7 +757,7 @@ void AES_CBC_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
   for (i = 0; i < length; i += AES_BLOCKLEN)
   {
     memcpy(storeNextIv, buf, AES_BLOCKLEN);
-    InvCipher((state_t*)buf, ctx->RoundKey);
+    InvCipher((state_t*)buf, ctx->RoundKey, ctx->Nr);
     XorWithIv(buf, ctx->Iv);
     memcpy(ctx->Iv, storeNextIv, AES_BLOCKLEN);
     buf += AES_BLOCKLEN;
@@ -528,37 +765,286 @@ void AES_CBC_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
 
 }
 
+void AES_CBC_encrypt_buffer_key(const struct AES_key* handle, uint8_t* iv, uint8_t* buf, size_t length)
+{
+  size_t i;
+  uint8_t *Iv = iv;
+  for (i = 0; i < length; i += AES_BLOCKLEN)
+  {
+    XorWithIv(buf, Iv);
+    Cipher((state_t*)buf, handle->RoundKey, handle->Nr);
+    Iv = buf;
+    buf += AES_BLOCKLEN;
+  }
+  /* store Iv for next call */
+  if (Iv != iv)
+  {
+    memcpy(iv, Iv, AES_BLOCKLEN);
+  }
+}
+
+void AES_CBC_decrypt_buffer_key(const struct AES_key* handle, uint8_t* iv, uint8_t* buf, size_t length)
+{
+  size_t i;
+  uint8_t storeNextIv[AES_BLOCKLEN];
+  for (i = 0; i < length; i += AES_BLOCKLEN)
+  {
+    memcpy(storeNextIv, buf, AES_BLOCKLEN);
+    EqInvCipher((state_t*)buf, handle->DecRoundKey, handle->Nr);
+    XorWithIv(buf, iv);
+    memcpy(iv, storeNextIv, AES_BLOCKLEN);
+    buf += AES_BLOCKLEN;
+  }
+}
+
+int AES_CBC_encrypt_init_keylen(struct AES_CBC_stream_ctx* stream, const uint8_t* key, size_t keyLen, const uint8_t* iv)
+{
+  stream->BufferLen = 0;
+  return AES_init_ctx_iv_keylen(&stream->Ctx, key, keyLen, iv);
+}
+
+void AES_CBC_encrypt_init(struct AES_CBC_stream_ctx* stream, const uint8_t* key, const uint8_t* iv)
+{
+  AES_CBC_encrypt_init_keylen(stream, key, AES_KEYLEN, iv);
+}
+
+size_t AES_CBC_encrypt_update(struct AES_CBC_stream_ctx* stream, const uint8_t* in, size_t inLen, uint8_t* out)
+{
+  size_t written = 0;
+  size_t take;
+
+  // Complete a block left over from the previous call first
+  if (stream->BufferLen > 0)
+  {
+    take = AES_BLOCKLEN - stream->BufferLen;
+    if (take > inLen)
+    {
+      take = inLen;
+    }
+    memcpy(stream->Buffer + stream->BufferLen, in, take);
+    stream->BufferLen += (uint8_t)take;
+    in += take;
+    inLen -= take;
+
+    if (stream->BufferLen < AES_BLOCKLEN)
+    {
+      return 0;
+    }
+    memcpy(out, stream->Buffer, AES_BLOCKLEN);
+    AES_CBC_encrypt_buffer(&stream->Ctx, out, AES_BLOCKLEN);
+    stream->BufferLen = 0;
+    written = AES_BLOCKLEN;
+  }
+
+  // Whole blocks go straight from in to out
+  take = inLen - (inLen % AES_BLOCKLEN);
+  if (take > 0)
+  {
+    memcpy(out + written, in, take);
+    AES_CBC_encrypt_buffer(&stream->Ctx, out + written, take);
+    written += take;
+    in += take;
+    inLen -= take;
+  }
+
+  memcpy(stream->Buffer, in, inLen);
+  stream->BufferLen = (uint8_t)inLen;
+  return written;
+}
+
+size_t AES_CBC_encrypt_final(struct AES_CBC_stream_ctx* stream, uint8_t* out)
+{
+  // PKCS#7: always pad, a full block of padding when the input is block aligned
+  const uint8_t pad = (uint8_t)(AES_BLOCKLEN - stream->BufferLen);
+  memcpy(out, stream->Buffer, stream->BufferLen);
+  memset(out + stream->BufferLen, pad, pad);
+  AES_CBC_encrypt_buffer(&stream->Ctx, out, AES_BLOCKLEN);
+  stream->BufferLen = 0;
+  return AES_BLOCKLEN;
+}
+
+int AES_CBC_decrypt_init_keylen(struct AES_CBC_stream_ctx* stream, const uint8_t* key, size_t keyLen, const uint8_t* iv)
+{
+  stream->BufferLen = 0;
+  return AES_init_ctx_iv_keylen(&stream->Ctx, key, keyLen, iv);
+}
+
+void AES_CBC_decrypt_init(struct AES_CBC_stream_ctx* stream, const uint8_t* key, const uint8_t* iv)
+{
+  AES_CBC_decrypt_init_keylen(stream, key, AES_KEYLEN, iv);
+}
+
+size_t AES_CBC_decrypt_update(struct AES_CBC_stream_ctx* stream, const uint8_t* in, size_t inLen, uint8_t* out)
+{
+  size_t written = 0;
+  size_t take;
+
+  while (inLen > 0)
+  {
+    // More input follows, so a buffered full block cannot be the padded one
+    if (stream->BufferLen == AES_BLOCKLEN)
+    {
+      memcpy(out + written, stream->Buffer, AES_BLOCKLEN);
+      AES_CBC_decrypt_buffer(&stream->Ctx, out + written, AES_BLOCKLEN);
+      written += AES_BLOCKLEN;
+      stream->BufferLen = 0;
+    }
+
+    // Decrypt whole blocks in bulk, keeping at least one byte back for the buffer
+    if (stream->BufferLen == 0 && inLen > AES_BLOCKLEN)
+    {
+      take = ((inLen - 1) / AES_BLOCKLEN) * AES_BLOCKLEN;
+      memcpy(out + written, in, take);
+      AES_CBC_decrypt_buffer(&stream->Ctx, out + written, take);
+      written += take;
+      in += take;
+      inLen -= take;
+    }
+
+    take = AES_BLOCKLEN - stream->BufferLen;
+    if (take > inLen)
+    {
+      take = inLen;
+    }
+    memcpy(stream->Buffer + stream->BufferLen, in, take);
+    stream->BufferLen += (uint8_t)take;
+    in += take;
+    inLen -= take;
+  }
+  return written;
+}
+
+int AES_CBC_decrypt_final(struct AES_CBC_stream_ctx* stream, uint8_t* out, size_t* outLen)
+{
+  uint8_t block[AES_BLOCKLEN];
+  uint8_t pad, bad = 0;
+  uint8_t i;
+
+  *outLen = 0;
+  if (stream->BufferLen != AES_BLOCKLEN)
+  {
+    return 0; // ciphertext length was not a multiple of AES_BLOCKLEN
+  }
+
+  memcpy(block, stream->Buffer, AES_BLOCKLEN);
+  AES_CBC_decrypt_buffer(&stream->Ctx, block, AES_BLOCKLEN);
+  stream->BufferLen = 0;
+
+  // Check every padding byte without branching on the secret data
+  pad = block[AES_BLOCKLEN - 1];
+  bad |= (uint8_t)(pad == 0);
+  bad |= (uint8_t)(pad > AES_BLOCKLEN);
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    const uint8_t inPad = (uint8_t)(i >= AES_BLOCKLEN - pad);
+    bad |= (uint8_t)(inPad & (block[i] != pad));
+  }
+  if (bad)
+  {
+    return 0;
+  }
+
+  memcpy(out, block, AES_BLOCKLEN - pad);
+  *outLen = AES_BLOCKLEN - pad;
+  return 1;
+}
+
 #endif // #if defined(CBC) && (CBC == 1)
 
 
 
 #if defined(CTR) && (CTR == 1)
 
+#if AES_HAS_NI
+
+#define CTR_NI_BLOCKS 8
+
+// Xors the keystream of whole blocks into buf, CTR_NI_BLOCKS counters at a time with their rounds
+// interleaved, and advances Iv past them. Returns the number of blocks done; the caller finishes
+// the remaining (fewer than CTR_NI_BLOCKS) blocks.
+AES_TARGET("aes,sse2")
+static size_t CtrBlocksAesni(const uint8_t* RoundKey, uint8_t Nr, uint8_t* Iv, uint8_t* buf, size_t blocks)
+{
+  uint8_t counters[CTR_NI_BLOCKS][AES_BLOCKLEN];
+  __m128i k[15];
+  __m128i s[CTR_NI_BLOCKS];
+  size_t done;
+  int j, round, bi;
+
+  for (round = 0; round <= Nr; ++round)
+  {
+    k[round] = _mm_loadu_si128((const __m128i*)(RoundKey + round * AES_BLOCKLEN));
+  }
+
+  for (done = 0; done + CTR_NI_BLOCKS <= blocks; done += CTR_NI_BLOCKS)
+  {
+    for (j = 0; j < CTR_NI_BLOCKS; ++j)
+    {
+      memcpy(counters[j], Iv, AES_BLOCKLEN);
+      for (bi = (AES_BLOCKLEN - 1); bi >= 0; --bi)
+      {
+        if (++Iv[bi] != 0)
+        {
+          break;
+        }
+      }
+    }
+    for (j = 0; j < CTR_NI_BLOCKS; ++j)
+    {
+      s[j] = _mm_xor_si128(_mm_loadu_si128((const __m128i*)counters[j]), k[0]);
+    }
+    for (round = 1; round < Nr; ++round)
+    {
+      for (j = 0; j < CTR_NI_BLOCKS; ++j)
+      {
+        s[j] = _mm_aesenc_si128(s[j], k[round]);
+      }
+    }
+    for (j = 0; j < CTR_NI_BLOCKS; ++j)
+    {
+      __m128i* p = (__m128i*)(buf + (done + j) * AES_BLOCKLEN);
+      _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), _mm_aesenclast_si128(s[j], k[Nr])));
+    }
+  }
+  return done;
+}
+
+#endif // #if AES_HAS_NI
+
 /* Symmetrical operation: same function for encrypting as for decrypting. Note any IV/nonce should never be reused with the same key */
-void AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
+// Shared by the context and key-handle entry points; Iv is the counter block and is advanced in place.
+static void CtrXcrypt(const uint8_t* RoundKey, uint8_t Nr, uint8_t* Iv, uint8_t* buf, size_t length)
 {
   uint8_t buffer[AES_BLOCKLEN];
   
   size_t i;
   int bi;
+#if AES_HAS_NI
+  if (length >= CTR_NI_BLOCKS * AES_BLOCKLEN && AES_jobs_backend() == AES_BACKEND_AESNI)
+  {
+    size_t done = CtrBlocksAesni(RoundKey, Nr, Iv, buf, length / AES_BLOCKLEN) * AES_BLOCKLEN;
+    buf += done;
+    length -= done;
+  }
+#endif
   for (i = 0, bi = AES_BLOCKLEN; i < length; ++i, ++bi)
   {
     if (bi == AES_BLOCKLEN) /* we need to regen xor compliment in buffer */
     {
       
-      memcpy(buffer, ctx->Iv, AES_BLOCKLEN);
-      Cipher((state_t*)buffer,ctx->RoundKey);
+      memcpy(buffer, Iv, AES_BLOCKLEN);
+      Cipher((state_t*)buffer, RoundKey, Nr);
 
       /* Increment Iv and handle overflow */
       for (bi = (AES_BLOCKLEN - 1); bi >= 0; --bi)
       {
 	/* inc will overflow */
-        if (ctx->Iv[bi] == 255)
+        if (Iv[bi] == 255)
 	{
-          ctx->Iv[bi] = 0;
+          Iv[bi] = 0;
           continue;
         } 
-        ctx->Iv[bi] += 1;
+        Iv[bi] += 1;
         break;   
       }
       bi = 0;
@@ -568,5 +1054,1269 @@ void AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
   }
 }
 
+void AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
+{
+  CtrXcrypt(ctx->RoundKey, ctx->Nr, ctx->Iv, buf, length);
+}
+
+void AES_CTR_xcrypt_buffer_key(const struct AES_key* handle, uint8_t* iv, uint8_t* buf, size_t length)
+{
+  CtrXcrypt(handle->RoundKey, handle->Nr, iv, buf, length);
+}
+
 #endif // #if defined(CTR) && (CTR == 1)
 
+
+/*****************************************************************************/
+/* Multi-buffer jobs:                                                        */
+/*****************************************************************************/
+#if AES_HAS_NI
+static int cpu_has_aesni(void)
+{
+  return (cpuFeaturesEcx() >> 25) & 1;
+}
+#endif
+
+// -1 until the first call detects the best backend. CTR and the DRBG read it on every call, from any
+// thread, so it is atomic; a detection that loses the race to another thread keeps that thread's value.
+static std::atomic<int> jobsBackend(-1);
+
+int AES_jobs_backend(void)
+{
+  int backend = jobsBackend.load(std::memory_order_relaxed);
+  if (backend < 0)
+  {
+    int expected = -1;
+#if AES_HAS_NI
+    backend = cpu_has_aesni() ? AES_BACKEND_AESNI : AES_BACKEND_PORTABLE;
+#else
+    backend = AES_BACKEND_PORTABLE;
+#endif
+    if (!jobsBackend.compare_exchange_strong(expected, backend, std::memory_order_relaxed))
+    {
+      backend = expected;
+    }
+  }
+  return backend;
+}
+
+int AES_jobs_set_backend(int backend)
+{
+  if (backend == AES_BACKEND_PORTABLE)
+  {
+    jobsBackend.store(backend, std::memory_order_relaxed);
+    return 1;
+  }
+#if AES_HAS_NI
+  if (backend == AES_BACKEND_AESNI && cpu_has_aesni())
+  {
+    jobsBackend.store(backend, std::memory_order_relaxed);
+    return 1;
+  }
+#endif
+  return 0;
+}
+
+#if AES_HAS_NI && ((defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1)))
+
+#define MB_CBC_ENCRYPT 0
+#define MB_CBC_DECRYPT 1
+#define MB_CTR         2
+
+// Runs the jobs through AES_MB_LANES lanes. Each step loads one block per busy lane, runs the
+// rounds of all lanes interleaved (the AESENC/AESDEC of different lanes are independent, so
+// they issue back to back instead of waiting out the latency of one chain), and stores the
+// results. Lanes with different key sizes stop at their own last round.
+AES_TARGET("aes,sse2")
+static void mb_jobs_aesni(struct AES_job* jobs, size_t count, int mode)
+{
+  struct AES_job* lane[AES_MB_LANES];
+  size_t offset[AES_MB_LANES];
+  __m128i chain[AES_MB_LANES];
+  __m128i in[AES_MB_LANES];
+  __m128i state[AES_MB_LANES];
+  const uint8_t* keys[AES_MB_LANES];
+  uint8_t nr[AES_MB_LANES];
+  uint8_t last[AES_BLOCKLEN];
+  size_t next = 0;
+  size_t remaining, i;
+  int l, active, round, bi;
+
+  // Idle lanes are skipped, but clear their registers so no lane ever reads an indeterminate value
+  for (l = 0; l < AES_MB_LANES; ++l)
+  {
+    lane[l] = NULL;
+    chain[l] = in[l] = state[l] = _mm_setzero_si128();
+  }
+
+  for (;;)
+  {
+    // Retire finished jobs and refill idle lanes
+    active = 0;
+    for (l = 0; l < AES_MB_LANES; ++l)
+    {
+      if (lane[l] != NULL && offset[l] >= lane[l]->Length)
+      {
+        if (mode != MB_CTR)
+        {
+          _mm_storeu_si128((__m128i*)lane[l]->Iv, chain[l]);
+        }
+        lane[l] = NULL;
+      }
+      while (lane[l] == NULL && next < count)
+      {
+        if (jobs[next].Length > 0)
+        {
+          lane[l] = &jobs[next];
+          offset[l] = 0;
+          chain[l] = _mm_loadu_si128((const __m128i*)lane[l]->Iv);
+#if defined(CBC) && (CBC == 1)
+          keys[l] = (mode == MB_CBC_DECRYPT) ? lane[l]->Key->DecRoundKey : lane[l]->Key->RoundKey;
+#else
+          keys[l] = lane[l]->Key->RoundKey;
+#endif
+          nr[l] = lane[l]->Key->Nr;
+        }
+        ++next;
+      }
+      if (lane[l] != NULL)
+      {
+        ++active;
+      }
+    }
+    if (active == 0)
+    {
+      break;
+    }
+
+    for (l = 0; l < AES_MB_LANES; ++l)
+    {
+      if (lane[l] == NULL)
+      {
+        continue;
+      }
+      const __m128i k0 = _mm_loadu_si128((const __m128i*)keys[l]);
+      if (mode == MB_CTR)
+      {
+        state[l] = _mm_xor_si128(_mm_loadu_si128((const __m128i*)lane[l]->Iv), k0);
+        for (bi = (AES_BLOCKLEN - 1); bi >= 0; --bi)
+        {
+          if (++lane[l]->Iv[bi] != 0)
+          {
+            break;
+          }
+        }
+      }
+      else
+      {
+        in[l] = _mm_loadu_si128((const __m128i*)(lane[l]->Buf + offset[l]));
+        state[l] = (mode == MB_CBC_ENCRYPT) ? _mm_xor_si128(_mm_xor_si128(in[l], chain[l]), k0) : _mm_xor_si128(in[l], k0);
+      }
+    }
+
+    for (round = 1; round < 14; ++round)
+    {
+      for (l = 0; l < AES_MB_LANES; ++l)
+      {
+        if (lane[l] != NULL && round < nr[l])
+        {
+          const __m128i k = _mm_loadu_si128((const __m128i*)(keys[l] + round * AES_BLOCKLEN));
+          state[l] = (mode == MB_CBC_DECRYPT) ? _mm_aesdec_si128(state[l], k) : _mm_aesenc_si128(state[l], k);
+        }
+      }
+    }
+
+    for (l = 0; l < AES_MB_LANES; ++l)
+    {
+      if (lane[l] == NULL)
+      {
+        continue;
+      }
+      const __m128i k = _mm_loadu_si128((const __m128i*)(keys[l] + nr[l] * AES_BLOCKLEN));
+      uint8_t* p = lane[l]->Buf + offset[l];
+      if (mode == MB_CBC_ENCRYPT)
+      {
+        state[l] = _mm_aesenclast_si128(state[l], k);
+        chain[l] = state[l];
+        _mm_storeu_si128((__m128i*)p, state[l]);
+      }
+      else if (mode == MB_CBC_DECRYPT)
+      {
+        state[l] = _mm_aesdeclast_si128(state[l], k);
+        _mm_storeu_si128((__m128i*)p, _mm_xor_si128(state[l], chain[l]));
+        chain[l] = in[l];
+      }
+      else
+      {
+        state[l] = _mm_aesenclast_si128(state[l], k);
+        remaining = lane[l]->Length - offset[l];
+        if (remaining >= AES_BLOCKLEN)
+        {
+          _mm_storeu_si128((__m128i*)p, _mm_xor_si128(_mm_loadu_si128((const __m128i*)p), state[l]));
+        }
+        else
+        {
+          _mm_storeu_si128((__m128i*)last, state[l]);
+          for (i = 0; i < remaining; ++i)
+          {
+            p[i] ^= last[i];
+          }
+        }
+      }
+      offset[l] += AES_BLOCKLEN;
+    }
+  }
+}
+
+#endif // #if AES_HAS_NI && ...
+
+#if defined(CBC) && (CBC == 1)
+void AES_CBC_encrypt_jobs(struct AES_job* jobs, size_t count)
+{
+  size_t i;
+#if AES_HAS_NI
+  if (AES_jobs_backend() == AES_BACKEND_AESNI)
+  {
+    mb_jobs_aesni(jobs, count, MB_CBC_ENCRYPT);
+    return;
+  }
+#endif
+  for (i = 0; i < count; ++i)
+  {
+    AES_CBC_encrypt_buffer_key(jobs[i].Key, jobs[i].Iv, jobs[i].Buf, jobs[i].Length);
+  }
+}
+
+void AES_CBC_decrypt_jobs(struct AES_job* jobs, size_t count)
+{
+  size_t i;
+#if AES_HAS_NI
+  if (AES_jobs_backend() == AES_BACKEND_AESNI)
+  {
+    mb_jobs_aesni(jobs, count, MB_CBC_DECRYPT);
+    return;
+  }
+#endif
+  for (i = 0; i < count; ++i)
+  {
+    AES_CBC_decrypt_buffer_key(jobs[i].Key, jobs[i].Iv, jobs[i].Buf, jobs[i].Length);
+  }
+}
+#endif // #if defined(CBC) && (CBC == 1)
+
+#if defined(CTR) && (CTR == 1)
+void AES_CTR_xcrypt_jobs(struct AES_job* jobs, size_t count)
+{
+  size_t i;
+#if AES_HAS_NI
+  if (AES_jobs_backend() == AES_BACKEND_AESNI)
+  {
+    mb_jobs_aesni(jobs, count, MB_CTR);
+    return;
+  }
+#endif
+  for (i = 0; i < count; ++i)
+  {
+    AES_CTR_xcrypt_buffer_key(jobs[i].Key, jobs[i].Iv, jobs[i].Buf, jobs[i].Length);
+  }
+}
+#endif // #if defined(CTR) && (CTR == 1)
+
+
+#if defined(XTS) && (XTS == 1) && ((defined(CBC) && (CBC == 1)) || (defined(ECB) && (ECB == 1)))
+
+// Number of blocks whose tweaks are computed ahead and then ciphered back to back.
+#define XTS_BATCH 8
+
+int AES_XTS_init_ctx(struct AES_XTS_ctx* ctx, const uint8_t* key, size_t keyLen)
+{
+  size_t half = keyLen / 2;
+  size_t i;
+  uint8_t diff = 0;
+
+  if (keyLen != 32 && keyLen != 48 && keyLen != 64)
+  {
+    return 0;
+  }
+  // IEEE 1619 requires two independent keys; equal halves would make the tweak predictable
+  for (i = 0; i < half; ++i)
+  {
+    diff |= (uint8_t)(key[i] ^ key[half + i]);
+  }
+  if (diff == 0)
+  {
+    return 0;
+  }
+  AES_key_init(&ctx->DataKey, key, half);
+  AES_key_init(&ctx->TweakKey, key + half, half);
+  return 1;
+}
+
+// Multiplies the tweak by the primitive element x of GF(2^128), with the little-endian bit
+// ordering of IEEE 1619.
+static void xts_mul_alpha(uint8_t* T)
+{
+  uint8_t carry = 0;
+  uint8_t next;
+  uint8_t i;
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    next = (uint8_t)(T[i] >> 7);
+    T[i] = (uint8_t)((T[i] << 1) | carry);
+    carry = next;
+  }
+  if (carry)
+  {
+    T[0] ^= 0x87;
+  }
+}
+
+static void xts_xor_block(uint8_t* buf, const uint8_t* T)
+{
+  uint8_t i;
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    buf[i] ^= T[i];
+  }
+}
+
+// Processes whole blocks and advances T past them. The tweak chain is the only serial dependency,
+// so the tweaks of a batch are computed first and the blocks of the batch are then ciphered back
+// to back with no dependency between them.
+static void xts_blocks(const struct AES_XTS_ctx* ctx, uint8_t* T, uint8_t* buf, size_t blocks, int decrypt)
+{
+  uint8_t tweaks[XTS_BATCH][AES_BLOCKLEN];
+  size_t n, b;
+
+  while (blocks > 0)
+  {
+    n = blocks < XTS_BATCH ? blocks : XTS_BATCH;
+    for (b = 0; b < n; ++b)
+    {
+      memcpy(tweaks[b], T, AES_BLOCKLEN);
+      xts_mul_alpha(T);
+      xts_xor_block(buf + b * AES_BLOCKLEN, tweaks[b]);
+    }
+    for (b = 0; b < n; ++b)
+    {
+      if (decrypt)
+      {
+        EqInvCipher((state_t*)(buf + b * AES_BLOCKLEN), ctx->DataKey.DecRoundKey, ctx->DataKey.Nr);
+      }
+      else
+      {
+        Cipher((state_t*)(buf + b * AES_BLOCKLEN), ctx->DataKey.RoundKey, ctx->DataKey.Nr);
+      }
+    }
+    for (b = 0; b < n; ++b)
+    {
+      xts_xor_block(buf + b * AES_BLOCKLEN, tweaks[b]);
+    }
+    buf += n * AES_BLOCKLEN;
+    blocks -= n;
+  }
+}
+
+// The initial tweak is E(K2, i) with the record index i as a 128-bit little-endian number.
+static void xts_start(const struct AES_XTS_ctx* ctx, uint64_t recordIndex, uint8_t* T)
+{
+  uint8_t i;
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    T[i] = i < 8 ? (uint8_t)(recordIndex >> (8 * i)) : 0;
+  }
+  Cipher((state_t*)T, ctx->TweakKey.RoundKey, ctx->TweakKey.Nr);
+}
+
+int AES_XTS_encrypt_record(const struct AES_XTS_ctx* ctx, uint64_t recordIndex, uint8_t* buf, size_t length)
+{
+  uint8_t T[AES_BLOCKLEN];
+  uint8_t last[AES_BLOCKLEN];
+  size_t blocks = length / AES_BLOCKLEN;
+  size_t tail = length % AES_BLOCKLEN;
+  uint8_t* full;
+
+  if (length < AES_BLOCKLEN)
+  {
+    return 0;
+  }
+  xts_start(ctx, recordIndex, T);
+
+  if (tail == 0)
+  {
+    xts_blocks(ctx, T, buf, blocks, 0);
+    return 1;
+  }
+
+  // Ciphertext stealing: encrypt the last full block, give its first bytes to the partial block
+  // and encrypt the partial plaintext padded with the rest of it in the full block's place.
+  xts_blocks(ctx, T, buf, blocks, 0);
+  full = buf + (blocks - 1) * AES_BLOCKLEN;
+  memcpy(last, full, AES_BLOCKLEN);
+  memcpy(last, full + AES_BLOCKLEN, tail);
+  memcpy(full + AES_BLOCKLEN, full, tail);
+  memcpy(full, last, AES_BLOCKLEN);
+  xts_blocks(ctx, T, full, 1, 0);
+  return 1;
+}
+
+int AES_XTS_decrypt_record(const struct AES_XTS_ctx* ctx, uint64_t recordIndex, uint8_t* buf, size_t length)
+{
+  uint8_t T[AES_BLOCKLEN];
+  uint8_t nextT[AES_BLOCKLEN];
+  uint8_t last[AES_BLOCKLEN];
+  size_t blocks = length / AES_BLOCKLEN;
+  size_t tail = length % AES_BLOCKLEN;
+  uint8_t* full;
+
+  if (length < AES_BLOCKLEN)
+  {
+    return 0;
+  }
+  xts_start(ctx, recordIndex, T);
+
+  if (tail == 0)
+  {
+    xts_blocks(ctx, T, buf, blocks, 1);
+    return 1;
+  }
+
+  // The stolen block was encrypted with the tweak after the last full block's, so decrypt it
+  // first and undo the swap before decrypting the last full block with its own tweak.
+  xts_blocks(ctx, T, buf, blocks - 1, 1);
+  memcpy(nextT, T, AES_BLOCKLEN);
+  xts_mul_alpha(nextT);
+  full = buf + (blocks - 1) * AES_BLOCKLEN;
+  xts_blocks(ctx, nextT, full, 1, 1);
+  memcpy(last, full, AES_BLOCKLEN);
+  memcpy(last, full + AES_BLOCKLEN, tail);
+  memcpy(full + AES_BLOCKLEN, full, tail);
+  memcpy(full, last, AES_BLOCKLEN);
+  xts_blocks(ctx, T, full, 1, 1);
+  return 1;
+}
+
+#endif // #if defined(XTS) && (XTS == 1) && ...
+
+
+
+/*****************************************************************************/
+/* CMAC:                                                                     */
+/*****************************************************************************/
+#if defined(CMAC) && (CMAC == 1)
+
+// out = in * x in GF(2^128) with the big-endian bit ordering of SP 800-38B.
+static void cmac_double(const uint8_t* in, uint8_t* out)
+{
+  uint8_t carry = (uint8_t)(in[0] >> 7);
+  uint8_t i;
+
+  for (i = 0; i < AES_BLOCKLEN - 1; ++i)
+  {
+    out[i] = (uint8_t)((in[i] << 1) | (in[i + 1] >> 7));
+  }
+  out[AES_BLOCKLEN - 1] = (uint8_t)((in[AES_BLOCKLEN - 1] << 1) ^ (carry * 0x87));
+}
+
+int AES_CMAC_key_init(struct AES_CMAC_key* key, const uint8_t* rawKey, size_t keyLen)
+{
+  uint8_t L[AES_BLOCKLEN];
+
+  if (!AES_key_init(&key->Key, rawKey, keyLen))
+  {
+    return 0;
+  }
+  memset(L, 0, sizeof(L));
+  Cipher((state_t*)L, key->Key.RoundKey, key->Key.Nr);
+  cmac_double(L, key->K1);
+  cmac_double(key->K1, key->K2);
+  return 1;
+}
+
+void AES_CMAC_start(struct AES_CMAC_ctx* ctx, const struct AES_CMAC_key* key)
+{
+  ctx->Key = key;
+  memset(ctx->X, 0, AES_BLOCKLEN);
+  ctx->BlockLen = 0;
+}
+
+// Chains one full block into X.
+static void cmac_block(struct AES_CMAC_ctx* ctx, const uint8_t* block)
+{
+  uint8_t i;
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    ctx->X[i] ^= block[i];
+  }
+  Cipher((state_t*)ctx->X, ctx->Key->Key.RoundKey, ctx->Key->Key.Nr);
+}
+
+void AES_CMAC_update(struct AES_CMAC_ctx* ctx, const uint8_t* msg, size_t length)
+{
+  size_t take;
+
+  if (length == 0)
+  {
+    return;
+  }
+  // The last block gets a subkey, so a full block is only chained once more data follows it
+  if (ctx->BlockLen > 0)
+  {
+    take = AES_BLOCKLEN - ctx->BlockLen;
+    if (take > length)
+    {
+      take = length;
+    }
+    memcpy(ctx->Block + ctx->BlockLen, msg, take);
+    ctx->BlockLen = (uint8_t)(ctx->BlockLen + take);
+    msg += take;
+    length -= take;
+    if (length == 0)
+    {
+      return;
+    }
+    cmac_block(ctx, ctx->Block);
+    ctx->BlockLen = 0;
+  }
+  for (; length > AES_BLOCKLEN; length -= AES_BLOCKLEN, msg += AES_BLOCKLEN)
+  {
+    cmac_block(ctx, msg);
+  }
+  memcpy(ctx->Block, msg, length);
+  ctx->BlockLen = (uint8_t)length;
+}
+
+void AES_CMAC_finish(struct AES_CMAC_ctx* ctx, uint8_t* tag)
+{
+  const uint8_t* subkey = ctx->Key->K1;
+  uint8_t i;
+
+  if (ctx->BlockLen < AES_BLOCKLEN)
+  {
+    // 10* padding of a partial (or empty) last block
+    ctx->Block[ctx->BlockLen] = 0x80;
+    memset(ctx->Block + ctx->BlockLen + 1, 0, AES_BLOCKLEN - ctx->BlockLen - 1);
+    subkey = ctx->Key->K2;
+  }
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    ctx->Block[i] ^= subkey[i];
+  }
+  cmac_block(ctx, ctx->Block);
+  memcpy(tag, ctx->X, AES_CMAC_TAGLEN);
+}
+
+int AES_CMAC_check_tag(struct AES_CMAC_ctx* ctx, const uint8_t* tag)
+{
+  uint8_t computed[AES_CMAC_TAGLEN];
+  uint8_t diff = 0;
+  uint8_t i;
+
+  AES_CMAC_finish(ctx, computed);
+  for (i = 0; i < AES_CMAC_TAGLEN; ++i)
+  {
+    diff |= (uint8_t)(computed[i] ^ tag[i]);
+  }
+  return diff == 0;
+}
+
+void AES_CMAC_buffer(const struct AES_CMAC_key* key, const uint8_t* msg, size_t length, uint8_t* tag)
+{
+  struct AES_CMAC_ctx ctx;
+  AES_CMAC_start(&ctx, key);
+  AES_CMAC_update(&ctx, msg, length);
+  AES_CMAC_finish(&ctx, tag);
+}
+
+int AES_CMAC_verify_buffer(const struct AES_CMAC_key* key, const uint8_t* msg, size_t length, const uint8_t* tag)
+{
+  struct AES_CMAC_ctx ctx;
+  AES_CMAC_start(&ctx, key);
+  AES_CMAC_update(&ctx, msg, length);
+  return AES_CMAC_check_tag(&ctx, tag);
+}
+
+#endif // #if defined(CMAC) && (CMAC == 1)
+
+
+
+/*****************************************************************************/
+/* SIV:                                                                      */
+/*****************************************************************************/
+#if defined(SIV) && (SIV == 1) && defined(CMAC) && (CMAC == 1) && defined(CTR) && (CTR == 1)
+
+int AES_SIV_init_ctx(struct AES_SIV_ctx* ctx, const uint8_t* key, size_t keyLen)
+{
+  size_t half = keyLen / 2;
+
+  if (keyLen != 32 && keyLen != 48 && keyLen != 64)
+  {
+    return 0;
+  }
+  AES_CMAC_key_init(&ctx->MacKey, key, half);
+  AES_key_init(&ctx->CtrKey, key + half, half);
+  return 1;
+}
+
+// S2V of RFC 5297, 2.4, for at most one associated data string followed by the plaintext.
+static void siv_s2v(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aadLen,
+                    const uint8_t* plain, size_t length, uint8_t* V)
+{
+  static const uint8_t zero[AES_BLOCKLEN] = { 0 };
+  struct AES_CMAC_ctx cmac;
+  uint8_t D[AES_BLOCKLEN];
+  uint8_t T[AES_BLOCKLEN];
+  uint8_t i;
+
+  AES_CMAC_buffer(&ctx->MacKey, zero, AES_BLOCKLEN, D);
+  if (aad)
+  {
+    AES_CMAC_buffer(&ctx->MacKey, aad, aadLen, T);
+    cmac_double(D, D);
+    for (i = 0; i < AES_BLOCKLEN; ++i)
+    {
+      D[i] ^= T[i];
+    }
+  }
+
+  AES_CMAC_start(&cmac, &ctx->MacKey);
+  if (length >= AES_BLOCKLEN)
+  {
+    // xorend: D is folded into the last block of the plaintext
+    AES_CMAC_update(&cmac, plain, length - AES_BLOCKLEN);
+    for (i = 0; i < AES_BLOCKLEN; ++i)
+    {
+      T[i] = (uint8_t)(plain[length - AES_BLOCKLEN + i] ^ D[i]);
+    }
+  }
+  else
+  {
+    // dbl(D) xor the 10*-padded plaintext
+    cmac_double(D, T);
+    for (i = 0; i < length; ++i)
+    {
+      T[i] ^= plain[i];
+    }
+    T[length] ^= 0x80;
+  }
+  AES_CMAC_update(&cmac, T, AES_BLOCKLEN);
+  AES_CMAC_finish(&cmac, V);
+}
+
+// The CTR counter is V with the top bit of its last two 32-bit words cleared.
+static void siv_ctr(const struct AES_SIV_ctx* ctx, const uint8_t* V, uint8_t* buf, size_t length)
+{
+  uint8_t Q[AES_BLOCKLEN];
+
+  memcpy(Q, V, AES_BLOCKLEN);
+  Q[8] &= 0x7f;
+  Q[12] &= 0x7f;
+  AES_CTR_xcrypt_buffer_key(&ctx->CtrKey, Q, buf, length);
+}
+
+void AES_SIV_encrypt(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aadLen,
+                     const uint8_t* plain, size_t length, uint8_t* out)
+{
+  uint8_t V[AES_SIV_IVLEN];
+
+  siv_s2v(ctx, aad, aadLen, plain, length, V);
+  memmove(out + AES_SIV_IVLEN, plain, length);
+  memcpy(out, V, AES_SIV_IVLEN);
+  siv_ctr(ctx, V, out + AES_SIV_IVLEN, length);
+}
+
+int AES_SIV_decrypt(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aadLen,
+                    const uint8_t* in, size_t length, uint8_t* plain)
+{
+  uint8_t V[AES_SIV_IVLEN];
+  uint8_t check[AES_SIV_IVLEN];
+  uint8_t diff = 0;
+  uint8_t i;
+
+  if (length < AES_SIV_IVLEN)
+  {
+    return 0;
+  }
+  length -= AES_SIV_IVLEN;
+  memcpy(V, in, AES_SIV_IVLEN);
+  memmove(plain, in + AES_SIV_IVLEN, length);
+  siv_ctr(ctx, V, plain, length);
+
+  siv_s2v(ctx, aad, aadLen, plain, length, check);
+  for (i = 0; i < AES_SIV_IVLEN; ++i)
+  {
+    diff |= (uint8_t)(check[i] ^ V[i]);
+  }
+  if (diff != 0)
+  {
+    memset(plain, 0, length);
+    return 0;
+  }
+  return 1;
+}
+
+#endif // #if defined(SIV) && (SIV == 1) && ...
+
+
+
+/*****************************************************************************/
+/* CTR_DRBG:                                                                 */
+/*****************************************************************************/
+#if defined(DRBG) && (DRBG == 1) && defined(CTR) && (CTR == 1)
+
+#define DRBG_KEYLEN 32
+
+// ctr = ctr + n as a 128-bit big-endian number.
+static void drbg_add(uint8_t* ctr, uint64_t n)
+{
+  int i;
+  for (i = AES_BLOCKLEN - 1; i >= 0 && n != 0; --i)
+  {
+    n += ctr[i];
+    ctr[i] = (uint8_t)n;
+    n >>= 8;
+  }
+}
+
+// Writes the keystream of the blocks V+1, V+2, ... to out and advances V past them.
+static void drbg_keystream(struct AES_DRBG_ctx* ctx, uint8_t* out, size_t length)
+{
+  uint8_t counter[AES_BLOCKLEN];
+
+  memcpy(counter, ctx->V, AES_BLOCKLEN);
+  drbg_add(counter, 1);
+  memset(out, 0, length);
+  AES_CTR_xcrypt_buffer_key(&ctx->Key, counter, out, length);
+  drbg_add(ctx->V, (length + AES_BLOCKLEN - 1) / AES_BLOCKLEN);
+}
+
+// CTR_DRBG_Update: derives a new key and V from the next AES_DRBG_SEEDLEN bytes of keystream,
+// xored with the provided data (NULL for none).
+static void drbg_update(struct AES_DRBG_ctx* ctx, const uint8_t* provided)
+{
+  uint8_t temp[AES_DRBG_SEEDLEN];
+  uint8_t i;
+
+  drbg_keystream(ctx, temp, AES_DRBG_SEEDLEN);
+  if (provided)
+  {
+    for (i = 0; i < AES_DRBG_SEEDLEN; ++i)
+    {
+      temp[i] ^= provided[i];
+    }
+  }
+  // Only the forward schedule is used, so the decryption schedule is not derived
+  KeyExpansion(ctx->Key.RoundKey, temp, DRBG_KEYLEN / 4);
+  ctx->Key.Nr = DRBG_KEYLEN / 4 + 6;
+  memcpy(ctx->V, temp + DRBG_KEYLEN, AES_BLOCKLEN);
+  memset(temp, 0, sizeof(temp));
+}
+
+// Zero pads an optional input to AES_DRBG_SEEDLEN bytes; returns 0 if it is too long.
+static int drbg_pad(uint8_t* padded, const uint8_t* input, size_t length)
+{
+  if (length > AES_DRBG_SEEDLEN)
+  {
+    return 0;
+  }
+  memset(padded, 0, AES_DRBG_SEEDLEN);
+  if (input)
+  {
+    memcpy(padded, input, length);
+  }
+  return 1;
+}
+
+static int drbg_seed(struct AES_DRBG_ctx* ctx, const uint8_t* entropy, const uint8_t* input, size_t inputLen)
+{
+  uint8_t seed[AES_DRBG_SEEDLEN];
+  uint8_t i;
+
+  if (!drbg_pad(seed, input, inputLen))
+  {
+    return 0;
+  }
+  for (i = 0; i < AES_DRBG_SEEDLEN; ++i)
+  {
+    seed[i] ^= entropy[i];
+  }
+  drbg_update(ctx, seed);
+  ctx->ReseedCounter = 1;
+  memset(seed, 0, sizeof(seed));
+  return 1;
+}
+
+int AES_DRBG_init(struct AES_DRBG_ctx* ctx, const uint8_t* entropy, const uint8_t* personalization, size_t personalizationLen)
+{
+  static const uint8_t zeroKey[DRBG_KEYLEN] = { 0 };
+
+  if (personalizationLen > AES_DRBG_SEEDLEN)
+  {
+    return 0;
+  }
+  KeyExpansion(ctx->Key.RoundKey, zeroKey, DRBG_KEYLEN / 4);
+  ctx->Key.Nr = DRBG_KEYLEN / 4 + 6;
+  memset(ctx->V, 0, AES_BLOCKLEN);
+  return drbg_seed(ctx, entropy, personalization, personalizationLen);
+}
+
+int AES_DRBG_reseed(struct AES_DRBG_ctx* ctx, const uint8_t* entropy, const uint8_t* additional, size_t additionalLen)
+{
+  return drbg_seed(ctx, entropy, additional, additionalLen);
+}
+
+int AES_DRBG_generate(struct AES_DRBG_ctx* ctx, uint8_t* out, size_t length, const uint8_t* additional, size_t additionalLen)
+{
+  uint8_t padded[AES_DRBG_SEEDLEN];
+  const uint8_t* provided = NULL;
+
+  if (!drbg_pad(padded, additional, additionalLen))
+  {
+    return 0;
+  }
+  if (additional && additionalLen > 0)
+  {
+    provided = padded;
+  }
+
+  do
+  {
+    size_t request = (length < AES_DRBG_MAX_REQUEST) ? length : AES_DRBG_MAX_REQUEST;
+    if (ctx->ReseedCounter > AES_DRBG_RESEED_INTERVAL)
+    {
+      return 0;
+    }
+    if (provided)
+    {
+      drbg_update(ctx, provided);
+    }
+    drbg_keystream(ctx, out, request);
+    drbg_update(ctx, provided);
+    ctx->ReseedCounter++;
+    provided = NULL;
+    out += request;
+    length -= request;
+  } while (length > 0);
+
+  memset(padded, 0, sizeof(padded));
+  return 1;
+}
+
+void AES_DRBG_clear(struct AES_DRBG_ctx* ctx)
+{
+  volatile uint8_t* p = (volatile uint8_t*)ctx;
+  size_t i;
+  for (i = 0; i < sizeof(*ctx); ++i)
+  {
+    p[i] = 0;
+  }
+}
+
+#endif // #if defined(DRBG) && (DRBG == 1) && ...
+
+
+
+
+#if defined(GCM) && (GCM == 1)
+
+/*
+  GHASH multiplies in GF(2^128) with the bit-reflected convention of NIST SP 800-38D.
+  The portable path uses Shoup's 4-bit tables (16 multiples of H, 256 bytes per key),
+  the x86 path uses PCLMULQDQ with the reduction from Intel's
+  "Carry-Less Multiplication and Its Usage for Computing the GCM Mode" white paper.
+*/
+
+// Reduction of the nibble shifted out of the low end, multiplied by the GCM polynomial
+static const uint64_t gcm_last4[16] = {
+  0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+  0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0 };
+
+static uint64_t load64_be(const uint8_t* p)
+{
+  return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+         ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) | ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+}
+
+static void store64_be(uint8_t* p, uint64_t v)
+{
+  int i;
+  for (i = 7; i >= 0; --i)
+  {
+    p[i] = (uint8_t)v;
+    v >>= 8;
+  }
+}
+
+// Fills HL/HH with i*H for every 4-bit value i.
+static void gcm_gen_table(struct AES_GCM_ctx* ctx)
+{
+  uint64_t vh = load64_be(ctx->H);
+  uint64_t vl = load64_be(ctx->H + 8);
+  int i, j;
+
+  ctx->HL[8] = vl;
+  ctx->HH[8] = vh;
+  ctx->HL[0] = 0;
+  ctx->HH[0] = 0;
+
+  for (i = 4; i > 0; i >>= 1)
+  {
+    uint64_t T = (vl & 1) * 0xe1000000U;
+    vl = (vh << 63) | (vl >> 1);
+    vh = (vh >> 1) ^ (T << 32);
+    ctx->HL[i] = vl;
+    ctx->HH[i] = vh;
+  }
+
+  for (i = 2; i <= 8; i *= 2)
+  {
+    vh = ctx->HH[i];
+    vl = ctx->HL[i];
+    for (j = 1; j < i; ++j)
+    {
+      ctx->HH[i + j] = vh ^ ctx->HH[j];
+      ctx->HL[i + j] = vl ^ ctx->HL[j];
+    }
+  }
+}
+
+// x = x * H using the 4-bit tables, one nibble per step from the last byte to the first.
+static void gcm_mult_table(const struct AES_GCM_ctx* ctx, uint8_t* x)
+{
+  uint8_t lo, hi, rem;
+  uint64_t zh, zl;
+  int i;
+
+  lo = x[15] & 0xf;
+  zh = ctx->HH[lo];
+  zl = ctx->HL[lo];
+
+  for (i = 15; i >= 0; --i)
+  {
+    lo = x[i] & 0xf;
+    hi = (x[i] >> 4) & 0xf;
+
+    if (i != 15)
+    {
+      rem = (uint8_t)zl & 0xf;
+      zl = (zh << 60) | (zl >> 4);
+      zh = (zh >> 4) ^ (gcm_last4[rem] << 48);
+      zh ^= ctx->HH[lo];
+      zl ^= ctx->HL[lo];
+    }
+
+    rem = (uint8_t)zl & 0xf;
+    zl = (zh << 60) | (zl >> 4);
+    zh = (zh >> 4) ^ (gcm_last4[rem] << 48);
+    zh ^= ctx->HH[hi];
+    zl ^= ctx->HL[hi];
+  }
+
+  store64_be(x, zh);
+  store64_be(x + 8, zl);
+}
+
+#if GCM_HAS_CLMUL
+static int cpu_has_clmul(void)
+{
+  const uint32_t ecx = cpuFeaturesEcx();
+  return ((ecx >> 1) & 1) && ((ecx >> 9) & 1); // PCLMULQDQ and SSSE3 (for the byte swap)
+}
+
+// x = x * H with PCLMULQDQ: a schoolbook 256-bit product followed by
+// the shift-and-reduce of the bit-reflected result.
+AES_TARGET("pclmul,ssse3")
+static void gcm_mult_clmul(const uint8_t* H, uint8_t* x)
+{
+  const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)x), bswap);
+  __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)H), bswap);
+  __m128i t2, t3, t4, t5, t6, t7, t8, t9;
+
+  t3 = _mm_clmulepi64_si128(a, b, 0x00);
+  t4 = _mm_clmulepi64_si128(a, b, 0x10);
+  t5 = _mm_clmulepi64_si128(a, b, 0x01);
+  t6 = _mm_clmulepi64_si128(a, b, 0x11);
+
+  t4 = _mm_xor_si128(t4, t5);
+  t5 = _mm_slli_si128(t4, 8);
+  t4 = _mm_srli_si128(t4, 8);
+  t3 = _mm_xor_si128(t3, t5);
+  t6 = _mm_xor_si128(t6, t4);
+
+  // Shift the 256-bit product left by one bit to undo the reflection
+  t7 = _mm_srli_epi32(t3, 31);
+  t8 = _mm_srli_epi32(t6, 31);
+  t3 = _mm_slli_epi32(t3, 1);
+  t6 = _mm_slli_epi32(t6, 1);
+  t9 = _mm_srli_si128(t7, 12);
+  t8 = _mm_slli_si128(t8, 4);
+  t7 = _mm_slli_si128(t7, 4);
+  t3 = _mm_or_si128(t3, t7);
+  t6 = _mm_or_si128(t6, t8);
+  t6 = _mm_or_si128(t6, t9);
+
+  // Reduce modulo x^128 + x^7 + x^2 + x + 1
+  t7 = _mm_slli_epi32(t3, 31);
+  t8 = _mm_slli_epi32(t3, 30);
+  t9 = _mm_slli_epi32(t3, 25);
+  t7 = _mm_xor_si128(t7, t8);
+  t7 = _mm_xor_si128(t7, t9);
+  t8 = _mm_srli_si128(t7, 4);
+  t7 = _mm_slli_si128(t7, 12);
+  t3 = _mm_xor_si128(t3, t7);
+
+  t2 = _mm_srli_epi32(t3, 1);
+  t4 = _mm_srli_epi32(t3, 2);
+  t5 = _mm_srli_epi32(t3, 7);
+  t2 = _mm_xor_si128(t2, t4);
+  t2 = _mm_xor_si128(t2, t5);
+  t2 = _mm_xor_si128(t2, t8);
+  t3 = _mm_xor_si128(t3, t2);
+  t6 = _mm_xor_si128(t6, t3);
+
+  _mm_storeu_si128((__m128i*)x, _mm_shuffle_epi8(t6, bswap));
+}
+#endif // #if GCM_HAS_CLMUL
+
+static void gcm_mult(const struct AES_GCM_ctx* ctx, uint8_t* x)
+{
+#if GCM_HAS_CLMUL
+  if (ctx->UseClmul)
+  {
+    gcm_mult_clmul(ctx->H, x);
+    return;
+  }
+#endif
+  gcm_mult_table(ctx, x);
+}
+
+// Increments the rightmost 32 bits of the counter block, as GCM's inc32() does.
+static void gcm_inc32(uint8_t* counter)
+{
+  int i;
+  for (i = AES_BLOCKLEN - 1; i >= AES_BLOCKLEN - 4; --i)
+  {
+    if (++counter[i] != 0)
+    {
+      break;
+    }
+  }
+}
+
+// Pads the last partial AAD block before the first byte of text is hashed.
+static void gcm_close_aad(struct AES_GCM_ctx* ctx)
+{
+  if (!ctx->AadClosed)
+  {
+    if ((ctx->AadLen % AES_BLOCKLEN) != 0)
+    {
+      gcm_mult(ctx, ctx->Xi);
+    }
+    ctx->AadClosed = 1;
+  }
+}
+
+// Encrypts or decrypts and hashes the ciphertext in the same pass over buf.
+static void gcm_crypt(struct AES_GCM_ctx* ctx, uint8_t* buf, size_t length, int decrypt)
+{
+  uint8_t i;
+  gcm_close_aad(ctx);
+
+  while (length > 0)
+  {
+    if (ctx->KeyStreamUsed == AES_BLOCKLEN)
+    {
+      memcpy(ctx->KeyStream, ctx->Counter, AES_BLOCKLEN);
+      Cipher((state_t*)ctx->KeyStream, ctx->Aes.RoundKey, ctx->Aes.Nr);
+      gcm_inc32(ctx->Counter);
+      ctx->KeyStreamUsed = 0;
+
+      if (length >= AES_BLOCKLEN) /* whole block, keystream and GHASH are block aligned */
+      {
+        for (i = 0; i < AES_BLOCKLEN; ++i)
+        {
+          const uint8_t c = decrypt ? buf[i] : (uint8_t)(buf[i] ^ ctx->KeyStream[i]);
+          buf[i] ^= ctx->KeyStream[i];
+          ctx->Xi[i] ^= c;
+        }
+        gcm_mult(ctx, ctx->Xi);
+        ctx->KeyStreamUsed = AES_BLOCKLEN;
+        ctx->TextLen += AES_BLOCKLEN;
+        buf += AES_BLOCKLEN;
+        length -= AES_BLOCKLEN;
+        continue;
+      }
+    }
+
+    {
+      const uint8_t c = decrypt ? *buf : (uint8_t)(*buf ^ ctx->KeyStream[ctx->KeyStreamUsed]);
+      *buf ^= ctx->KeyStream[ctx->KeyStreamUsed++];
+      ctx->Xi[ctx->TextLen % AES_BLOCKLEN] ^= c;
+      if ((++ctx->TextLen % AES_BLOCKLEN) == 0)
+      {
+        gcm_mult(ctx, ctx->Xi);
+      }
+      ++buf;
+      --length;
+    }
+  }
+}
+
+int AES_GCM_init_ctx_keylen(struct AES_GCM_ctx* ctx, const uint8_t* key, size_t keyLen)
+{
+  if (!AES_init_ctx_keylen(&ctx->Aes, key, keyLen))
+  {
+    return 0;
+  }
+  memset(ctx->H, 0, AES_BLOCKLEN);
+  Cipher((state_t*)ctx->H, ctx->Aes.RoundKey, ctx->Aes.Nr);
+  gcm_gen_table(ctx);
+#if GCM_HAS_CLMUL
+  ctx->UseClmul = (uint8_t)cpu_has_clmul();
+#else
+  ctx->UseClmul = 0;
+#endif
+  return 1;
+}
+
+void AES_GCM_init_ctx(struct AES_GCM_ctx* ctx, const uint8_t* key)
+{
+  AES_GCM_init_ctx_keylen(ctx, key, AES_KEYLEN);
+}
+
+void AES_GCM_start(struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t ivLen)
+{
+  size_t i;
+  memset(ctx->Xi, 0, AES_BLOCKLEN);
+  ctx->AadLen = 0;
+  ctx->TextLen = 0;
+  ctx->AadClosed = 0;
+  ctx->KeyStreamUsed = AES_BLOCKLEN;
+
+  if (ivLen == AES_GCM_IVLEN)
+  {
+    // J0 = IV || 0^31 || 1
+    memcpy(ctx->J0, iv, AES_GCM_IVLEN);
+    memset(ctx->J0 + AES_GCM_IVLEN, 0, AES_BLOCKLEN - AES_GCM_IVLEN);
+    ctx->J0[AES_BLOCKLEN - 1] = 1;
+  }
+  else
+  {
+    // J0 = GHASH(IV || 0^s || 0^64 || [len(IV)]_64)
+    uint8_t lenBlock[AES_BLOCKLEN];
+    memset(ctx->J0, 0, AES_BLOCKLEN);
+    for (i = 0; i < ivLen; ++i)
+    {
+      ctx->J0[i % AES_BLOCKLEN] ^= iv[i];
+      if ((i % AES_BLOCKLEN) == AES_BLOCKLEN - 1)
+      {
+        gcm_mult(ctx, ctx->J0);
+      }
+    }
+    if ((ivLen % AES_BLOCKLEN) != 0)
+    {
+      gcm_mult(ctx, ctx->J0);
+    }
+    memset(lenBlock, 0, 8);
+    store64_be(lenBlock + 8, (uint64_t)ivLen * 8);
+    for (i = 0; i < AES_BLOCKLEN; ++i)
+    {
+      ctx->J0[i] ^= lenBlock[i];
+    }
+    gcm_mult(ctx, ctx->J0);
+  }
+
+  memcpy(ctx->Counter, ctx->J0, AES_BLOCKLEN);
+  gcm_inc32(ctx->Counter);
+}
+
+void AES_GCM_update_aad(struct AES_GCM_ctx* ctx, const uint8_t* aad, size_t length)
+{
+  size_t i;
+  for (i = 0; i < length; ++i)
+  {
+    ctx->Xi[ctx->AadLen % AES_BLOCKLEN] ^= aad[i];
+    if ((++ctx->AadLen % AES_BLOCKLEN) == 0)
+    {
+      gcm_mult(ctx, ctx->Xi);
+    }
+  }
+}
+
+void AES_GCM_encrypt_update(struct AES_GCM_ctx* ctx, uint8_t* buf, size_t length)
+{
+  gcm_crypt(ctx, buf, length, 0);
+}
+
+void AES_GCM_decrypt_update(struct AES_GCM_ctx* ctx, uint8_t* buf, size_t length)
+{
+  gcm_crypt(ctx, buf, length, 1);
+}
+
+void AES_GCM_finish(struct AES_GCM_ctx* ctx, uint8_t* tag)
+{
+  uint8_t lenBlock[AES_BLOCKLEN];
+  uint8_t i;
+
+  gcm_close_aad(ctx);
+  if ((ctx->TextLen % AES_BLOCKLEN) != 0)
+  {
+    gcm_mult(ctx, ctx->Xi);
+  }
+
+  // S = GHASH(A || C || [len(A)]_64 || [len(C)]_64), T = E(K, J0) ^ S
+  store64_be(lenBlock, ctx->AadLen * 8);
+  store64_be(lenBlock + 8, ctx->TextLen * 8);
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    ctx->Xi[i] ^= lenBlock[i];
+  }
+  gcm_mult(ctx, ctx->Xi);
+
+  memcpy(tag, ctx->J0, AES_BLOCKLEN);
+  Cipher((state_t*)tag, ctx->Aes.RoundKey, ctx->Aes.Nr);
+  for (i = 0; i < AES_GCM_TAGLEN; ++i)
+  {
+    tag[i] ^= ctx->Xi[i];
+  }
+}
+
+int AES_GCM_check_tag(struct AES_GCM_ctx* ctx, const uint8_t* tag)
+{
+  uint8_t computed[AES_GCM_TAGLEN];
+  uint8_t diff = 0;
+  uint8_t i;
+
+  AES_GCM_finish(ctx, computed);
+  for (i = 0; i < AES_GCM_TAGLEN; ++i)
+  {
+    diff |= (uint8_t)(computed[i] ^ tag[i]);
+  }
+  return diff == 0;
+}
+
+void AES_GCM_encrypt_buffer(struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t ivLen,
+                            const uint8_t* aad, size_t aadLen, uint8_t* buf, size_t length, uint8_t* tag)
+{
+  AES_GCM_start(ctx, iv, ivLen);
+  AES_GCM_update_aad(ctx, aad, aadLen);
+  gcm_crypt(ctx, buf, length, 0);
+  AES_GCM_finish(ctx, tag);
+}
+
+int AES_GCM_decrypt_buffer(struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t ivLen,
+                           const uint8_t* aad, size_t aadLen, uint8_t* buf, size_t length, const uint8_t* tag)
+{
+  AES_GCM_start(ctx, iv, ivLen);
+  AES_GCM_update_aad(ctx, aad, aadLen);
+  gcm_crypt(ctx, buf, length, 1);
+  if (!AES_GCM_check_tag(ctx, tag))
+  {
+    memset(buf, 0, length);
+    return 0;
+  }
+  return 1;
+}
+
+#endif // #if defined(GCM) && (GCM == 1)
@@ -0,0 +1,249 @@
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "benchmarkUtility.h"
+#include "../../aes/header/aes.h"
+
+static const uint8_t BENCH_KEY[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+static const uint8_t BENCH_IV[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+
+static const size_t GCM_SIZES[] = { 16, 64, 256, 1024, 4096, 16384, 65536 };
+static const size_t MODE_SIZES[] = { 16, 256, 4096, 65536, 1 << 20, 16 << 20, 64 << 20 };
+
+/**
+ * @brief One way of driving the block cipher, measured for every mode and buffer size.
+ *
+ * Each entry point processes a whole buffer whose length is a multiple of AES_BLOCKLEN. An entry point may be
+ * missing when the backend only covers some modes. CTR picks its block loop through the multi-buffer backend, so
+ * each row also fixes that backend.
+ */
+struct AesBackend {
+	const char* name;
+	void (*ecbEncrypt)(uint8_t* buf, size_t length);
+	void (*ecbDecrypt)(uint8_t* buf, size_t length);
+	void (*cbcEncrypt)(uint8_t* buf, size_t length);
+	void (*cbcDecrypt)(uint8_t* buf, size_t length);
+	void (*ctrXcrypt)(uint8_t* buf, size_t length);
+	int jobsBackend;
+};
+
+static struct AES_ctx benchCtx;
+static struct AES_key benchKey;
+
+// Context backend: the original AES_ctx API, decryption runs the inverse cipher on the encryption schedule
+static void ctxEcbEncrypt(uint8_t* buf, size_t length) {
+	for (size_t i = 0; i < length; i += AES_BLOCKLEN) {
+		AES_ECB_encrypt(&benchCtx, buf + i);
+	}
+}
+static void ctxEcbDecrypt(uint8_t* buf, size_t length) {
+	for (size_t i = 0; i < length; i += AES_BLOCKLEN) {
+		AES_ECB_decrypt(&benchCtx, buf + i);
+	}
+}
+static void ctxCbcEncrypt(uint8_t* buf, size_t length) {
+	AES_ctx_set_iv(&benchCtx, BENCH_IV);
+	AES_CBC_encrypt_buffer(&benchCtx, buf, length);
+}
+static void ctxCbcDecrypt(uint8_t* buf, size_t length) {
+	AES_ctx_set_iv(&benchCtx, BENCH_IV);
+	AES_CBC_decrypt_buffer(&benchCtx, buf, length);
+}
+static void ctxCtrXcrypt(uint8_t* buf, size_t length) {
+	AES_ctx_set_iv(&benchCtx, BENCH_IV);
+	AES_CTR_xcrypt_buffer(&benchCtx, buf, length);
+}
+
+// Key-handle backend: decryption runs the equivalent inverse cipher on the precomputed schedule
+static void keyEcbEncrypt(uint8_t* buf, size_t length) {
+	for (size_t i = 0; i < length; i += AES_BLOCKLEN) {
+		AES_ECB_encrypt_key(&benchKey, buf + i);
+	}
+}
+static void keyEcbDecrypt(uint8_t* buf, size_t length) {
+	for (size_t i = 0; i < length; i += AES_BLOCKLEN) {
+		AES_ECB_decrypt_key(&benchKey, buf + i);
+	}
+}
+static void keyCbcEncrypt(uint8_t* buf, size_t length) {
+	uint8_t iv[AES_BLOCKLEN];
+	memcpy(iv, BENCH_IV, sizeof(iv));
+	AES_CBC_encrypt_buffer_key(&benchKey, iv, buf, length);
+}
+static void keyCbcDecrypt(uint8_t* buf, size_t length) {
+	uint8_t iv[AES_BLOCKLEN];
+	memcpy(iv, BENCH_IV, sizeof(iv));
+	AES_CBC_decrypt_buffer_key(&benchKey, iv, buf, length);
+}
+static void keyCtrXcrypt(uint8_t* buf, size_t length) {
+	uint8_t iv[AES_BLOCKLEN];
+	memcpy(iv, BENCH_IV, sizeof(iv));
+	AES_CTR_xcrypt_buffer_key(&benchKey, iv, buf, length);
+}
+
+static const AesBackend BACKENDS[] = {
+	{ "context", ctxEcbEncrypt, ctxEcbDecrypt, ctxCbcEncrypt, ctxCbcDecrypt, ctxCtrXcrypt, AES_BACKEND_PORTABLE },
+	{ "key handle", keyEcbEncrypt, keyEcbDecrypt, keyCbcEncrypt, keyCbcDecrypt, keyCtrXcrypt, AES_BACKEND_PORTABLE },
+	{ "AES-NI", nullptr, nullptr, nullptr, nullptr, keyCtrXcrypt, AES_BACKEND_AESNI },
+};
+
+TEST(AesBenchmark, ModesAcrossSizes) {
+	const int detected = AES_jobs_backend();
+	AES_init_ctx_iv(&benchCtx, BENCH_KEY, BENCH_IV);
+	ASSERT_EQ(AES_key_init(&benchKey, BENCH_KEY, sizeof(BENCH_KEY)), 1);
+
+	for (const AesBackend& backend : BACKENDS) {
+		if (!AES_jobs_set_backend(backend.jobsBackend)) {
+			printf("-- backend: %s (not available)\n", backend.name);
+			continue;
+		}
+		printf("-- backend: %s\n", backend.name);
+		const struct {
+			const char* name;
+			void (*fn)(uint8_t*, size_t);
+		} modes[] = {
+			{ "ECB encrypt", backend.ecbEncrypt },
+			{ "ECB decrypt", backend.ecbDecrypt },
+			{ "CBC encrypt", backend.cbcEncrypt },
+			{ "CBC decrypt", backend.cbcDecrypt },
+			{ "CTR xcrypt", backend.ctrXcrypt },
+		};
+		for (size_t size : MODE_SIZES) {
+			std::vector<uint8_t> buf(size, 0x5a);
+			for (const auto& mode : modes) {
+				if (!mode.fn) {
+					continue;
+				}
+				benchmarkPrintBytes(mode.name, size, benchmarkMeasure([&]() {
+					mode.fn(buf.data(), buf.size());
+				}));
+			}
+		}
+	}
+	AES_jobs_set_backend(detected);
+}
+
+TEST(AesBenchmark, GcmVersusCtr) {
+	// GCM runs its CTR on the portable cipher, so compare it with portable CTR
+	const int detected = AES_jobs_backend();
+	ASSERT_TRUE(AES_jobs_set_backend(AES_BACKEND_PORTABLE));
+	for (size_t size : GCM_SIZES) {
+		std::vector<uint8_t> buf(size, 0x5a);
+		uint8_t tag[AES_GCM_TAGLEN];
+
+		struct AES_ctx ctr;
+		AES_init_ctx_iv(&ctr, BENCH_KEY, BENCH_IV);
+		benchmarkPrintBytes("CTR", size, benchmarkMeasure([&]() {
+			AES_ctx_set_iv(&ctr, BENCH_IV);
+			AES_CTR_xcrypt_buffer(&ctr, buf.data(), buf.size());
+		}));
+
+		struct AES_GCM_ctx gcm;
+		AES_GCM_init_ctx(&gcm, BENCH_KEY);
+		const uint8_t detected = gcm.UseClmul;
+
+		gcm.UseClmul = 0;
+		benchmarkPrintBytes("GCM (table GHASH)", size, benchmarkMeasure([&]() {
+			AES_GCM_encrypt_buffer(&gcm, BENCH_IV, AES_GCM_IVLEN, nullptr, 0, buf.data(), buf.size(), tag);
+		}));
+
+		if (detected) {
+			gcm.UseClmul = 1;
+			benchmarkPrintBytes("GCM (PCLMULQDQ GHASH)", size, benchmarkMeasure([&]() {
+				AES_GCM_encrypt_buffer(&gcm, BENCH_IV, AES_GCM_IVLEN, nullptr, 0, buf.data(), buf.size(), tag);
+			}));
+		}
+	}
+	AES_jobs_set_backend(detected);
+}
+
+static const size_t RECORD_SIZES[] = { 64, 256, 1024 };
+
+TEST(AesBenchmark, MultiBufferRecords) {
+	const size_t records = 1024;
+	const int detected = AES_jobs_backend();
+	struct AES_key key;
+	ASSERT_EQ(AES_key_init(&key, BENCH_KEY, sizeof(BENCH_KEY)), 1);
+
+	for (size_t size : RECORD_SIZES) {
+		std::vector<uint8_t> data(records * size, 0x5a);
+		std::vector<uint8_t> ivs(records * AES_BLOCKLEN);
+		std::vector<AES_job> jobs(records);
+		for (size_t i = 0; i < records; ++i) {
+			jobs[i].Key = &key;
+			jobs[i].Iv = &ivs[i * AES_BLOCKLEN];
+			jobs[i].Buf = &data[i * size];
+			jobs[i].Length = size;
+		}
+		printf("-- %zu records of %zu B, bytes are the total per call\n", records, size);
+
+		benchmarkPrintBytes("CBC encrypt, one record at a time", data.size(), benchmarkMeasure([&]() {
+			for (size_t i = 0; i < records; ++i) {
+				memcpy(jobs[i].Iv, BENCH_IV, AES_BLOCKLEN);
+				AES_CBC_encrypt_buffer_key(&key, jobs[i].Iv, jobs[i].Buf, jobs[i].Length);
+			}
+		}));
+
+		const char* names[] = { "CBC encrypt jobs (portable)", "CBC encrypt jobs (AES-NI)" };
+		const char* ctrNames[] = { "CTR jobs (portable)", "CTR jobs (AES-NI)" };
+		for (int backend = AES_BACKEND_PORTABLE; backend <= AES_BACKEND_AESNI; ++backend) {
+			if (!AES_jobs_set_backend(backend)) {
+				continue;
+			}
+			benchmarkPrintBytes(names[backend], data.size(), benchmarkMeasure([&]() {
+				for (size_t i = 0; i < records; ++i) {
+					memcpy(jobs[i].Iv, BENCH_IV, AES_BLOCKLEN);
+				}
+				AES_CBC_encrypt_jobs(jobs.data(), jobs.size());
+			}));
+			benchmarkPrintBytes(ctrNames[backend], data.size(), benchmarkMeasure([&]() {
+				for (size_t i = 0; i < records; ++i) {
+					memcpy(jobs[i].Iv, BENCH_IV, AES_BLOCKLEN);
+				}
+				AES_CTR_xcrypt_jobs(jobs.data(), jobs.size());
+			}));
+		}
+	}
+	AES_jobs_set_backend(detected);
+}
+
+static const size_t DRBG_SIZES[] = { 16, 1024, 65536, 1 << 20, 16 << 20 };
+
+TEST(AesBenchmark, DrbgVersusRandAndUrandom) {
+	const int detected = AES_jobs_backend();
+	std::vector<uint8_t> entropy(AES_DRBG_SEEDLEN, 0x42);
+	struct AES_DRBG_ctx drbg;
+	ASSERT_EQ(AES_DRBG_init(&drbg, entropy.data(), nullptr, 0), 1);
+
+	for (size_t size : DRBG_SIZES) {
+		std::vector<uint8_t> out(size);
+
+		benchmarkPrintBytes("rand()", size, benchmarkMeasure([&]() {
+			for (size_t i = 0; i < size; ++i) {
+				out[i] = (uint8_t)rand();
+			}
+		}));
+
+#ifndef _WIN32
+		FILE* urandom = fopen("/dev/urandom", "rb");
+		if (urandom) {
+			benchmarkPrintBytes("/dev/urandom", size, benchmarkMeasure([&]() {
+				ASSERT_EQ(fread(out.data(), 1, size, urandom), size);
+			}));
+			fclose(urandom);
+		}
+#endif
+
+		const char* names[] = { "CTR_DRBG (portable)", "CTR_DRBG (AES-NI)" };
+		for (int backend = AES_BACKEND_PORTABLE; backend <= AES_BACKEND_AESNI; ++backend) {
+			if (!AES_jobs_set_backend(backend)) {
+				continue;
+			}
+			benchmarkPrintBytes(names[backend], size, benchmarkMeasure([&]() {
+				AES_DRBG_generate(&drbg, out.data(), size, nullptr, 0);
+			}));
+		}
+	}
+	AES_jobs_set_backend(detected);
+}
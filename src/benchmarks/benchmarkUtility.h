@@ -0,0 +1,103 @@
+/**
+ * @file benchmarkUtility.h
+ * @brief Timing helpers shared by the offline benchmark executables.
+ */
+
+#ifndef BENCHMARK_UTILITY_H
+#define BENCHMARK_UTILITY_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Reads the CPU time-stamp counter.
+ *
+ * @return uint64_t The current cycle count, or 0 on targets without a readable counter.
+ */
+inline uint64_t benchmarkCycles() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/**
+ * @brief Result of a single measurement: best-of-N cycles and seconds per call.
+ */
+struct BenchmarkResult {
+	double cycles;   /**< Cycles per call (0 when no cycle counter is available) */
+	double seconds;  /**< Wall-clock seconds per call */
+};
+
+/**
+ * @brief Measures a callable, keeping the fastest of several repetitions.
+ *
+ * The callable is run until at least @p minSeconds of wall-clock time has passed, split into
+ * @p repetitions rounds; the best round is reported to filter out scheduler noise.
+ *
+ * @param fn The code under test.
+ * @param minSeconds Total time budget for the measurement.
+ * @param repetitions Number of rounds the budget is split into.
+ * @return BenchmarkResult Best cycles and seconds per call.
+ */
+template <typename Fn>
+BenchmarkResult benchmarkMeasure(Fn fn, double minSeconds = 0.2, int repetitions = 5) {
+	typedef std::chrono::steady_clock Clock;
+	BenchmarkResult best = { 0.0, 0.0 };
+	const double roundSeconds = minSeconds / repetitions;
+
+	fn(); // warm up caches and lazy initialisation
+
+	for (int r = 0; r < repetitions; ++r) {
+		long calls = 0;
+		const uint64_t c0 = benchmarkCycles();
+		const Clock::time_point t0 = Clock::now();
+		double elapsed = 0.0;
+		do {
+			fn();
+			++calls;
+			elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+		} while (elapsed < roundSeconds);
+		const uint64_t c1 = benchmarkCycles();
+
+		BenchmarkResult round = { (double)(c1 - c0) / calls, elapsed / calls };
+		if (r == 0 || round.seconds < best.seconds) {
+			best = round;
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Prints one benchmark row with throughput figures for a byte-oriented workload.
+ *
+ * @param name Name of the measured case.
+ * @param bytes Bytes processed per call.
+ * @param result Measurement returned by benchmarkMeasure.
+ */
+inline void benchmarkPrintBytes(const char* name, size_t bytes, const BenchmarkResult& result) {
+	printf("%-36s %10zu B %10.2f cycles/B %10.1f MB/s\n", name, bytes,
+	       result.cycles / (double)bytes, (double)bytes / result.seconds / 1e6);
+}
+
+/**
+ * @brief Prints one benchmark row with throughput figures for a workload counted in items, such as graph edges.
+ *
+ * @param name Name of the measured case.
+ * @param items Items processed per call.
+ * @param unit Name of the item, printed after the rate.
+ * @param result Measurement returned by benchmarkMeasure.
+ */
+inline void benchmarkPrintItems(const char* name, size_t items, const char* unit, const BenchmarkResult& result) {
+	printf("%-36s %10.2f ms %10.1f M%s/s\n", name, result.seconds * 1e3, (double)items / result.seconds / 1e6, unit);
+}
+
+#endif // BENCHMARK_UTILITY_H
@@ -0,0 +1,30 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include "benchmarkUtility.h"
+#include "../../chacha/header/chacha.h"
+
+static const uint8_t BENCH_KEY[CHACHA20_KEYLEN] = {
+	0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+	0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f };
+static const uint8_t BENCH_IV[CHACHA20_POLY1305_IVLEN] = { 0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47 };
+
+static const size_t SIZES[] = { 16, 64, 256, 1024, 4096, 16384, 65536, 1 << 20 };
+
+TEST(ChachaBenchmark, SimdPaths) {
+	static const char* NAMES[] = { "ChaCha20-Poly1305 (portable)", "ChaCha20-Poly1305 (SSE2 x4)", "ChaCha20-Poly1305 (AVX2 x8)" };
+	struct CHACHA20_POLY1305_ctx ctx;
+	CHACHA20_POLY1305_init_ctx(&ctx, BENCH_KEY);
+	const uint8_t detected = ctx.Simd;
+
+	for (size_t size : SIZES) {
+		std::vector<uint8_t> buf(size, 0x5a);
+		uint8_t tag[CHACHA20_POLY1305_TAGLEN];
+
+		for (uint8_t simd = CHACHA_SIMD_NONE; simd <= detected; ++simd) {
+			ctx.Simd = simd;
+			benchmarkPrintBytes(NAMES[simd], size, benchmarkMeasure([&]() {
+				CHACHA20_POLY1305_encrypt_buffer(&ctx, BENCH_IV, CHACHA20_POLY1305_IVLEN, nullptr, 0, buf.data(), buf.size(), tag);
+			}));
+		}
+	}
+}
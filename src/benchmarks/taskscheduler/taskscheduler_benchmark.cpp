@@ -0,0 +1,214 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "benchmarkUtility.h"
+#include "Taskscheduler.h"
+
+extern TaskGraph taskGraph;
+
+static const int GRAPH_TASKS = 1000000;        // tasks of the synthetic dependency graphs
+static const int GRAPH_DEPENDENCIES = 10;      // dependencies per task, 10M edges in total
+
+/**
+ * @brief Builds a synthetic dependency graph of taskCount tasks in the global task graph.
+ *
+ * Every task but the first depends on GRAPH_DEPENDENCIES earlier tasks. With skewed set, the earlier task is
+ * drawn with a quadratic bias towards low ids, which gives a few heavily shared tasks like a real backlog has.
+ * A share of the dependencies may be drawn from all tasks instead, which closes cycles.
+ *
+ * @param taskCount Number of tasks, with ids 1 to taskCount.
+ * @param skewed Draw dependencies with a bias towards low ids instead of uniformly.
+ * @param cyclicPercent Percentage of dependencies drawn from all tasks rather than from earlier ones.
+ */
+static void buildSyntheticGraph(int taskCount, bool skewed, int cyclicPercent) {
+	std::vector<int> taskIds(taskCount);
+	std::vector<Edge> dependencies;
+	dependencies.reserve((size_t)taskCount * GRAPH_DEPENDENCIES);
+	uint64_t seed = 0x9e3779b97f4a7c15ULL;
+
+	for (int id = 1; id <= taskCount; id++) {
+		taskIds[id - 1] = id;
+		for (int k = 0; id > 1 && k < GRAPH_DEPENDENCIES; k++) {
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			double r = (double)(seed >> 11) / 9007199254740992.0;
+			int range = (int)(seed >> 40) % 100 < cyclicPercent ? taskCount : id - 1;
+			int dep = 1 + (int)((skewed ? r * r : r) * range);
+			dependencies.push_back({ id, dep, id + dep });
+		}
+	}
+
+	buildTaskGraph(taskIds, dependencies, &taskGraph);
+}
+
+TEST(TaskschedulerBenchmark, DirectionOptimizingBfs) {
+	static const char* NAMES[] = { "uniform", "skewed" };
+	int hardwareThreads = (int)std::thread::hardware_concurrency();
+	char name[64];
+
+	for (int shape = 0; shape < 2; shape++) {
+		buildSyntheticGraph(GRAPH_TASKS, shape == 1, 0);
+		size_t edges = taskGraph.targets.size() / 2;
+		ASSERT_EQ(BFS(GRAPH_TASKS), directionOptimizingBFS(taskGraph, GRAPH_TASKS, 0, nullptr));
+
+		snprintf(name, sizeof(name), "BFS queue (%s)", NAMES[shape]);
+		benchmarkPrintItems(name, edges, "edges", benchmarkMeasure([&]() {
+			BFS(GRAPH_TASKS);
+		}, 1.0, 3));
+
+		for (int threads = 1; threads <= hardwareThreads; threads *= 2) {
+			snprintf(name, sizeof(name), "BFS direction-opt x%d (%s)", threads, NAMES[shape]);
+			benchmarkPrintItems(name, edges, "edges", benchmarkMeasure([&]() {
+				directionOptimizingBFS(taskGraph, GRAPH_TASKS, threads, nullptr);
+			}, 1.0, 3));
+		}
+	}
+}
+
+TEST(TaskschedulerBenchmark, ParallelScc) {
+	static const int CYCLIC_PERCENT[] = { 1, 10 };
+	int hardwareThreads = (int)std::thread::hardware_concurrency();
+	std::vector<int> components;
+	char name[64];
+
+	for (int cyclicPercent : CYCLIC_PERCENT) {
+		buildSyntheticGraph(GRAPH_TASKS, false, cyclicPercent);
+		size_t arcs = taskGraph.depTargets.size();
+		int count = findStronglyConnectedComponents(taskGraph, &components);
+		printf("%d%% cyclic dependencies: %d components\n", cyclicPercent, count);
+
+		BenchmarkResult tarjan = benchmarkMeasure([&]() {
+			findStronglyConnectedComponents(taskGraph, &components);
+		}, 1.0, 3);
+		benchmarkPrintItems("SCC Pearce (sequential)", arcs, "arcs", tarjan);
+
+		// The sequential search is the one-thread figure; two threads are measured even on one core
+		for (int threads = 2; threads <= std::max(2, hardwareThreads); threads *= 2) {
+			ASSERT_EQ(parallelStronglyConnectedComponents(taskGraph, threads, &components), count);
+			BenchmarkResult parallel = benchmarkMeasure([&]() {
+				parallelStronglyConnectedComponents(taskGraph, threads, &components);
+			}, 1.0, 3);
+			snprintf(name, sizeof(name), "SCC trim + FW-BW x%d", threads);
+			benchmarkPrintItems(name, arcs, "arcs", parallel);
+			printf("%-36s %10.2fx\n", "  speedup over sequential", tarjan.seconds / parallel.seconds);
+		}
+	}
+}
+
+TEST(TaskschedulerBenchmark, ExecuteTaskGraph) {
+	static const char* NAMES[] = { "wide", "deep", "random" };
+	int hardwareThreads = (int)std::thread::hardware_concurrency();
+	std::atomic<long long> checksum(0);
+	char name[64];
+
+	for (int shape = 0; shape < 3; shape++) {
+		if (shape == 2) {
+			buildSyntheticGraph(GRAPH_TASKS, false, 0);
+		}
+		else {
+			// Wide: every task waits for task 1 only; deep: every task waits for the one before it
+			std::vector<int> taskIds(GRAPH_TASKS);
+			std::vector<Edge> dependencies;
+			for (int id = 1; id <= GRAPH_TASKS; id++) {
+				taskIds[id - 1] = id;
+				if (id > 1) {
+					int dep = shape == 0 ? 1 : id - 1;
+					dependencies.push_back({ id, dep, id + dep });
+				}
+			}
+			buildTaskGraph(taskIds, dependencies, &taskGraph);
+		}
+
+		for (int threads = 1; threads <= std::max(2, hardwareThreads); threads *= 2) {
+			ASSERT_EQ(executeTaskGraph(taskGraph, threads, [&](int taskId) {
+				checksum.fetch_add(taskId, std::memory_order_relaxed);
+			}), GRAPH_TASKS);
+			snprintf(name, sizeof(name), "Execute x%d (%s)", threads, NAMES[shape]);
+			benchmarkPrintItems(name, GRAPH_TASKS, "tasks", benchmarkMeasure([&]() {
+				executeTaskGraph(taskGraph, threads, [&](int taskId) {
+					checksum.fetch_add(taskId, std::memory_order_relaxed);
+				});
+			}, 1.0, 3));
+		}
+	}
+	EXPECT_GT(checksum.load(), 0);
+}
+
+TEST(TaskschedulerBenchmark, MinimumSpanningForest) {
+	int hardwareThreads = (int)std::thread::hardware_concurrency();
+	std::vector<Edge> forest;
+	char name[64];
+
+	buildSyntheticGraph(GRAPH_TASKS, false, 0);
+	size_t edges = taskGraph.targets.size() / 2;
+	long long weight = kruskalForest(taskGraph, GRAPH_TASKS, &forest);
+
+	benchmarkPrintItems("MSF Kruskal (radix sort)", edges, "edges", benchmarkMeasure([&]() {
+		kruskalForest(taskGraph, GRAPH_TASKS, &forest);
+	}, 1.0, 3));
+
+	for (int threads = 1; threads <= std::max(2, hardwareThreads); threads *= 2) {
+		ASSERT_EQ(boruvkaMST(taskGraph, threads, &forest), weight);
+		snprintf(name, sizeof(name), "MSF Boruvka x%d", threads);
+		benchmarkPrintItems(name, edges, "edges", benchmarkMeasure([&]() {
+			boruvkaMST(taskGraph, threads, &forest);
+		}, 1.0, 3));
+	}
+}
+
+TEST(TaskschedulerBenchmark, DeltaStepping) {
+	int hardwareThreads = (int)std::thread::hardware_concurrency();
+	std::vector<int> expected;
+	std::vector<int> dist;
+	char name[64];
+
+	buildSyntheticGraph(GRAPH_TASKS, false, 0);
+	size_t edges = taskGraph.targets.size() / 2;
+	dijkstraDistances(taskGraph, 1, &expected);
+
+	BenchmarkResult dijkstra = benchmarkMeasure([&]() {
+		dijkstraDistances(taskGraph, 1, &dist);
+	}, 1.0, 3);
+	benchmarkPrintItems("SSSP Dijkstra (sequential)", edges, "edges", dijkstra);
+
+	for (int threads = 1; threads <= std::max(2, hardwareThreads); threads *= 2) {
+		deltaSteppingDistances(taskGraph, 1, threads, 0, &dist);
+		ASSERT_EQ(dist, expected);
+		BenchmarkResult parallel = benchmarkMeasure([&]() {
+			deltaSteppingDistances(taskGraph, 1, threads, 0, &dist);
+		}, 1.0, 3);
+		snprintf(name, sizeof(name), "SSSP delta-stepping x%d", threads);
+		benchmarkPrintItems(name, edges, "edges", parallel);
+		printf("%-36s %10.2fx\n", "  speedup over Dijkstra", dijkstra.seconds / parallel.seconds);
+	}
+}
+
+TEST(TaskschedulerBenchmark, AllPairsDistances) {
+	static const int TASKS = 1024;                 // the largest graph whose distances are cached
+	int hardwareThreads = (int)std::thread::hardware_concurrency();
+	buildSyntheticGraph(TASKS, false, 0);
+	size_t pairs = (size_t)TASKS * TASKS;
+	std::vector<int> all;
+	std::vector<int> dist;
+	char name[64];
+
+	BenchmarkResult dijkstra = benchmarkMeasure([&]() {
+		for (int id = 1; id <= TASKS; id++) {
+			dijkstraDistances(taskGraph, id, &dist);
+		}
+	}, 1.0, 3);
+	benchmarkPrintItems("APSP Dijkstra per source", pairs, "pairs", dijkstra);
+
+	for (int threads = 1; threads <= std::max(2, hardwareThreads); threads *= 2) {
+		ASSERT_TRUE(allPairsDistances(taskGraph, threads, &all));
+		dijkstraDistances(taskGraph, TASKS, &dist);
+		ASSERT_TRUE(std::equal(dist.begin(), dist.end(), all.end() - TASKS));
+		BenchmarkResult blocked = benchmarkMeasure([&]() {
+			allPairsDistances(taskGraph, threads, &all);
+		}, 1.0, 3);
+		snprintf(name, sizeof(name), "APSP blocked Floyd-Warshall x%d", threads);
+		benchmarkPrintItems(name, pairs, "pairs", blocked);
+		printf("%-36s %10.2fx\n", "  speedup over Dijkstra", dijkstra.seconds / blocked.seconds);
+	}
+}
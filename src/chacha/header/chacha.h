@@ -0,0 +1,72 @@
+#ifndef _CHACHA_H_
+#define _CHACHA_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ChaCha20-Poly1305 authenticated encryption (RFC 8439).
+//
+// The interface follows AES_GCM_* in aes.h, so a record can be sealed with either cipher:
+// init once per key, then start -> update_aad* -> encrypt/decrypt_update* -> finish / check_tag,
+// or the one-shot encrypt_buffer / decrypt_buffer.
+// It needs no AES hardware, which makes it the fast choice on hosts without AES-NI.
+
+// CHACHA_SIMD lets the keystream be generated several blocks at a time with SSE2 (4 blocks)
+// or AVX2 (8 blocks) on x86 CPUs. The choice is made at runtime; the portable code is used
+// everywhere else.
+#ifndef CHACHA_SIMD
+  #define CHACHA_SIMD 1
+#endif
+
+#define CHACHA20_KEYLEN           32 // Key length in bytes
+#define CHACHA20_BLOCKLEN         64 // Keystream block length in bytes
+#define CHACHA20_POLY1305_IVLEN   12 // Nonce length in bytes, the only length RFC 8439 defines
+#define CHACHA20_POLY1305_TAGLEN  16 // Authentication tag length in bytes
+
+// Values for CHACHA20_POLY1305_ctx::Simd
+#define CHACHA_SIMD_NONE 0
+#define CHACHA_SIMD_SSE2 1
+#define CHACHA_SIMD_AVX2 2
+
+struct CHACHA20_POLY1305_ctx
+{
+  uint32_t Key[8];
+  uint32_t Input[16];                        // ChaCha20 state: constants, key, block counter, nonce
+  uint8_t KeyStream[CHACHA20_BLOCKLEN];
+  uint32_t R[5];                             // Poly1305 key r, clamped, in 26-bit limbs
+  uint32_t Pad[4];                           // Poly1305 key s
+  uint32_t H[5];                             // running Poly1305 accumulator
+  uint8_t Block[16];                         // partial Poly1305 input block
+  uint8_t BlockLen;
+  uint8_t KeyStreamUsed;
+  uint8_t AadClosed;
+  uint8_t Simd;                              // widest SIMD path to use, detected by init
+  uint64_t AadLen;
+  uint64_t TextLen;
+};
+
+// Stores the key; call once per key.
+void CHACHA20_POLY1305_init_ctx(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* key);
+
+// Streaming interface: start -> update_aad* -> encrypt/decrypt_update* -> finish / check_tag.
+// All additional authenticated data must be supplied before the first encrypt/decrypt call.
+// start returns 0 if ivLen is not CHACHA20_POLY1305_IVLEN.
+// NOTES: no nonce should ever be reused with the same key
+int CHACHA20_POLY1305_start(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* iv, size_t ivLen);
+void CHACHA20_POLY1305_update_aad(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* aad, size_t length);
+void CHACHA20_POLY1305_encrypt_update(struct CHACHA20_POLY1305_ctx* ctx, uint8_t* buf, size_t length);
+void CHACHA20_POLY1305_decrypt_update(struct CHACHA20_POLY1305_ctx* ctx, uint8_t* buf, size_t length);
+void CHACHA20_POLY1305_finish(struct CHACHA20_POLY1305_ctx* ctx, uint8_t* tag);
+// Returns 1 if tag matches the computed tag (constant-time compare), 0 otherwise.
+int CHACHA20_POLY1305_check_tag(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* tag);
+
+// One-shot interface, buf is encrypted/decrypted in place and may have any length.
+// Both return 0 for a bad nonce length; CHACHA20_POLY1305_decrypt_buffer also wipes buf and
+// returns 0 on tag mismatch.
+int CHACHA20_POLY1305_encrypt_buffer(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* iv, size_t ivLen,
+                                     const uint8_t* aad, size_t aadLen, uint8_t* buf, size_t length, uint8_t* tag);
+int CHACHA20_POLY1305_decrypt_buffer(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* iv, size_t ivLen,
+                                     const uint8_t* aad, size_t aadLen, uint8_t* buf, size_t length, const uint8_t* tag);
+
+
+#endif // _CHACHA_H_
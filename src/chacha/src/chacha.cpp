@@ -0,0 +1,621 @@
+/*
+
+This is an implementation of the ChaCha20-Poly1305 AEAD construction of RFC 8439.
+
+The ChaCha20 keystream is generated one block at a time by portable code, or several blocks
+at a time with SSE2 or AVX2: each vector register then holds the same state word of 4 or 8
+consecutive blocks, so one quarter-round advances all of them together.
+Poly1305 uses 26-bit limbs and 64-bit products (after poly1305-donna), so it needs no 128-bit
+integer type.
+
+The implementation is verified against the test vectors in RFC 8439, section 2.8.2.
+
+*/
+
+
+/*****************************************************************************/
+/* Includes:                                                                 */
+/*****************************************************************************/
+#include <string.h>
+#include "chacha.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  #define CHACHA_X86 1
+  #define CHACHA_TARGET(isa) __attribute__((target(isa)))
+  #include <cpuid.h>
+  #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #define CHACHA_X86 1
+  #define CHACHA_TARGET(isa)
+  #include <intrin.h>
+  #include <immintrin.h>
+#else
+  #define CHACHA_X86 0
+#endif
+
+#if defined(CHACHA_SIMD) && (CHACHA_SIMD == 1) && CHACHA_X86
+  #define CHACHA_HAS_SIMD 1
+#else
+  #define CHACHA_HAS_SIMD 0
+#endif
+
+/*****************************************************************************/
+/* Defines:                                                                  */
+/*****************************************************************************/
+// Largest number of keystream blocks produced by one call of a SIMD path.
+#define CHACHA_MAX_PARALLEL 8
+
+#define ROTL32(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+
+#define QUARTERROUND(a, b, c, d)               \
+  a += b; d ^= a; d = ROTL32(d, 16);           \
+  c += d; b ^= c; b = ROTL32(b, 12);           \
+  a += b; d ^= a; d = ROTL32(d, 8);            \
+  c += d; b ^= c; b = ROTL32(b, 7);
+
+
+/*****************************************************************************/
+/* Private functions:                                                        */
+/*****************************************************************************/
+static uint32_t load32_le(const uint8_t* p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void store32_le(uint8_t* p, uint32_t v)
+{
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static void store64_le(uint8_t* p, uint64_t v)
+{
+  store32_le(p, (uint32_t)v);
+  store32_le(p + 4, (uint32_t)(v >> 32));
+}
+
+// Produces one 64-byte keystream block from the state in input.
+static void chacha_block(const uint32_t* input, uint8_t* out)
+{
+  uint32_t x[16];
+  uint8_t i;
+
+  memcpy(x, input, sizeof(x));
+  for (i = 0; i < 10; ++i)
+  {
+    // Column round
+    QUARTERROUND(x[0], x[4], x[8], x[12])
+    QUARTERROUND(x[1], x[5], x[9], x[13])
+    QUARTERROUND(x[2], x[6], x[10], x[14])
+    QUARTERROUND(x[3], x[7], x[11], x[15])
+    // Diagonal round
+    QUARTERROUND(x[0], x[5], x[10], x[15])
+    QUARTERROUND(x[1], x[6], x[11], x[12])
+    QUARTERROUND(x[2], x[7], x[8], x[13])
+    QUARTERROUND(x[3], x[4], x[9], x[14])
+  }
+  for (i = 0; i < 16; ++i)
+  {
+    store32_le(out + 4 * i, x[i] + input[i]);
+  }
+}
+
+#if CHACHA_HAS_SIMD
+
+#if defined(_MSC_VER)
+static void chacha_cpuid(unsigned int leaf, unsigned int sub, unsigned int* regs)
+{
+  int r[4];
+  __cpuidex(r, (int)leaf, (int)sub);
+  regs[0] = (unsigned int)r[0]; regs[1] = (unsigned int)r[1];
+  regs[2] = (unsigned int)r[2]; regs[3] = (unsigned int)r[3];
+}
+
+static uint64_t chacha_xgetbv(void)
+{
+  return _xgetbv(0);
+}
+#else
+static void chacha_cpuid(unsigned int leaf, unsigned int sub, unsigned int* regs)
+{
+  if (!__get_cpuid_count(leaf, sub, &regs[0], &regs[1], &regs[2], &regs[3]))
+  {
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+  }
+}
+
+static uint64_t chacha_xgetbv(void)
+{
+  uint32_t eax, edx;
+  __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return ((uint64_t)edx << 32) | eax;
+}
+#endif
+
+// AVX2 needs the CPU feature and an OS that saves the YMM registers (OSXSAVE + XCR0 bits 1, 2).
+static uint8_t chacha_detect_simd(void)
+{
+  unsigned int regs[4];
+  uint8_t simd = CHACHA_SIMD_NONE;
+
+  chacha_cpuid(1, 0, regs);
+  if (regs[3] & (1u << 26))
+  {
+    simd = CHACHA_SIMD_SSE2;
+  }
+  if ((regs[2] & (1u << 27)) && (chacha_xgetbv() & 6) == 6)
+  {
+    chacha_cpuid(7, 0, regs);
+    if (regs[1] & (1u << 5))
+    {
+      simd = CHACHA_SIMD_AVX2;
+    }
+  }
+  return simd;
+}
+
+#define SSE2_ROTL(v, n) _mm_or_si128(_mm_slli_epi32(v, n), _mm_srli_epi32(v, 32 - (n)))
+
+#define SSE2_QUARTERROUND(a, b, c, d)                                            \
+  a = _mm_add_epi32(a, b); d = _mm_xor_si128(d, a); d = SSE2_ROTL(d, 16);        \
+  c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = SSE2_ROTL(b, 12);        \
+  a = _mm_add_epi32(a, b); d = _mm_xor_si128(d, a); d = SSE2_ROTL(d, 8);         \
+  c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = SSE2_ROTL(b, 7);
+
+// Produces 4 consecutive keystream blocks; lane j of x[i] is word i of block j.
+CHACHA_TARGET("sse2")
+static void chacha_blocks_sse2(const uint32_t* input, uint8_t* out)
+{
+  __m128i x[16], orig[16];
+  __m128i t0, t1, t2, t3;
+  int i;
+
+  for (i = 0; i < 16; ++i)
+  {
+    x[i] = _mm_set1_epi32((int)input[i]);
+  }
+  x[12] = _mm_add_epi32(x[12], _mm_set_epi32(3, 2, 1, 0));
+  for (i = 0; i < 16; ++i)
+  {
+    orig[i] = x[i];
+  }
+
+  for (i = 0; i < 10; ++i)
+  {
+    SSE2_QUARTERROUND(x[0], x[4], x[8], x[12])
+    SSE2_QUARTERROUND(x[1], x[5], x[9], x[13])
+    SSE2_QUARTERROUND(x[2], x[6], x[10], x[14])
+    SSE2_QUARTERROUND(x[3], x[7], x[11], x[15])
+    SSE2_QUARTERROUND(x[0], x[5], x[10], x[15])
+    SSE2_QUARTERROUND(x[1], x[6], x[11], x[12])
+    SSE2_QUARTERROUND(x[2], x[7], x[8], x[13])
+    SSE2_QUARTERROUND(x[3], x[4], x[9], x[14])
+  }
+
+  // Transpose each group of four words back into block order
+  for (i = 0; i < 16; i += 4)
+  {
+    __m128i a = _mm_add_epi32(x[i], orig[i]);
+    __m128i b = _mm_add_epi32(x[i + 1], orig[i + 1]);
+    __m128i c = _mm_add_epi32(x[i + 2], orig[i + 2]);
+    __m128i d = _mm_add_epi32(x[i + 3], orig[i + 3]);
+    t0 = _mm_unpacklo_epi32(a, b);
+    t1 = _mm_unpacklo_epi32(c, d);
+    t2 = _mm_unpackhi_epi32(a, b);
+    t3 = _mm_unpackhi_epi32(c, d);
+    _mm_storeu_si128((__m128i*)(out + 0 * CHACHA20_BLOCKLEN + 4 * i), _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)(out + 1 * CHACHA20_BLOCKLEN + 4 * i), _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)(out + 2 * CHACHA20_BLOCKLEN + 4 * i), _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128((__m128i*)(out + 3 * CHACHA20_BLOCKLEN + 4 * i), _mm_unpackhi_epi64(t2, t3));
+  }
+}
+
+// Rotations by 16 and 8 are byte shuffles; 12 and 7 need the shift pair.
+#define AVX2_ROTL(v, n) _mm256_or_si256(_mm256_slli_epi32(v, n), _mm256_srli_epi32(v, 32 - (n)))
+
+#define AVX2_QUARTERROUND(a, b, c, d)                                                                  \
+  a = _mm256_add_epi32(a, b); d = _mm256_xor_si256(d, a); d = _mm256_shuffle_epi8(d, rot16);          \
+  c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c); b = AVX2_ROTL(b, 12);                       \
+  a = _mm256_add_epi32(a, b); d = _mm256_xor_si256(d, a); d = _mm256_shuffle_epi8(d, rot8);           \
+  c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c); b = AVX2_ROTL(b, 7);
+
+// Produces 8 consecutive keystream blocks; lane j of x[i] is word i of block j.
+CHACHA_TARGET("avx2")
+static void chacha_blocks_avx2(const uint32_t* input, uint8_t* out)
+{
+  const __m256i rot16 = _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                                        13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+  const __m256i rot8 = _mm256_set_epi8(14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+                                       14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+  __m256i x[16], orig[16];
+  __m256i t0, t1, t2, t3, r;
+  int i;
+
+  for (i = 0; i < 16; ++i)
+  {
+    x[i] = _mm256_set1_epi32((int)input[i]);
+  }
+  x[12] = _mm256_add_epi32(x[12], _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+  for (i = 0; i < 16; ++i)
+  {
+    orig[i] = x[i];
+  }
+
+  for (i = 0; i < 10; ++i)
+  {
+    AVX2_QUARTERROUND(x[0], x[4], x[8], x[12])
+    AVX2_QUARTERROUND(x[1], x[5], x[9], x[13])
+    AVX2_QUARTERROUND(x[2], x[6], x[10], x[14])
+    AVX2_QUARTERROUND(x[3], x[7], x[11], x[15])
+    AVX2_QUARTERROUND(x[0], x[5], x[10], x[15])
+    AVX2_QUARTERROUND(x[1], x[6], x[11], x[12])
+    AVX2_QUARTERROUND(x[2], x[7], x[8], x[13])
+    AVX2_QUARTERROUND(x[3], x[4], x[9], x[14])
+  }
+
+  // The unpacks work within 128-bit lanes: the low lane ends up holding blocks 0-3 and the
+  // high lane blocks 4-7.
+  for (i = 0; i < 16; i += 4)
+  {
+    __m256i a = _mm256_add_epi32(x[i], orig[i]);
+    __m256i b = _mm256_add_epi32(x[i + 1], orig[i + 1]);
+    __m256i c = _mm256_add_epi32(x[i + 2], orig[i + 2]);
+    __m256i d = _mm256_add_epi32(x[i + 3], orig[i + 3]);
+    t0 = _mm256_unpacklo_epi32(a, b);
+    t1 = _mm256_unpacklo_epi32(c, d);
+    t2 = _mm256_unpackhi_epi32(a, b);
+    t3 = _mm256_unpackhi_epi32(c, d);
+
+    r = _mm256_unpacklo_epi64(t0, t1);
+    _mm_storeu_si128((__m128i*)(out + 0 * CHACHA20_BLOCKLEN + 4 * i), _mm256_castsi256_si128(r));
+    _mm_storeu_si128((__m128i*)(out + 4 * CHACHA20_BLOCKLEN + 4 * i), _mm256_extracti128_si256(r, 1));
+    r = _mm256_unpackhi_epi64(t0, t1);
+    _mm_storeu_si128((__m128i*)(out + 1 * CHACHA20_BLOCKLEN + 4 * i), _mm256_castsi256_si128(r));
+    _mm_storeu_si128((__m128i*)(out + 5 * CHACHA20_BLOCKLEN + 4 * i), _mm256_extracti128_si256(r, 1));
+    r = _mm256_unpacklo_epi64(t2, t3);
+    _mm_storeu_si128((__m128i*)(out + 2 * CHACHA20_BLOCKLEN + 4 * i), _mm256_castsi256_si128(r));
+    _mm_storeu_si128((__m128i*)(out + 6 * CHACHA20_BLOCKLEN + 4 * i), _mm256_extracti128_si256(r, 1));
+    r = _mm256_unpackhi_epi64(t2, t3);
+    _mm_storeu_si128((__m128i*)(out + 3 * CHACHA20_BLOCKLEN + 4 * i), _mm256_castsi256_si128(r));
+    _mm_storeu_si128((__m128i*)(out + 7 * CHACHA20_BLOCKLEN + 4 * i), _mm256_extracti128_si256(r, 1));
+  }
+}
+
+#endif // #if CHACHA_HAS_SIMD
+
+// Writes up to `blocks` keystream blocks to out, using the widest path that fits, and advances
+// the block counter. Returns the number of blocks written.
+static size_t chacha_blocks(struct CHACHA20_POLY1305_ctx* ctx, uint8_t* out, size_t blocks)
+{
+#if CHACHA_HAS_SIMD
+  if (ctx->Simd >= CHACHA_SIMD_AVX2 && blocks >= 8)
+  {
+    chacha_blocks_avx2(ctx->Input, out);
+    ctx->Input[12] += 8;
+    return 8;
+  }
+  if (ctx->Simd >= CHACHA_SIMD_SSE2 && blocks >= 4)
+  {
+    chacha_blocks_sse2(ctx->Input, out);
+    ctx->Input[12] += 4;
+    return 4;
+  }
+#endif
+  chacha_block(ctx->Input, out);
+  ctx->Input[12] += 1;
+  return 1;
+}
+
+// Absorbs whole 16-byte blocks into the accumulator: h = (h + m + 2^128) * r mod 2^130 - 5.
+static void poly_blocks(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* m, size_t blocks)
+{
+  const uint32_t r0 = ctx->R[0], r1 = ctx->R[1], r2 = ctx->R[2], r3 = ctx->R[3], r4 = ctx->R[4];
+  const uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+  uint32_t h0 = ctx->H[0], h1 = ctx->H[1], h2 = ctx->H[2], h3 = ctx->H[3], h4 = ctx->H[4];
+  uint64_t d0, d1, d2, d3, d4;
+  uint32_t c;
+
+  while (blocks-- > 0)
+  {
+    h0 += load32_le(m + 0) & 0x3ffffff;
+    h1 += (load32_le(m + 3) >> 2) & 0x3ffffff;
+    h2 += (load32_le(m + 6) >> 4) & 0x3ffffff;
+    h3 += (load32_le(m + 9) >> 6) & 0x3ffffff;
+    h4 += (load32_le(m + 12) >> 8) | (1u << 24);
+
+    d0 = (uint64_t)h0 * r0 + (uint64_t)h1 * s4 + (uint64_t)h2 * s3 + (uint64_t)h3 * s2 + (uint64_t)h4 * s1;
+    d1 = (uint64_t)h0 * r1 + (uint64_t)h1 * r0 + (uint64_t)h2 * s4 + (uint64_t)h3 * s3 + (uint64_t)h4 * s2;
+    d2 = (uint64_t)h0 * r2 + (uint64_t)h1 * r1 + (uint64_t)h2 * r0 + (uint64_t)h3 * s4 + (uint64_t)h4 * s3;
+    d3 = (uint64_t)h0 * r3 + (uint64_t)h1 * r2 + (uint64_t)h2 * r1 + (uint64_t)h3 * r0 + (uint64_t)h4 * s4;
+    d4 = (uint64_t)h0 * r4 + (uint64_t)h1 * r3 + (uint64_t)h2 * r2 + (uint64_t)h3 * r1 + (uint64_t)h4 * r0;
+
+    c = (uint32_t)(d0 >> 26); h0 = (uint32_t)d0 & 0x3ffffff; d1 += c;
+    c = (uint32_t)(d1 >> 26); h1 = (uint32_t)d1 & 0x3ffffff; d2 += c;
+    c = (uint32_t)(d2 >> 26); h2 = (uint32_t)d2 & 0x3ffffff; d3 += c;
+    c = (uint32_t)(d3 >> 26); h3 = (uint32_t)d3 & 0x3ffffff; d4 += c;
+    c = (uint32_t)(d4 >> 26); h4 = (uint32_t)d4 & 0x3ffffff; h0 += c * 5;
+    c = h0 >> 26; h0 &= 0x3ffffff; h1 += c;
+
+    m += 16;
+  }
+
+  ctx->H[0] = h0; ctx->H[1] = h1; ctx->H[2] = h2; ctx->H[3] = h3; ctx->H[4] = h4;
+}
+
+static void poly_update(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* m, size_t length)
+{
+  size_t take;
+
+  if (length == 0)
+  {
+    return;
+  }
+  if (ctx->BlockLen > 0)
+  {
+    take = 16 - ctx->BlockLen;
+    if (take > length)
+    {
+      take = length;
+    }
+    memcpy(ctx->Block + ctx->BlockLen, m, take);
+    ctx->BlockLen = (uint8_t)(ctx->BlockLen + take);
+    m += take;
+    length -= take;
+    if (ctx->BlockLen < 16)
+    {
+      return;
+    }
+    poly_blocks(ctx, ctx->Block, 1);
+    ctx->BlockLen = 0;
+  }
+
+  poly_blocks(ctx, m, length / 16);
+  m += length & ~(size_t)15;
+  length &= 15;
+
+  memcpy(ctx->Block, m, length);
+  ctx->BlockLen = (uint8_t)length;
+}
+
+// RFC 8439 pads the AAD and the ciphertext with zeros up to a multiple of 16 bytes.
+static void poly_pad(struct CHACHA20_POLY1305_ctx* ctx)
+{
+  if (ctx->BlockLen > 0)
+  {
+    memset(ctx->Block + ctx->BlockLen, 0, 16 - ctx->BlockLen);
+    poly_blocks(ctx, ctx->Block, 1);
+    ctx->BlockLen = 0;
+  }
+}
+
+static void chacha_close_aad(struct CHACHA20_POLY1305_ctx* ctx)
+{
+  if (!ctx->AadClosed)
+  {
+    poly_pad(ctx);
+    ctx->AadClosed = 1;
+  }
+}
+
+// Encrypts or decrypts buf and feeds the ciphertext to Poly1305.
+static void chacha_crypt(struct CHACHA20_POLY1305_ctx* ctx, uint8_t* buf, size_t length, int decrypt)
+{
+  uint8_t stream[CHACHA_MAX_PARALLEL * CHACHA20_BLOCKLEN];
+  uint8_t* const start = buf;
+  const size_t total = length;
+  size_t blocks, i;
+
+  chacha_close_aad(ctx);
+  if (decrypt)
+  {
+    poly_update(ctx, buf, length);
+  }
+  ctx->TextLen += length;
+
+  // Use up the keystream left over from the previous call
+  while (length > 0 && ctx->KeyStreamUsed < CHACHA20_BLOCKLEN)
+  {
+    *buf++ ^= ctx->KeyStream[ctx->KeyStreamUsed++];
+    --length;
+  }
+
+  while (length >= CHACHA20_BLOCKLEN)
+  {
+    blocks = length / CHACHA20_BLOCKLEN;
+    blocks = chacha_blocks(ctx, stream, blocks < CHACHA_MAX_PARALLEL ? blocks : CHACHA_MAX_PARALLEL);
+    for (i = 0; i < blocks * CHACHA20_BLOCKLEN; ++i)
+    {
+      buf[i] ^= stream[i];
+    }
+    buf += blocks * CHACHA20_BLOCKLEN;
+    length -= blocks * CHACHA20_BLOCKLEN;
+  }
+
+  if (length > 0)
+  {
+    chacha_blocks(ctx, ctx->KeyStream, 1);
+    for (i = 0; i < length; ++i)
+    {
+      buf[i] ^= ctx->KeyStream[i];
+    }
+    ctx->KeyStreamUsed = (uint8_t)length;
+  }
+
+  if (!decrypt)
+  {
+    poly_update(ctx, start, total);
+  }
+}
+
+
+/*****************************************************************************/
+/* Public functions:                                                         */
+/*****************************************************************************/
+void CHACHA20_POLY1305_init_ctx(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* key)
+{
+  uint8_t i;
+  memset(ctx, 0, sizeof(struct CHACHA20_POLY1305_ctx));
+  for (i = 0; i < 8; ++i)
+  {
+    ctx->Key[i] = load32_le(key + 4 * i);
+  }
+#if CHACHA_HAS_SIMD
+  ctx->Simd = chacha_detect_simd();
+#else
+  ctx->Simd = CHACHA_SIMD_NONE;
+#endif
+}
+
+int CHACHA20_POLY1305_start(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* iv, size_t ivLen)
+{
+  uint8_t polyKey[CHACHA20_BLOCKLEN];
+
+  if (ivLen != CHACHA20_POLY1305_IVLEN)
+  {
+    return 0;
+  }
+
+  // "expand 32-byte k", key, block counter 0, nonce
+  ctx->Input[0] = 0x61707865;
+  ctx->Input[1] = 0x3320646e;
+  ctx->Input[2] = 0x79622d32;
+  ctx->Input[3] = 0x6b206574;
+  memcpy(ctx->Input + 4, ctx->Key, sizeof(ctx->Key));
+  ctx->Input[12] = 0;
+  ctx->Input[13] = load32_le(iv);
+  ctx->Input[14] = load32_le(iv + 4);
+  ctx->Input[15] = load32_le(iv + 8);
+
+  // The one-time Poly1305 key is the first half of block 0; the message starts at block 1
+  chacha_block(ctx->Input, polyKey);
+  ctx->Input[12] = 1;
+
+  ctx->R[0] = load32_le(polyKey + 0) & 0x3ffffff;
+  ctx->R[1] = (load32_le(polyKey + 3) >> 2) & 0x3ffff03;
+  ctx->R[2] = (load32_le(polyKey + 6) >> 4) & 0x3ffc0ff;
+  ctx->R[3] = (load32_le(polyKey + 9) >> 6) & 0x3f03fff;
+  ctx->R[4] = (load32_le(polyKey + 12) >> 8) & 0x00fffff;
+  ctx->Pad[0] = load32_le(polyKey + 16);
+  ctx->Pad[1] = load32_le(polyKey + 20);
+  ctx->Pad[2] = load32_le(polyKey + 24);
+  ctx->Pad[3] = load32_le(polyKey + 28);
+  memset(polyKey, 0, sizeof(polyKey));
+
+  memset(ctx->H, 0, sizeof(ctx->H));
+  ctx->BlockLen = 0;
+  ctx->KeyStreamUsed = CHACHA20_BLOCKLEN;
+  ctx->AadClosed = 0;
+  ctx->AadLen = 0;
+  ctx->TextLen = 0;
+  return 1;
+}
+
+void CHACHA20_POLY1305_update_aad(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* aad, size_t length)
+{
+  poly_update(ctx, aad, length);
+  ctx->AadLen += length;
+}
+
+void CHACHA20_POLY1305_encrypt_update(struct CHACHA20_POLY1305_ctx* ctx, uint8_t* buf, size_t length)
+{
+  chacha_crypt(ctx, buf, length, 0);
+}
+
+void CHACHA20_POLY1305_decrypt_update(struct CHACHA20_POLY1305_ctx* ctx, uint8_t* buf, size_t length)
+{
+  chacha_crypt(ctx, buf, length, 1);
+}
+
+void CHACHA20_POLY1305_finish(struct CHACHA20_POLY1305_ctx* ctx, uint8_t* tag)
+{
+  uint8_t lenBlock[16];
+  uint32_t h0, h1, h2, h3, h4, g0, g1, g2, g3, g4, c, mask;
+  uint64_t f;
+
+  chacha_close_aad(ctx);
+  poly_pad(ctx);
+  store64_le(lenBlock, ctx->AadLen);
+  store64_le(lenBlock + 8, ctx->TextLen);
+  poly_blocks(ctx, lenBlock, 1);
+
+  // Fully carry h
+  h0 = ctx->H[0]; h1 = ctx->H[1]; h2 = ctx->H[2]; h3 = ctx->H[3]; h4 = ctx->H[4];
+  c = h1 >> 26; h1 &= 0x3ffffff; h2 += c;
+  c = h2 >> 26; h2 &= 0x3ffffff; h3 += c;
+  c = h3 >> 26; h3 &= 0x3ffffff; h4 += c;
+  c = h4 >> 26; h4 &= 0x3ffffff; h0 += c * 5;
+  c = h0 >> 26; h0 &= 0x3ffffff; h1 += c;
+
+  // Compute h - p = h + 5 - 2^130 and select it in constant time if it does not borrow
+  g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+  g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+  g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+  g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+  g4 = h4 + c - (1u << 26);
+
+  mask = (g4 >> 31) - 1;
+  g0 &= mask; g1 &= mask; g2 &= mask; g3 &= mask; g4 &= mask;
+  mask = ~mask;
+  h0 = (h0 & mask) | g0;
+  h1 = (h1 & mask) | g1;
+  h2 = (h2 & mask) | g2;
+  h3 = (h3 & mask) | g3;
+  h4 = (h4 & mask) | g4;
+
+  // tag = (h + s) mod 2^128
+  h0 = h0 | (h1 << 26);
+  h1 = (h1 >> 6) | (h2 << 20);
+  h2 = (h2 >> 12) | (h3 << 14);
+  h3 = (h3 >> 18) | (h4 << 8);
+
+  f = (uint64_t)h0 + ctx->Pad[0];             store32_le(tag + 0, (uint32_t)f);
+  f = (uint64_t)h1 + ctx->Pad[1] + (f >> 32); store32_le(tag + 4, (uint32_t)f);
+  f = (uint64_t)h2 + ctx->Pad[2] + (f >> 32); store32_le(tag + 8, (uint32_t)f);
+  f = (uint64_t)h3 + ctx->Pad[3] + (f >> 32); store32_le(tag + 12, (uint32_t)f);
+}
+
+int CHACHA20_POLY1305_check_tag(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* tag)
+{
+  uint8_t computed[CHACHA20_POLY1305_TAGLEN];
+  uint8_t diff = 0;
+  uint8_t i;
+
+  CHACHA20_POLY1305_finish(ctx, computed);
+  for (i = 0; i < CHACHA20_POLY1305_TAGLEN; ++i)
+  {
+    diff |= (uint8_t)(computed[i] ^ tag[i]);
+  }
+  return diff == 0;
+}
+
+int CHACHA20_POLY1305_encrypt_buffer(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* iv, size_t ivLen,
+                                     const uint8_t* aad, size_t aadLen, uint8_t* buf, size_t length, uint8_t* tag)
+{
+  if (!CHACHA20_POLY1305_start(ctx, iv, ivLen))
+  {
+    return 0;
+  }
+  CHACHA20_POLY1305_update_aad(ctx, aad, aadLen);
+  chacha_crypt(ctx, buf, length, 0);
+  CHACHA20_POLY1305_finish(ctx, tag);
+  return 1;
+}
+
+int CHACHA20_POLY1305_decrypt_buffer(struct CHACHA20_POLY1305_ctx* ctx, const uint8_t* iv, size_t ivLen,
+                                     const uint8_t* aad, size_t aadLen, uint8_t* buf, size_t length, const uint8_t* tag)
+{
+  if (!CHACHA20_POLY1305_start(ctx, iv, ivLen))
+  {
+    return 0;
+  }
+  CHACHA20_POLY1305_update_aad(ctx, aad, aadLen);
+  chacha_crypt(ctx, buf, length, 1);
+  if (!CHACHA20_POLY1305_check_tag(ctx, tag))
+  {
+    memset(buf, 0, length);
+    return 0;
+  }
+  return 1;
+}
@@ -1,10 +1,14 @@
 #define ENABLE_TASKSCHEDULER_TEST 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <cstring>
+#include <stdexcept>
 #include "../../taskscheduler/header/taskscheduler.h"  
 
 extern User loggedUser;
+extern TaskGraph taskGraph;
 
 class TaskschedulerTest : public ::testing::Test {
 protected:
@@ -52,6 +56,27 @@ protected:
 		in.str(input);
 		in.clear();
 	}
+
+	// Fixture files are written with valid tags, as the application writes them; task files come from createTasksFile
+	void writeTasks(FILE* file, Task* tasks, int count) {
+		for (int i = 0; i < count; i++) {
+			tagTask(&tasks[i]);
+			fwrite(&tasks[i], sizeof(Task), 1, file);
+		}
+	}
+
+	void writeUsers(const char* pathFileUsers, User* users, int count) {
+		for (int i = 0; i < count; i++) {
+			tagUser(&users[i]);
+		}
+		ASSERT_TRUE(saveUsers(pathFileUsers, users, count));
+	}
+
+	// Advances the seeded generator the synthetic graphs are drawn from and returns its new state
+	unsigned nextRandom(unsigned& seed) {
+		seed = seed * 1103515245u + 12345u;
+		return seed;
+	}
 };
 
 
@@ -91,7 +116,10 @@ TEST_F(TaskschedulerTest, getNewUserId_EmptyList) {
 }
 
 TEST_F(TaskschedulerTest, getNewUserId_NonEmptyList) {
-	User users[3] = { {1}, {2}, {3} };
+	User users[3] = {};
+	for (int i = 0; i < 3; i++) {
+		users[i].id = i + 1;
+	}
 	int userCount = 3;
 	EXPECT_EQ(getNewUserId(users, userCount), 4);
 }
@@ -104,9 +132,12 @@ TEST_F(TaskschedulerTest, getNewTaskId_FileNotExists) {
 TEST_F(TaskschedulerTest, getNewTaskId_FileExists) {
 	const char* pathFileTasks = "tasks.bin";
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	Task tasks[3] = { {1}, {2}, {3} };
-	fwrite(tasks, sizeof(Task), 3, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	Task tasks[3] = {};
+	for (int i = 0; i < 3; i++) {
+		tasks[i].id = i + 1;
+	}
+	writeTasks(file, tasks, 3);
 	fclose(file);
 
 	EXPECT_EQ(getNewTaskId(pathFileTasks), 4);
@@ -256,36 +287,41 @@ TEST_F(TaskschedulerTest, reminderSystemMenu_NotificationSettings4) {
 }
 
 TEST_F(TaskschedulerTest, taskPrioritizationMenu_Success) {
-	simulateUserInput("5\n");
+	simulateUserInput("6\n");
 	EXPECT_EQ(taskPrioritizationMenu(in, out), 0);
 }
 
 TEST_F(TaskschedulerTest, taskPrioritizationMenu_InvalidChoices) {
-	simulateUserInput("invalid\n\n6\n\n5\n6\n4\n");
+	simulateUserInput("invalid\n\n7\n\n6\n6\n4\n");
 	EXPECT_FALSE(taskPrioritizationMenu(in, out));
 }
 
 TEST_F(TaskschedulerTest, taskPrioritizationMenu_MarkTaskImportance) {
-	simulateUserInput("1\n\n5\n5\n6\n4\n");
+	simulateUserInput("1\n\n6\n6\n6\n4\n");
 	EXPECT_FALSE(taskPrioritizationMenu(in, out));
 }
 
 TEST_F(TaskschedulerTest, taskPrioritizationMenu_ReorderTask) {
-	simulateUserInput("2\n\n5\n6\n4\n");
+	simulateUserInput("2\n\n6\n6\n4\n");
 	EXPECT_FALSE(taskPrioritizationMenu(in, out));
 }
 
 TEST_F(TaskschedulerTest, taskPrioritizationMenu_CalculateMST) {
-	simulateUserInput("3\n1\n1\n\n5\n6\n4\n");
+	simulateUserInput("3\n1\n1\n\n6\n6\n4\n");
 	EXPECT_FALSE(taskPrioritizationMenu(in, out));
 }
 
 TEST_F(TaskschedulerTest, taskPrioritizationMenu_shortestPath) {
-	simulateUserInput("4\n1\n1\n\n5\n6\n4\n");
+	simulateUserInput("4\n1\n1\n\n6\n6\n4\n");
 	EXPECT_FALSE(taskPrioritizationMenu(in, out));
 }
 
 
+TEST_F(TaskschedulerTest, taskPrioritizationMenu_PlanSchedule) {
+	simulateUserInput("5\n0\n\n6\n");
+	EXPECT_FALSE(taskPrioritizationMenu(in, out));
+}
+
 TEST_F(TaskschedulerTest, flowAlgorithmsMenu_Success) {
 	simulateUserInput("3\n");
 	EXPECT_EQ(flowAlgorithmsMenu(in, out), 0);
@@ -339,11 +375,11 @@ TEST_F(TaskschedulerTest, viewTask_NoTasks) {
 TEST_F(TaskschedulerTest, viewTask_WithTasks) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasks[1] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "Deadline 1", "Category 1", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "Deadline 1", "Category 1", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasks, sizeof(Task), 1, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasks, 1);
 	fclose(file);
 
 	simulateUserInput("\n");
@@ -367,11 +403,11 @@ TEST_F(TaskschedulerTest, viewDeadlines_NoTasks) {
 TEST_F(TaskschedulerTest, viewDeadlines_WithTasksAndDeadlines) {
 	const char* pathFileTasks = "tasks_with_deadlines.bin";
 	Task tasks[1] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "01/01/2024", "Category 1", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "01/01/2024", "Category 1", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasks, sizeof(Task), 1, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasks, 1);
 	fclose(file);
 
 	simulateUserInput("\n");
@@ -383,11 +419,11 @@ TEST_F(TaskschedulerTest, viewDeadlines_WithTasksAndDeadlines) {
 TEST_F(TaskschedulerTest, viewDeadlines_WithTasksWithoutDeadlines) {
 	const char* pathFileTasks = "tasks_without_deadlines.bin";
 	Task tasks[1] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "Category 1", true, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "Category 1", true, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasks, sizeof(Task), 1, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasks, 1);
 	fclose(file);
 
 	simulateUserInput("\n");
@@ -425,12 +461,12 @@ TEST_F(TaskschedulerTest, loadTasks_EmptyFile) {
 TEST_F(TaskschedulerTest, loadTasks_WithTasks) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "01/01/2024", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "02/01/2024", "Category 2", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "01/01/2024", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "02/01/2024", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	Task* tasks = nullptr;
@@ -479,12 +515,12 @@ TEST_F(TaskschedulerTest, categorizeTask_NoTasks) {
 TEST_F(TaskschedulerTest, categorizeTask_WithUncategorizedTasks1) {
 	const char* pathFileTasks = "tasks_with_uncategorized.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n1\n\n");
@@ -498,12 +534,12 @@ TEST_F(TaskschedulerTest, categorizeTask_WithUncategorizedTasks1) {
 TEST_F(TaskschedulerTest, categorizeTask_WithUncategorizedTasks2) {
 	const char* pathFileTasks = "tasks_with_uncategorized.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n2\n\n");
@@ -517,12 +553,12 @@ TEST_F(TaskschedulerTest, categorizeTask_WithUncategorizedTasks2) {
 TEST_F(TaskschedulerTest, categorizeTask_WithUncategorizedTasks3) {
 	const char* pathFileTasks = "tasks_with_uncategorized.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n3\n\n");
@@ -536,12 +572,12 @@ TEST_F(TaskschedulerTest, categorizeTask_WithUncategorizedTasks3) {
 TEST_F(TaskschedulerTest, categorizeTask_WithUncategorizedTasks4) {
 	const char* pathFileTasks = "tasks_with_uncategorized.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n4\n\n");
@@ -555,12 +591,12 @@ TEST_F(TaskschedulerTest, categorizeTask_WithUncategorizedTasks4) {
 TEST_F(TaskschedulerTest, categorizeTask_WithUncategorizedTasks5) {
 	const char* pathFileTasks = "tasks_with_uncategorized.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n5\n\n");
@@ -574,12 +610,12 @@ TEST_F(TaskschedulerTest, categorizeTask_WithUncategorizedTasks5) {
 TEST_F(TaskschedulerTest, categorizeTask_InvalidTaskID) {
 	const char* pathFileTasks = "tasks_with_uncategorized.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("3\n1\n");
@@ -608,12 +644,12 @@ TEST_F(TaskschedulerTest, assignDeadline_NoTasks) {
 TEST_F(TaskschedulerTest, assignDeadline_WithUncategorizedTasks) {
 	const char* pathFileTasks = "tasks_with_uncategorized.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n15\n12\n2024\n\n");
@@ -627,12 +663,12 @@ TEST_F(TaskschedulerTest, assignDeadline_WithUncategorizedTasks) {
 TEST_F(TaskschedulerTest, assignDeadline_InvalidDate) {
 	const char* pathFileTasks = "tasks_with_uncategorized.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n32\n12\n2024\n\n");
@@ -661,12 +697,12 @@ TEST_F(TaskschedulerTest, markTaskImportance_NoTasks) {
 TEST_F(TaskschedulerTest, markTaskImportance_WithTasks) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n3\n\n");
@@ -680,12 +716,12 @@ TEST_F(TaskschedulerTest, markTaskImportance_WithTasks) {
 TEST_F(TaskschedulerTest, markTaskImportance_InvalidImportanceId) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n-1\n\n");
@@ -699,12 +735,12 @@ TEST_F(TaskschedulerTest, markTaskImportance_InvalidImportanceId) {
 TEST_F(TaskschedulerTest, markTaskImportance_InvalidTaskId) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "", "", false, false, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "", "", false, false, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("3\n3\n\n");
@@ -734,12 +770,12 @@ TEST_F(TaskschedulerTest, reorderTask_NoTasks) {
 TEST_F(TaskschedulerTest, reorderTask_WithTasks) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 2, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 1, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 2, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 1, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n3\n\n");
@@ -753,12 +789,12 @@ TEST_F(TaskschedulerTest, reorderTask_WithTasks) {
 TEST_F(TaskschedulerTest, reorderTask_InvalidTaskId) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 2, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 1, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 2, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 1, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("3\n6\n\n");
@@ -773,11 +809,11 @@ TEST_F(TaskschedulerTest, reorderTask_InvalidTaskId) {
 TEST_F(TaskschedulerTest, similarTasks_NotEnoughTasks) {
 	const char* pathFileTasks = "few_tasks.bin";
 	Task tasksToWrite[1] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 1, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 1);
 	fclose(file);
 
 	std::stringstream input("\n");
@@ -791,13 +827,13 @@ TEST_F(TaskschedulerTest, similarTasks_NotEnoughTasks) {
 TEST_F(TaskschedulerTest, similarTasks_FoundSimilarTasks) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[3] = {
-		{1, 0, loggedUser, "Task 1", "Similar description", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Similar description", "2024-01-02", "Category 2", true, true, {}, 0},
-		{3, 0, loggedUser, "Task 3", "Different description", "2024-01-03", "Category 3", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Similar description", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Similar description", "2024-01-02", "Category 2", true, true, {}, 0, {}},
+		{3, 0, loggedUser, "Task 3", "Different description", "2024-01-03", "Category 3", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 3, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 3);
 	fclose(file);
 
 	std::stringstream input("\n");
@@ -811,13 +847,13 @@ TEST_F(TaskschedulerTest, similarTasks_FoundSimilarTasks) {
 TEST_F(TaskschedulerTest, similarTasks_NoSimilarTasks) {
 	const char* pathFileTasks = "tasks_with_no_similarities.bin";
 	Task tasksToWrite[3] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0},
-		{3, 0, loggedUser, "Task 3", "Description 3", "2024-01-03", "Category 3", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}},
+		{3, 0, loggedUser, "Task 3", "Description 3", "2024-01-03", "Category 3", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 3, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 3);
 	fclose(file);
 
 	std::stringstream input("\n");
@@ -846,12 +882,12 @@ TEST_F(TaskschedulerTest, allegiances_NoTasks) {
 TEST_F(TaskschedulerTest, allegiances_BFS) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n1\n\n");
@@ -865,12 +901,12 @@ TEST_F(TaskschedulerTest, allegiances_BFS) {
 TEST_F(TaskschedulerTest, allegiances_DFS) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("2\n1\n\n");
@@ -884,18 +920,45 @@ TEST_F(TaskschedulerTest, allegiances_DFS) {
 TEST_F(TaskschedulerTest, allegiances_InvalidStartID) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
-	std::stringstream input("1\n3\n\n");
+	std::stringstream input("1\n-1\n\n");
 	std::stringstream output;
 
 	EXPECT_EQ(allegiances(pathFileTasks, input, output), 0);
+	EXPECT_NE(output.str().find("Invalid task ID."), std::string::npos);
+
+	remove(pathFileTasks);
+}
+
+TEST_F(TaskschedulerTest, allegiances_SparseTaskIds) {
+	const char* pathFileTasks = "tasks_with_entries.bin";
+	Task tasksToWrite[2] = {
+		{10, 0, loggedUser, "Task 10", "Description 10", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{20, 0, loggedUser, "Task 20", "Description 20", "2024-01-02", "Category 2", true, true, {10}, 1, {}}
+	};
+
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
+	fclose(file);
+
+	// An id above the task count is still a task
+	std::stringstream input("2\n20\n\n");
+	std::stringstream output;
+	EXPECT_TRUE(allegiances(pathFileTasks, input, output));
+	EXPECT_NE(output.str().find("connected to task 20 is: 2"), std::string::npos);
+
+	// An id with no task counts only itself
+	std::stringstream unknownInput("1\n30\n\n");
+	std::stringstream unknownOutput;
+	EXPECT_TRUE(allegiances(pathFileTasks, unknownInput, unknownOutput));
+	EXPECT_NE(unknownOutput.str().find("connected to task 30 is: 1"), std::string::npos);
 
 	remove(pathFileTasks);
 }
@@ -903,12 +966,12 @@ TEST_F(TaskschedulerTest, allegiances_InvalidStartID) {
 TEST_F(TaskschedulerTest, allegiances_WrongAlgorithmInput) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("3\n1\n\n");
@@ -931,12 +994,12 @@ TEST_F(TaskschedulerTest, calculateMST_InvalidStartID) {
 TEST_F(TaskschedulerTest, calculateMST_InvalidAlgorithmChoice) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n3\n\n");
@@ -950,12 +1013,12 @@ TEST_F(TaskschedulerTest, calculateMST_InvalidAlgorithmChoice) {
 TEST_F(TaskschedulerTest, calculateMST_ValidKruskalChoice) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n2\n\n");
@@ -978,15 +1041,15 @@ TEST_F(TaskschedulerTest, shortestPath_InvalidStartID) {
 TEST_F(TaskschedulerTest, shortestPath_InvalidAlgorithmChoice) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
-	std::stringstream input("1\n3\n\n");
+	std::stringstream input("1\n4\n\n");
 	std::stringstream output;
 
 	EXPECT_FALSE(shortestPath(input, output));
@@ -997,12 +1060,12 @@ TEST_F(TaskschedulerTest, shortestPath_InvalidAlgorithmChoice) {
 TEST_F(TaskschedulerTest, shortestPath_ValidBellmanFordChoice) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n2\n\n");
@@ -1040,12 +1103,12 @@ TEST_F(TaskschedulerTest, huffmanEncodingTaskMenu_NoTasks) {
 TEST_F(TaskschedulerTest, huffmanEncodingTaskMenu_InvalidTaskId) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("3\n\n");
@@ -1059,12 +1122,12 @@ TEST_F(TaskschedulerTest, huffmanEncodingTaskMenu_InvalidTaskId) {
 TEST_F(TaskschedulerTest, huffmanEncodingTaskMenu_ValidTaskId) {
 	const char* pathFileTasks = "tasks_with_entries.bin";
 	Task tasksToWrite[2] = {
-		{1, 0, loggedUser, "Task 1", "This is a sample task description.", "2024-01-01", "Category 1", true, true, {}, 0},
-		{2, 0, loggedUser, "Task 2", "Another task description.", "2024-01-02", "Category 2", true, true, {}, 0}
+		{1, 0, loggedUser, "Task 1", "This is a sample task description.", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Another task description.", "2024-01-02", "Category 2", true, true, {}, 0, {}}
 	};
 
-	FILE* file = fopen(pathFileTasks, "wb");
-	fwrite(tasksToWrite, sizeof(Task), 2, file);
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 2);
 	fclose(file);
 
 	std::stringstream input("1\n\n");
@@ -1117,19 +1180,16 @@ TEST_F(TaskschedulerTest, MainMenu2) {
 TEST_F(TaskschedulerTest, LoginUser_Success) {
 	const char* pathFileUsers = "test_users.bin";
 	User usersToWrite[2] = {
-		{1, "TestName1", "TestSurname1", "test1@example.com", "password1"},
-		{2, "TestName2", "TestSurname2", "test2@example.com", "password2"}
+		{1, "TestName1", "TestSurname1", "test1@example.com", "password1", {}},
+		{2, "TestName2", "TestSurname2", "test2@example.com", "password2", {}}
 	};
 
-	std::ofstream file(pathFileUsers, std::ios::binary);
 	int userCount = 2;
-	file.write(reinterpret_cast<const char*>(&userCount), sizeof(int));
-	file.write(reinterpret_cast<const char*>(&usersToWrite), sizeof(usersToWrite));
-	file.close();
+	writeUsers(pathFileUsers, usersToWrite, userCount);
 
 	simulateUserInput("\n");
 
-	User loginUser = { 2, "TestName2", "TestSurname2", "test2@example.com", "password2" };
+	User loginUser = { 2, "TestName2", "TestSurname2", "test2@example.com", "password2", {} };
 	EXPECT_EQ(::loginUser(loginUser, pathFileUsers, in, out), 1);
 
 	remove(pathFileUsers);
@@ -1138,19 +1198,16 @@ TEST_F(TaskschedulerTest, LoginUser_Success) {
 TEST_F(TaskschedulerTest, LoginUser_Failure) {
 	const char* pathFileUsers = "test_users.bin";
 	User usersToWrite[2] = {
-		{1, "TestName1", "TestSurname1", "test1@example.com", "password1"},
-		{2, "TestName2", "TestSurname2", "test2@example.com", "password2"}
+		{1, "TestName1", "TestSurname1", "test1@example.com", "password1", {}},
+		{2, "TestName2", "TestSurname2", "test2@example.com", "password2", {}}
 	};
 
-	std::ofstream file(pathFileUsers, std::ios::binary);
 	int userCount = 2;
-	file.write(reinterpret_cast<const char*>(&userCount), sizeof(int));
-	file.write(reinterpret_cast<const char*>(&usersToWrite), sizeof(usersToWrite));
-	file.close();
+	writeUsers(pathFileUsers, usersToWrite, userCount);
 
 	simulateUserInput("\n");
 
-	User loginUser = { 2, "TestName2", "TestSurname2", "test2@example.com", "wrongpassword" };
+	User loginUser = { 2, "TestName2", "TestSurname2", "test2@example.com", "wrongpassword", {} };
 	EXPECT_EQ(::loginUser(loginUser, pathFileUsers, in, out), 0);
 
 	remove(pathFileUsers);
@@ -1159,15 +1216,12 @@ TEST_F(TaskschedulerTest, LoginUser_Failure) {
 TEST_F(TaskschedulerTest, loginUserMenu_Success) {
 	const char* pathFileUsers = "test_users.bin";
 	User usersToWrite[2] = {
-		{1, "TestName1", "TestSurname1", "test1@example.com", "password1"},
-		{2, "TestName2", "TestSurname2", "test2@example.com", "password2"}
+		{1, "TestName1", "TestSurname1", "test1@example.com", "password1", {}},
+		{2, "TestName2", "TestSurname2", "test2@example.com", "password2", {}}
 	};
 
-	std::ofstream file(pathFileUsers, std::ios::binary);
 	int userCount = 2;
-	file.write(reinterpret_cast<const char*>(&userCount), sizeof(int));
-	file.write(reinterpret_cast<const char*>(usersToWrite), sizeof(usersToWrite));
-	file.close();
+	writeUsers(pathFileUsers, usersToWrite, userCount);
 
 	simulateUserInput("test2@example.com\npassword2\n\n");
 
@@ -1179,15 +1233,12 @@ TEST_F(TaskschedulerTest, loginUserMenu_Success) {
 TEST_F(TaskschedulerTest, loginUserMenu_Failure) {
 	const char* pathFileUsers = "test_users.bin";
 	User usersToWrite[2] = {
-		{1, "TestName1", "TestSurname1", "test1@example.com", "password1"},
-		{2, "TestName2", "TestSurname2", "test2@example.com", "password2"}
+		{1, "TestName1", "TestSurname1", "test1@example.com", "password1", {}},
+		{2, "TestName2", "TestSurname2", "test2@example.com", "password2", {}}
 	};
 
-	std::ofstream file(pathFileUsers, std::ios::binary);
 	int userCount = 2;
-	file.write(reinterpret_cast<const char*>(&userCount), sizeof(int));
-	file.write(reinterpret_cast<const char*>(usersToWrite), sizeof(usersToWrite));
-	file.close();
+	writeUsers(pathFileUsers, usersToWrite, userCount);
 
 	simulateUserInput("test2@example.com\nwrongpassword\n\n");
 
@@ -1198,12 +1249,9 @@ TEST_F(TaskschedulerTest, loginUserMenu_Failure) {
 
 TEST_F(TaskschedulerTest, registerUser_Success) {
 	const char* pathFileUsers = "test_users.bin";
-	User newUser = { 0, "NewName", "NewSurname", "new@example.com", "newpassword" };
+	User newUser = { 0, "NewName", "NewSurname", "new@example.com", "newpassword", {} };
 
-	std::ofstream file(pathFileUsers, std::ios::binary);
-	int userCount = 0;
-	file.write(reinterpret_cast<const char*>(&userCount), sizeof(int));
-	file.close();
+	ASSERT_TRUE(saveUsers(pathFileUsers, nullptr, 0));
 
 	simulateUserInput("\n\n");
 
@@ -1215,19 +1263,16 @@ TEST_F(TaskschedulerTest, registerUser_Success) {
 TEST_F(TaskschedulerTest, registerUser_UserAlreadyExists) {
 	const char* pathFileUsers = "test_users.bin";
 	User usersToWrite[2] = {
-		{1, "TestName1", "TestSurname1", "test1@example.com", "password1"},
-		{2, "TestName2", "TestSurname2", "test2@example.com", "password2"}
+		{1, "TestName1", "TestSurname1", "test1@example.com", "password1", {}},
+		{2, "TestName2", "TestSurname2", "test2@example.com", "password2", {}}
 	};
 
-	std::ofstream file(pathFileUsers, std::ios::binary);
 	int userCount = 2;
-	file.write(reinterpret_cast<const char*>(&userCount), sizeof(int));
-	file.write(reinterpret_cast<const char*>(usersToWrite), sizeof(usersToWrite));
-	file.close();
+	writeUsers(pathFileUsers, usersToWrite, userCount);
 
 	simulateUserInput("\n\n");
 
-	User newUser = { 0, "TestName2", "TestSurname2", "test2@example.com", "password2" };
+	User newUser = { 0, "TestName2", "TestSurname2", "test2@example.com", "password2", {} };
 	EXPECT_EQ(::registerUser(newUser, pathFileUsers, in, out), 0);
 
 	remove(pathFileUsers);
@@ -1235,10 +1280,7 @@ TEST_F(TaskschedulerTest, registerUser_UserAlreadyExists) {
 
 TEST_F(TaskschedulerTest, registerUserMenu_Success) {
 	const char* pathFileUsers = "test_users.bin";
-	std::ofstream file(pathFileUsers, std::ios::binary);
-	int userCount = 0;
-	file.write(reinterpret_cast<const char*>(&userCount), sizeof(int));
-	file.close();
+	ASSERT_TRUE(saveUsers(pathFileUsers, nullptr, 0));
 
 	simulateUserInput("NewName\nNewSurname\nnew@example.com\nnewpassword\n\n\n");
 
@@ -1250,15 +1292,12 @@ TEST_F(TaskschedulerTest, registerUserMenu_Success) {
 TEST_F(TaskschedulerTest, registerUserMenu_UserAlreadyExists) {
 	const char* pathFileUsers = "test_users.bin";
 	User usersToWrite[2] = {
-		{1, "TestName1", "TestSurname1", "test1@example.com", "password1"},
-		{2, "TestName2", "TestSurname2", "test2@example.com", "password2"}
+		{1, "TestName1", "TestSurname1", "test1@example.com", "password1", {}},
+		{2, "TestName2", "TestSurname2", "test2@example.com", "password2", {}}
 	};
 
-	std::ofstream file(pathFileUsers, std::ios::binary);
 	int userCount = 2;
-	file.write(reinterpret_cast<const char*>(&userCount), sizeof(int));
-	file.write(reinterpret_cast<const char*>(usersToWrite), sizeof(usersToWrite));
-	file.close();
+	writeUsers(pathFileUsers, usersToWrite, userCount);
 
 	simulateUserInput("TestName2\nTestSurname2\ntest2@example.com\npassword2\n\n\n");
 
@@ -1283,19 +1322,16 @@ TEST_F(TaskschedulerTest, UserMenu3) {
 }
 
 TEST_F(TaskschedulerTest, UserMenu4) {
-	simulateUserInput("4\n5\n6\n4\n");
+	simulateUserInput("4\n6\n6\n4\n");
 	EXPECT_EQ(userOperations(in, out), 0);
 }
 
 TEST_F(TaskschedulerTest, LoginUser_NoUsersRegistered) {
 	const char* pathFileUsers = "test_users.bin";
 
-	std::ofstream file(pathFileUsers, std::ios::binary);
-	int userCount = 0;
-	file.write(reinterpret_cast<const char*>(&userCount), sizeof(int));
-	file.close();
+	ASSERT_TRUE(saveUsers(pathFileUsers, nullptr, 0));
 
-	User loginUser = { 0, "TestName", "TestSurname", "test@example.com", "password" };
+	User loginUser = { 0, "TestName", "TestSurname", "test@example.com", "password", {} };
 
 	simulateUserInput("\n");
 
@@ -1304,6 +1340,949 @@ TEST_F(TaskschedulerTest, LoginUser_NoUsersRegistered) {
 	remove(pathFileUsers);
 }
 
+TEST_F(TaskschedulerTest, EncryptData_RoundTrip) {
+	// NIST SP 800-38A, F.2.1: the scheduler key and IV are the CBC-AES128 example values
+	uint8_t data[32] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+	                     0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51 };
+	const uint8_t cipher[32] = { 0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+	                             0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2 };
+	uint8_t original[32];
+	memcpy(original, data, sizeof(data));
+
+	encryptData(data, sizeof(data));
+	EXPECT_EQ(memcmp(data, cipher, sizeof(data)), 0);
+
+	// A second call starts from the same IV again, so the cached key must give the same result
+	decryptData(data, sizeof(data));
+	EXPECT_EQ(memcmp(data, original, sizeof(data)), 0);
+	encryptData(data, sizeof(data));
+	EXPECT_EQ(memcmp(data, cipher, sizeof(data)), 0);
+}
+
+TEST_F(TaskschedulerTest, tagTask_DetectsModification) {
+	Task task = { 1, 0, loggedUser, "Task 1", "Description 1", "01/01/2024", "Category 1", true, true, {2}, 1, {} };
+	// A task that was never tagged is rejected like a modified one
+	EXPECT_FALSE(verifyTask(&task));
+
+	tagTask(&task);
+	EXPECT_TRUE(verifyTask(&task));
+
+	task.dependencies[0] = 3;
+	EXPECT_FALSE(verifyTask(&task));
+
+	tagTask(&task);
+	EXPECT_TRUE(verifyTask(&task));
+	task.tag[5] ^= 0x01;
+	EXPECT_FALSE(verifyTask(&task));
+}
+
+TEST_F(TaskschedulerTest, loadTasks_SkipsModifiedRecord) {
+	const char* pathFileTasks = "tasks_tagged.bin";
+	remove(pathFileTasks);
+	Task first = { 1, 0, loggedUser, "Task 1", "Description 1", "01/01/2024", "Category 1", true, true, {}, 0, {} };
+	Task second = { 2, 0, loggedUser, "Task 2", "Description 2", "02/01/2024", "Category 2", true, true, {}, 0, {} };
+	ASSERT_EQ(addTask(&first, pathFileTasks), 1);
+	ASSERT_EQ(addTask(&second, pathFileTasks), 1);
+
+	// Change the name of the second task on disk
+	FILE* file = fopen(pathFileTasks, "r+b");
+	fseek(file, -(long)sizeof(Task) + (long)offsetof(Task, name), SEEK_END);
+	fputc('X', file);
+	fclose(file);
+
+	Task* tasks = nullptr;
+	int skipped = -1;
+	EXPECT_EQ(loadTasks(pathFileTasks, &tasks, &skipped), 1);
+	EXPECT_EQ(tasks[0].id, 1);
+	EXPECT_EQ(skipped, 1);
+	free(tasks);
+
+	// The modified record does not count towards the next id either
+	EXPECT_EQ(getNewTaskId(pathFileTasks), 2);
+
+	// The listing shows the intact task and says how many were left out
+	EXPECT_TRUE(viewTaskForFunc(pathFileTasks, in, out));
+	EXPECT_NE(out.str().find("ID: 1,"), std::string::npos);
+	EXPECT_EQ(out.str().find("ID: 2,"), std::string::npos);
+	EXPECT_NE(out.str().find("Skipped 1 modified task record(s)."), std::string::npos);
+
+	remove(pathFileTasks);
+}
+
+TEST_F(TaskschedulerTest, verifyTasksFile_CountsModifiedRecords) {
+	const char* pathFileTasks = "tasks_verify.bin";
+	remove(pathFileTasks);
+	EXPECT_EQ(verifyTasksFile(pathFileTasks, 2), -1);
+
+	const int taskCount = 50;
+	for (int i = 1; i <= taskCount; i++) {
+		Task task = { i, i % 5, loggedUser, "Task", "Description", "01/01/2024", "Category", true, true, {}, 0, {} };
+		ASSERT_EQ(addTask(&task, pathFileTasks), 1);
+	}
+	EXPECT_EQ(verifyTasksFile(pathFileTasks, 4), 0);
+
+	FILE* file = fopen(pathFileTasks, "r+b");
+	const int modifiedRecords[] = { 0, 17, 49 };
+	for (int record : modifiedRecords) {
+		fseek(file, (long)(record - taskCount) * (long)sizeof(Task) + (long)offsetof(Task, impid), SEEK_END);
+		fputc(0x7f, file);
+	}
+	fclose(file);
+
+	EXPECT_EQ(verifyTasksFile(pathFileTasks, 1), 3);
+	EXPECT_EQ(verifyTasksFile(pathFileTasks, 4), 3);
+	EXPECT_EQ(verifyTasksFile(pathFileTasks, 0), 3);
+	EXPECT_EQ(verifyTasksFile(pathFileTasks, 64), 3);
+
+	remove(pathFileTasks);
+}
+
+TEST_F(TaskschedulerTest, upgradeRecordFiles_ConvertsUntaggedFiles) {
+	const char* pathFileUsers = "legacy_users.bin";
+	const char* pathFileTasks = "legacy_tasks.bin";
+	// The untagged layout: users without their tag, tasks without the owner's tag and their own, and no header
+	const size_t userSize = offsetof(User, tag);
+	const size_t taskHead = offsetof(Task, owner) + userSize;
+	const size_t taskTail = offsetof(Task, tag) - offsetof(Task, name);
+	User user = { 1, "Old", "User", "old@example.com", "oldpassword", {} };
+	Task task = { 4, 0, user, "Old task", "Description", "01/01/2024", "Category", true, true, {2}, 1, {} };
+	auto writeLegacyTasks = [&]() {
+		FILE* file = fopen(pathFileTasks, "wb");
+		for (int id = 4; id <= 5; id++) {
+			task.id = id;
+			fwrite(&task, taskHead, 1, file);
+			fwrite(task.name, taskTail, 1, file);
+		}
+		fclose(file);
+	};
+
+	FILE* file = fopen(pathFileUsers, "wb");
+	int userCount = 1;
+	fwrite(&userCount, sizeof(int), 1, file);
+	fwrite(&user, userSize, 1, file);
+	fclose(file);
+	writeLegacyTasks();
+
+	EXPECT_TRUE(upgradeRecordFiles(pathFileUsers, pathFileTasks, out));
+	EXPECT_NE(out.str().find("legacy_users.bin was converted"), std::string::npos);
+	EXPECT_NE(out.str().find("legacy_tasks.bin was converted"), std::string::npos);
+	out.str("");
+	EXPECT_TRUE(upgradeRecordFiles(pathFileUsers, pathFileTasks, out));
+	EXPECT_EQ(out.str(), "");
+
+	User login = { 0, "", "", "old@example.com", "oldpassword", {} };
+	simulateUserInput("\n");
+	EXPECT_EQ(::loginUser(login, pathFileUsers, in, out), 1);
+	Task* tasks = nullptr;
+	int skipped = -1;
+	ASSERT_EQ(loadTasks(pathFileTasks, &tasks, &skipped), 2);
+	EXPECT_EQ(skipped, 0);
+	EXPECT_EQ(tasks[1].id, 5);
+	EXPECT_STREQ(tasks[1].category, "Category");
+	EXPECT_EQ(tasks[1].dependencies[0], 2);
+	EXPECT_STREQ(tasks[1].owner.email, "old@example.com");
+	free(tasks);
+
+	// An untagged file is also converted on first use
+	writeLegacyTasks();
+	EXPECT_EQ(getNewTaskId(pathFileTasks), 6);
+	EXPECT_EQ(verifyTasksFile(pathFileTasks, 2), 0);
+
+	// A file in neither layout is reported and left as it is
+	file = fopen(pathFileTasks, "wb");
+	fwrite("garbage", 1, 7, file);
+	fclose(file);
+	out.str("");
+	EXPECT_FALSE(upgradeRecordFiles(pathFileUsers, pathFileTasks, out));
+	EXPECT_NE(out.str().find("legacy_tasks.bin is not in a record format"), std::string::npos);
+	EXPECT_EQ(verifyTasksFile(pathFileTasks, 2), -1);
+	EXPECT_EQ(addTask(&task, pathFileTasks), 0);
+	file = fopen(pathFileTasks, "rb");
+	fseek(file, 0, SEEK_END);
+	EXPECT_EQ(ftell(file), 7);
+	fclose(file);
+
+	remove(pathFileUsers);
+	remove(pathFileTasks);
+}
+
+TEST_F(TaskschedulerTest, loginUser_RejectsModifiedUser) {
+	const char* pathFileUsers = "test_users_tagged.bin";
+	remove(pathFileUsers);
+	User newUser = { 0, "NewName", "NewSurname", "new@example.com", "newpassword", {} };
+
+	simulateUserInput("\n\n\n");
+	ASSERT_EQ(::registerUser(newUser, pathFileUsers, in, out), 1);
+
+	// Overwrite the stored password without updating the tag
+	std::fstream file(pathFileUsers, std::ios::binary | std::ios::in | std::ios::out);
+	file.seekp(-(std::streamoff)sizeof(User) + (std::streamoff)offsetof(User, password), std::ios::end);
+	file.write("hacked", 7);
+	file.close();
+
+	User attacker = { 0, "", "", "new@example.com", "hacked", {} };
+	simulateUserInput("\n");
+	EXPECT_EQ(::loginUser(attacker, pathFileUsers, in, out), 0);
+
+	remove(pathFileUsers);
+}
+
+TEST_F(TaskschedulerTest, encryptEmail_IsDeterministic) {
+	uint8_t first[64], second[64], other[64];
+	size_t length = encryptEmail("test@example.com", first);
+	// The ciphertext is the 16-byte synthetic IV followed by the encrypted email
+	EXPECT_EQ(length, strlen("test@example.com") + 16);
+	EXPECT_EQ(encryptEmail("test@example.com", second), length);
+	EXPECT_EQ(memcmp(first, second, length), 0);
+
+	EXPECT_EQ(encryptEmail("test@example.org", other), length);
+	EXPECT_NE(memcmp(first, other, length), 0);
+}
+
+TEST_F(TaskschedulerTest, findUserByEmail_FollowsUserFile) {
+	const char* pathFileUsers = "test_users_index.bin";
+	remove(pathFileUsers);
+	User first = { 0, "Name1", "Surname1", "one@example.com", "password1", {} };
+	User second = { 0, "Name2", "Surname2", "two@example.com", "password2", {} };
+	User found;
+
+	simulateUserInput("\n\n\n\n");
+	ASSERT_EQ(::registerUser(first, pathFileUsers, in, out), 1);
+	EXPECT_TRUE(findUserByEmail(pathFileUsers, "one@example.com", &found));
+	EXPECT_STREQ(found.name, "Name1");
+	EXPECT_FALSE(findUserByEmail(pathFileUsers, "two@example.com", &found));
+
+	ASSERT_EQ(::registerUser(second, pathFileUsers, in, out), 1);
+	EXPECT_TRUE(findUserByEmail(pathFileUsers, "two@example.com", &found));
+	EXPECT_EQ(found.id, 2);
+
+	// Replace the file behind the index's back: the stale entries must not be trusted
+	User replaced[1] = { { 7, "Other", "User", "two@example.com", "password3", {} } };
+	int userCount = 1;
+	writeUsers(pathFileUsers, replaced, userCount);
+
+	EXPECT_FALSE(findUserByEmail(pathFileUsers, "one@example.com", &found));
+	EXPECT_TRUE(findUserByEmail(pathFileUsers, "two@example.com", &found));
+	EXPECT_EQ(found.id, 7);
+	EXPECT_FALSE(findUserByEmail(pathFileUsers, "three@example.com", &found));
+
+	// A rewrite that keeps the size is noticed through the modification time
+	strcpy(replaced[0].email, "three@example.com");
+	writeUsers(pathFileUsers, replaced, userCount);
+
+	EXPECT_TRUE(findUserByEmail(pathFileUsers, "three@example.com", &found));
+	EXPECT_FALSE(findUserByEmail(pathFileUsers, "two@example.com", &found));
+	EXPECT_FALSE(findUserByEmail("missing_users.bin", "two@example.com", &found));
+
+	remove(pathFileUsers);
+}
+
+TEST_F(TaskschedulerTest, buildTaskGraph_MapsSparseIds) {
+	TaskGraph graph;
+	std::vector<int> taskIds = { 1000000, 7, 1 };
+	std::vector<Edge> dependencies = { { 1000000, 250, 1000250 }, { 1000000, 1, 1000001 } };
+
+	buildTaskGraph(taskIds, dependencies, &graph);
+
+	ASSERT_EQ(graph.ids.size(), 4u);
+	EXPECT_EQ(graph.ids[0], 1);
+	EXPECT_EQ(graph.ids[3], 1000000);
+	EXPECT_EQ(taskGraphIndex(graph, 250), 2);
+	EXPECT_EQ(taskGraphIndex(graph, 99), -1);
+	EXPECT_EQ(graph.offsets.back(), 4);
+	EXPECT_EQ(graph.depOffsets.back(), 2);
+	EXPECT_EQ(graph.offsets[4] - graph.offsets[3], 2);
+	EXPECT_EQ(graph.depOffsets[1] - graph.depOffsets[0], 0);
+}
+
+TEST_F(TaskschedulerTest, loadTasksAndDependencies_LargeTaskIds) {
+	const char* pathFileTasks = "tasks_large_ids.bin";
+	Task tasksToWrite[4] = {
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{250, 0, loggedUser, "Task 250", "Description 250", "2024-01-02", "Category 2", true, true, {1}, 1, {}},
+		{1000000, 0, loggedUser, "Task 1000000", "Description", "2024-01-03", "Category 3", true, true, {250, 1}, 2, {}},
+		{7, 0, loggedUser, "Task 7", "Description 7", "2024-01-04", "Category 4", true, true, {}, 0, {}}
+	};
+
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, tasksToWrite, 4);
+	fclose(file);
+
+	ASSERT_TRUE(loadTasksAndDependencies(pathFileTasks));
+	EXPECT_EQ(BFS(1), 3);
+	EXPECT_EQ(DFS(1000000), 3);
+	EXPECT_EQ(BFS(7), 1);
+	EXPECT_EQ(DFS(42), 1);
+
+	std::stringstream dijkstra;
+	calculateShortestPath(1, dijkstra);
+	EXPECT_NE(dijkstra.str().find("250\t251\n"), std::string::npos);
+	EXPECT_NE(dijkstra.str().find("1000000\t1000001\n"), std::string::npos);
+
+	std::stringstream bellmanFord;
+	calculateBellmanFord(1, 4, bellmanFord);
+	EXPECT_EQ(bellmanFord.str(), dijkstra.str());
+
+	std::stringstream kruskal;
+	kruskalMST(4, kruskal);
+	EXPECT_EQ(kruskal.str(), "Edge \tWeight\n1 - 250\t251 \n1 - 1000000\t1000001 \n");
+
+	std::stringstream prim;
+	primMST(250, prim);
+	EXPECT_NE(prim.str().find("250 - 1\t251 \n"), std::string::npos);
+	EXPECT_NE(prim.str().find("1 - 1000000\t1000001 \n"), std::string::npos);
+
+	std::stringstream scc;
+	findSCCs(taskGraph, scc);
+	EXPECT_NE(scc.str().find("SCC #4: "), std::string::npos);
+	EXPECT_EQ(scc.str().find("SCC #5: "), std::string::npos);
+
+	remove(pathFileTasks);
+	remove("tasks_large_ids.bin.dist");
+}
+
+TEST_F(TaskschedulerTest, syncTaskGraph_FollowsAddTask) {
+	const char* pathFileTasks = "tasks_graph_sync.bin";
+	remove(pathFileTasks);
+	Task first = {1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}};
+	Task second = {3, 0, loggedUser, "Task 3", "Description 3", "2024-01-02", "Category 2", true, true, {1}, 1, {}};
+	Task third = {2, 0, loggedUser, "Task 2", "Description 2", "2024-01-03", "Category 3", true, true, {3, 5}, 2, {}};
+	ASSERT_EQ(addTask(&first, pathFileTasks), 1);
+	ASSERT_EQ(addTask(&second, pathFileTasks), 1);
+
+	unsigned long long generation = syncTaskGraph(pathFileTasks).generation;
+	EXPECT_EQ(syncTaskGraph(pathFileTasks).generation, generation);
+	EXPECT_EQ(taskGraph.offsets.back(), 2);
+
+	// Task 2 lands between existing vertices and brings a new vertex 5 along
+	ASSERT_EQ(addTask(&third, pathFileTasks), 1);
+	EXPECT_EQ(taskGraph.generation, generation + 1);
+	EXPECT_EQ(syncTaskGraph(pathFileTasks).generation, generation + 1);
+	EXPECT_EQ(BFS(1), 4);
+
+	TaskGraph rebuilt;
+	std::vector<int> taskIds = { 1, 3, 2 };
+	std::vector<Edge> dependencies = { { 3, 1, 4 }, { 2, 3, 5 }, { 2, 5, 7 } };
+	buildTaskGraph(taskIds, dependencies, &rebuilt);
+	EXPECT_EQ(taskGraph.ids, rebuilt.ids);
+	EXPECT_EQ(taskGraph.offsets, rebuilt.offsets);
+	EXPECT_EQ(taskGraph.targets, rebuilt.targets);
+	EXPECT_EQ(taskGraph.weights, rebuilt.weights);
+	EXPECT_EQ(taskGraph.depOffsets, rebuilt.depOffsets);
+	EXPECT_EQ(taskGraph.depTargets, rebuilt.depTargets);
+	EXPECT_EQ(taskGraph.dependentOffsets, rebuilt.dependentOffsets);
+	EXPECT_EQ(taskGraph.dependentTargets, rebuilt.dependentTargets);
+
+	// A rewrite that drops a record changes the file size and forces a reload
+	FILE* file = createTasksFile(pathFileTasks);
+	writeTasks(file, &first, 1);
+	fclose(file);
+	unsigned long long reloaded = syncTaskGraph(pathFileTasks).generation;
+	EXPECT_GT(reloaded, generation + 1);
+	EXPECT_EQ(taskGraph.ids.size(), 1u);
+
+	// A same-size rewrite only moves the modification time and must still force a reload
+	first.dependencies[0] = 9;
+	first.numDependencies = 1;
+	file = createTasksFile(pathFileTasks);
+	writeTasks(file, &first, 1);
+	fclose(file);
+	EXPECT_GT(syncTaskGraph(pathFileTasks).generation, reloaded);
+	EXPECT_EQ(taskGraph.ids.size(), 2u);
+
+	remove(pathFileTasks);
+}
+
+TEST_F(TaskschedulerTest, directionOptimizingBFS_MatchesBFS) {
+	// A dense cluster around a hub makes the search go bottom-up, the long chain brings it back top-down
+	std::vector<int> taskIds;
+	std::vector<Edge> dependencies;
+	unsigned seed = 12345;
+	for (int id = 1; id <= 3000; id++) {
+		taskIds.push_back(id);
+	}
+	for (int id = 2; id <= 1500; id++) {
+		for (int k = 0; k < 6; k++) {
+			nextRandom(seed);
+			dependencies.push_back({ id, 1 + (int)((seed >> 8) % (id - 1)), 0 });
+		}
+	}
+	for (int id = 1501; id <= 2900; id++) {
+		dependencies.push_back({ id, id - 1, 0 });
+	}
+
+	buildTaskGraph(taskIds, dependencies, &taskGraph);
+	EXPECT_EQ(BFS(1), 2900);
+
+	for (int threads = 1; threads <= 3; threads += 2) {
+		std::vector<int> depths;
+		EXPECT_EQ(directionOptimizingBFS(taskGraph, 1, threads, &depths), 2900);
+		EXPECT_EQ(depths[0], 0);
+		EXPECT_EQ(depths[2899], depths[1499] + 1400);
+		EXPECT_EQ(depths[2999], -1);
+
+		// Every reached vertex must sit one level below some neighbour, and no edge may skip a level
+		for (int v = 1; v < 2900; v++) {
+			bool hasParent = false;
+			for (int e = taskGraph.offsets[v]; e < taskGraph.offsets[v + 1]; e++) {
+				int u = taskGraph.targets[e];
+				EXPECT_LE(abs(depths[u] - depths[v]), 1);
+				hasParent = hasParent || depths[u] == depths[v] - 1;
+			}
+			EXPECT_TRUE(hasParent);
+		}
+	}
+
+	EXPECT_EQ(directionOptimizingBFS(taskGraph, 2950, 2, nullptr), 1);
+	EXPECT_EQ(directionOptimizingBFS(taskGraph, 99999, 2, nullptr), 1);
+}
+
+TEST_F(TaskschedulerTest, findStronglyConnectedComponents_GroupsCycles) {
+	TaskGraph graph;
+	std::vector<int> taskIds = { 1, 2, 3, 4, 5 };
+	std::vector<Edge> dependencies = { { 1, 2, 0 }, { 2, 3, 0 }, { 3, 1, 0 }, { 4, 1, 0 }, { 3, 5, 0 } };
+	buildTaskGraph(taskIds, dependencies, &graph);
+
+	std::vector<int> components;
+	ASSERT_EQ(findStronglyConnectedComponents(graph, &components), 3);
+	EXPECT_EQ(components[0], components[1]);
+	EXPECT_EQ(components[1], components[2]);
+	EXPECT_LT(components[3], components[0]);
+	EXPECT_LT(components[0], components[4]);
+
+	std::stringstream output;
+	findSCCs(graph, output);
+	EXPECT_EQ(output.str(), "SCC #1: 4 \nSCC #2: 1 2 3 \nSCC #3: 5 \n");
+}
+
+TEST_F(TaskschedulerTest, findStronglyConnectedComponents_LongChain) {
+	// Deep enough to overflow the call stack of a recursive search
+	const int chainLength = 500000;
+	std::vector<int> taskIds;
+	std::vector<Edge> dependencies;
+	for (int id = 1; id <= chainLength; id++) {
+		taskIds.push_back(id);
+		dependencies.push_back({ id, id % chainLength + 1, 0 });
+	}
+	buildTaskGraph(taskIds, dependencies, &taskGraph);
+
+	std::vector<int> components;
+	EXPECT_EQ(findStronglyConnectedComponents(taskGraph, &components), 1);
+	EXPECT_EQ(DFS(1), chainLength);
+
+	dependencies.pop_back();
+	buildTaskGraph(taskIds, dependencies, &taskGraph);
+	EXPECT_EQ(findStronglyConnectedComponents(taskGraph, &components), chainLength);
+	EXPECT_EQ(components[0], 0);
+	EXPECT_EQ(components[chainLength - 1], chainLength - 1);
+}
+
+TEST_F(TaskschedulerTest, parallelStronglyConnectedComponents_MatchesTarjan) {
+	// Large enough to take the parallel path: a giant cycle, small cycles and a long acyclic tail
+	const int taskCount = 150000;
+	std::vector<int> taskIds;
+	std::vector<Edge> dependencies;
+	unsigned seed = 777;
+	for (int id = 1; id <= taskCount; id++) {
+		taskIds.push_back(id);
+		if (id > 1) {
+			for (int k = 0; k < 2; k++) {
+				nextRandom(seed);
+				dependencies.push_back({ id, 1 + (int)((seed >> 8) % (id - 1)), 0 });
+			}
+		}
+		if (id < 30000) {
+			dependencies.push_back({ id, id + 1, 0 });
+		}
+		if (id % 50 == 0 && id + 20 <= taskCount) {
+			dependencies.push_back({ id, id + 20, 0 });
+		}
+	}
+	dependencies.push_back({ 30000, 1, 0 });
+	TaskGraph graph;
+	buildTaskGraph(taskIds, dependencies, &graph);
+
+	std::vector<int> sequential;
+	int sequentialCount = findStronglyConnectedComponents(graph, &sequential);
+
+	for (int threads = 1; threads <= 3; threads += 2) {
+		std::vector<int> parallel;
+		ASSERT_EQ(parallelStronglyConnectedComponents(graph, threads, &parallel), sequentialCount);
+
+		std::vector<int> matching(sequentialCount, -1);
+		for (int v = 0; v < taskCount; v++) {
+			if (matching[sequential[v]] < 0) {
+				matching[sequential[v]] = parallel[v];
+			}
+			ASSERT_EQ(matching[sequential[v]], parallel[v]);
+			for (int e = graph.depOffsets[v]; e < graph.depOffsets[v + 1]; e++) {
+				ASSERT_LE(parallel[v], parallel[graph.depTargets[e]]);
+			}
+		}
+	}
+}
+
+TEST_F(TaskschedulerTest, addTaskToGraph_KeepsTopologicalOrder) {
+	TaskGraph graph;
+	buildTaskGraph(std::vector<int>(), std::vector<Edge>(), &graph);
+	unsigned seed = 777;
+	int rejected = 0;
+
+	for (int id = 1; id <= 400; id++) {
+		Task task = {};
+		task.id = id;
+		for (int k = 0; k < 3; k++) {
+			nextRandom(seed);
+			int dependency = 1 + (int)((seed >> 8) % 500);
+			// Dependencies on tasks not added yet make later tasks able to close cycles
+			if (dependencyCreatesCycle(graph, id, dependency)) {
+				rejected++;
+				continue;
+			}
+			task.dependencies[task.numDependencies++] = dependency;
+		}
+		addTaskToGraph(&graph, &task);
+		ASSERT_TRUE(graph.acyclic);
+	}
+	EXPECT_GT(rejected, 0);
+
+	int V = (int)graph.ids.size();
+	std::vector<int> positions(graph.topoOrder);
+	std::sort(positions.begin(), positions.end());
+	for (int v = 0; v < V; v++) {
+		ASSERT_EQ(positions[v], v);
+		for (int e = graph.depOffsets[v]; e < graph.depOffsets[v + 1]; e++) {
+			ASSERT_LT(graph.topoOrder[v], graph.topoOrder[graph.depTargets[e]]);
+		}
+	}
+
+	// The first task gets a dependency on one of the tasks that depend on it
+	Task closing = {};
+	closing.id = graph.ids[0];
+	for (int v = 0; v < V && closing.numDependencies == 0; v++) {
+		if (dependencyCreatesCycle(graph, closing.id, graph.ids[v])) {
+			closing.dependencies[closing.numDependencies++] = graph.ids[v];
+		}
+	}
+	ASSERT_EQ(closing.numDependencies, 1);
+	addTaskToGraph(&graph, &closing);
+	EXPECT_FALSE(graph.acyclic);
+	EXPECT_TRUE(graph.topoOrder.empty());
+	EXPECT_TRUE(dependencyCreatesCycle(graph, closing.dependencies[0], closing.id));
+}
+
+TEST_F(TaskschedulerTest, addTaskMenu_SkipsCyclicDependency) {
+	const char* pathFileTasks = "tasks_cycle_menu.bin";
+	remove(pathFileTasks);
+	// Task 2 already depends on task 3, which is the next id to be given out
+	Task first = {1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}};
+	Task second = {2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {1, 3}, 2, {}};
+	ASSERT_EQ(addTask(&first, pathFileTasks), 1);
+	ASSERT_EQ(addTask(&second, pathFileTasks), 1);
+
+	simulateUserInput("Task 3\nDescription 3\n2\n2\n1\n\n");
+	EXPECT_EQ(addTaskMenu(pathFileTasks, in, out), 1);
+	EXPECT_NE(out.str().find("Dependency on task 2 would create a cycle and was skipped."), std::string::npos);
+	EXPECT_EQ(out.str().find("Dependency on task 1 would"), std::string::npos);
+
+	const TaskGraph& graph = syncTaskGraph(pathFileTasks);
+	EXPECT_TRUE(graph.acyclic);
+	int task3 = taskGraphIndex(graph, 3);
+	ASSERT_EQ(graph.depOffsets[task3 + 1] - graph.depOffsets[task3], 1);
+	EXPECT_EQ(graph.ids[graph.depTargets[graph.depOffsets[task3]]], 1);
+
+	remove(pathFileTasks);
+}
+
+TEST_F(TaskschedulerTest, planTaskGraph_CriticalPath) {
+	// 2 and 3 both wait for 1, 4 waits for both; 3 is the longer branch
+	TaskGraph graph;
+	std::vector<int> taskIds = { 1, 2, 3, 4 };
+	std::vector<Edge> dependencies = { { 2, 1, 3 }, { 3, 1, 4 }, { 4, 2, 6 }, { 4, 3, 7 } };
+	buildTaskGraph(taskIds, dependencies, &graph);
+
+	TaskPlan plan;
+	ASSERT_TRUE(planTaskGraph(graph, { 2, 1, 4, 3 }, &plan));
+	EXPECT_EQ(plan.earliestStart, std::vector<int>({ 0, 2, 2, 6 }));
+	EXPECT_EQ(plan.makespan, 9);
+	EXPECT_EQ(plan.makespan - plan.remaining[1] - plan.earliestStart[1], 3);
+	EXPECT_EQ(criticalPath(graph, plan), std::vector<int>({ 1, 3, 4 }));
+
+	// Lengthening task 2 moves the critical path onto it
+	ASSERT_TRUE(setPlannedDuration(graph, &plan, 2, 6));
+	EXPECT_EQ(plan.earliestStart[3], 8);
+	EXPECT_EQ(plan.makespan, 11);
+	EXPECT_EQ(criticalPath(graph, plan), std::vector<int>({ 1, 2, 4 }));
+	ASSERT_TRUE(setPlannedDuration(graph, &plan, 2, 1));
+	EXPECT_EQ(plan.makespan, 9);
+
+	std::ostringstream printed;
+	printTaskPlan(graph, plan, printed);
+	EXPECT_NE(printed.str().find("Task 2: duration 1, earliest start 2, latest start 5, slack 3"), std::string::npos);
+	EXPECT_NE(printed.str().find("Critical path: 1 -> 3 -> 4\nTotal duration: 9"), std::string::npos);
+
+	dependencies.push_back({ 1, 4, 5 });
+	buildTaskGraph(taskIds, dependencies, &graph);
+	EXPECT_FALSE(planTaskGraph(graph, { 2, 1, 4, 3 }, &plan));
+}
+
+TEST_F(TaskschedulerTest, planSchedule_KeepsDurationsAcrossRestart) {
+	const char* pathFileTasks = "tasks_plan_saved.bin";
+	remove(pathFileTasks);
+	remove("tasks_plan_saved.bin.plan");
+	Task first = {1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}};
+	Task second = {2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {1}, 1, {}};
+	ASSERT_EQ(addTask(&first, pathFileTasks), 1);
+	ASSERT_EQ(addTask(&second, pathFileTasks), 1);
+
+	simulateUserInput("2\n5\n0\n\n");
+	EXPECT_TRUE(planSchedule(pathFileTasks, in, out));
+	EXPECT_NE(out.str().find("Task 2: duration 5"), std::string::npos);
+
+	// Loading another task file drops the plan held in memory, as a restart would
+	EXPECT_FALSE(loadTasksAndDependencies("missing_tasks.bin"));
+	out.str("");
+	simulateUserInput("0\n\n");
+	EXPECT_TRUE(planSchedule(pathFileTasks, in, out));
+	EXPECT_NE(out.str().find("Task 1: duration 1"), std::string::npos);
+	EXPECT_NE(out.str().find("Task 2: duration 5"), std::string::npos);
+	EXPECT_NE(out.str().find("Total duration: 6"), std::string::npos);
+
+	remove(pathFileTasks);
+	remove("tasks_plan_saved.bin.plan");
+}
+
+TEST_F(TaskschedulerTest, addTaskToPlan_MatchesFullPlan) {
+	TaskGraph graph;
+	buildTaskGraph(std::vector<int>(), std::vector<Edge>(), &graph);
+	TaskPlan plan;
+	ASSERT_TRUE(planTaskGraph(graph, std::vector<int>(), &plan));
+	unsigned seed = 4242;
+
+	for (int id = 1; id <= 300; id++) {
+		Task task = {};
+		task.id = id;
+		for (int k = 0; k < 3; k++) {
+			nextRandom(seed);
+			int dependency = 1 + (int)((seed >> 8) % 350);
+			if (!dependencyCreatesCycle(graph, id, dependency)) {
+				task.dependencies[task.numDependencies++] = dependency;
+			}
+		}
+		addTaskToGraph(&graph, &task);
+		ASSERT_TRUE(addTaskToPlan(graph, &plan, &task, 1 + id % 7));
+		if (id % 10 == 0) {
+			ASSERT_TRUE(setPlannedDuration(graph, &plan, 1 + (int)(seed % id), (int)(seed >> 20) % 9));
+		}
+	}
+
+	TaskPlan full;
+	ASSERT_TRUE(planTaskGraph(graph, plan.durations, &full));
+	EXPECT_EQ(plan.ids, full.ids);
+	EXPECT_EQ(plan.earliestStart, full.earliestStart);
+	EXPECT_EQ(plan.remaining, full.remaining);
+	EXPECT_EQ(plan.makespan, full.makespan);
+}
+
+TEST_F(TaskschedulerTest, executeTaskGraph_RunsDependenciesFirst) {
+	std::vector<int> taskIds;
+	std::vector<Edge> dependencies;
+	unsigned seed = 99;
+	for (int id = 1; id <= 2000; id++) {
+		taskIds.push_back(id);
+		for (int k = 0; id > 1 && k < 4; k++) {
+			nextRandom(seed);
+			int dependency = 1 + (int)((seed >> 8) % (id - 1));
+			dependencies.push_back({ id, dependency, id + dependency });
+		}
+	}
+	TaskGraph graph;
+	buildTaskGraph(taskIds, dependencies, &graph);
+
+	for (int threads = 1; threads <= 4; threads += 3) {
+		std::vector<std::atomic<int>> started(2001);
+		std::vector<std::atomic<int>> finished(2001);
+		std::atomic<int> clock(0);
+		ASSERT_EQ(executeTaskGraph(graph, threads, [&](int taskId) {
+			started[taskId].store(++clock);
+			finished[taskId].store(++clock);
+		}), 2000);
+
+		for (size_t i = 0; i < dependencies.size(); i++) {
+			ASSERT_GT(finished[dependencies[i].dest].load(), 0);
+			ASSERT_LT(finished[dependencies[i].dest].load(), started[dependencies[i].src].load());
+		}
+	}
+
+	dependencies.push_back({ 1, 2000, 2001 });
+	buildTaskGraph(taskIds, dependencies, &graph);
+	EXPECT_EQ(executeTaskGraph(graph, 2, [](int) {}), -1);
+}
+
+TEST_F(TaskschedulerTest, executeTaskGraph_NestedAndThrowingCallbacks) {
+	std::vector<int> taskIds;
+	std::vector<Edge> dependencies;
+	for (int id = 1; id <= 200; id++) {
+		taskIds.push_back(id);
+		if (id > 1) {
+			dependencies.push_back({ id, id / 2, id + id / 2 });
+		}
+	}
+	TaskGraph graph;
+	buildTaskGraph(taskIds, dependencies, &graph);
+
+	// A callback that runs a parallel algorithm of its own must not wait for the pool it is running on
+	std::atomic<int> nested(0);
+	EXPECT_EQ(executeTaskGraph(graph, 4, [&](int taskId) {
+		if (taskId % 50 == 0) {
+			nested += executeTaskGraph(graph, 2, [](int) {});
+		}
+	}), 200);
+	EXPECT_EQ(nested.load(), 4 * 200);
+
+	// An exception ends the run on whichever worker it is thrown and reaches the caller
+	for (int failing = 1; failing <= 200; failing += 199) {
+		std::atomic<int> ran(0);
+		EXPECT_THROW(executeTaskGraph(graph, 4, [&](int taskId) {
+			ran++;
+			if (taskId == failing) {
+				throw std::runtime_error("task failed");
+			}
+		}), std::runtime_error);
+		EXPECT_LE(ran.load(), 200);
+	}
+
+	// The pool is still usable afterwards
+	std::atomic<int> ran(0);
+	EXPECT_EQ(executeTaskGraph(graph, 4, [&](int) { ran++; }), 200);
+	EXPECT_EQ(ran.load(), 200);
+}
+
+TEST_F(TaskschedulerTest, primMST_SpansEveryComponent) {
+	// Two components: 1-2-3 with a heavier shortcut 1-3, and 10-11
+	std::vector<int> taskIds = { 1, 2, 3, 10, 11 };
+	std::vector<Edge> dependencies = { { 2, 1, 3 }, { 3, 2, 5 }, { 3, 1, 9 }, { 11, 10, 21 } };
+	buildTaskGraph(taskIds, dependencies, &taskGraph);
+
+	std::stringstream prim;
+	primMST(10, prim);
+	EXPECT_EQ(prim.str(), "Edge \tWeight\n1 - 2\t3 \n2 - 3\t5 \n10 - 11\t21 \n");
+}
+
+TEST_F(TaskschedulerTest, boruvkaMST_MatchesKruskal) {
+	// Few distinct weights make many ties; ids above 3000 form a second component
+	std::vector<int> taskIds;
+	std::vector<Edge> dependencies;
+	unsigned seed = 2024;
+	for (int id = 1; id <= 4000; id++) {
+		taskIds.push_back(id);
+		int base = id > 3000 ? 3001 : 1;
+		for (int k = 0; id > base && k < 3; k++) {
+			nextRandom(seed);
+			int dependency = base + (int)((seed >> 8) % (id - base));
+			dependencies.push_back({ id, dependency, (int)(seed >> 24) % 5 });
+		}
+	}
+	TaskGraph graph;
+	buildTaskGraph(taskIds, dependencies, &graph);
+
+	std::vector<Edge> kruskal;
+	long long kruskalWeight = kruskalForest(graph, (int)graph.ids.size(), &kruskal);
+	EXPECT_EQ(kruskal.size(), 3998u);
+	for (size_t i = 1; i < kruskal.size(); i++) {
+		ASSERT_LE(kruskal[i - 1].weight, kruskal[i].weight);
+	}
+
+	for (int threads = 1; threads <= 3; threads += 2) {
+		std::vector<Edge> boruvka;
+		EXPECT_EQ(boruvkaMST(graph, threads, &boruvka), kruskalWeight);
+		EXPECT_EQ(boruvka.size(), kruskal.size());
+	}
+}
+
+TEST_F(TaskschedulerTest, findShortestRoute_FollowsParents) {
+	// 1-2-4 costs 3 + 6, the direct edge 1-4 costs 11 (id sums), 7-8 is a separate component
+	std::vector<int> taskIds = { 1, 2, 4, 7, 8 };
+	std::vector<Edge> dependencies = { { 2, 1, 3 }, { 4, 2, 6 }, { 4, 1, 11 }, { 8, 7, 15 } };
+	TaskGraph graph;
+	buildTaskGraph(taskIds, dependencies, &graph);
+
+	std::vector<int> route;
+	EXPECT_EQ(findShortestRoute(graph, 1, 4, &route), 9);
+	EXPECT_EQ(route, std::vector<int>({ 1, 2, 4 }));
+	EXPECT_EQ(findShortestRoute(graph, 4, 4, &route), 0);
+	EXPECT_EQ(route, std::vector<int>({ 4 }));
+	EXPECT_EQ(findShortestRoute(graph, 1, 8, &route), -1);
+	EXPECT_TRUE(route.empty());
+	EXPECT_EQ(findShortestRoute(graph, 1, 5, &route), -1);
+}
+
+TEST_F(TaskschedulerTest, shortestPath_DijkstraRoute) {
+	const char* pathFileTasks = "Tasks.bin";
+	remove(pathFileTasks);
+	Task tasksToWrite[3] = {
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {1}, 1, {}},
+		{3, 0, loggedUser, "Task 3", "Description 3", "2024-01-03", "Category 3", true, true, {2}, 1, {}}
+	};
+	for (int i = 0; i < 3; i++) {
+		ASSERT_EQ(addTask(&tasksToWrite[i], pathFileTasks), 1);
+	}
+
+	std::stringstream input("1\n1\n3\n\n");
+	std::stringstream output;
+	EXPECT_TRUE(shortestPath(input, output));
+	EXPECT_NE(output.str().find("Shortest route: 1 -> 2 -> 3\nDistance: 8\n"), std::string::npos);
+
+	remove(pathFileTasks);
+}
+
+TEST_F(TaskschedulerTest, deltaSteppingDistances_MatchesDijkstra) {
+	// Light chain edges and heavy shortcuts; ids above 1800 are not connected to task 1
+	std::vector<int> taskIds;
+	std::vector<Edge> dependencies;
+	unsigned seed = 31337;
+	for (int id = 1; id <= 2000; id++) {
+		taskIds.push_back(id);
+		if (id > 1 && id <= 1800) {
+			nextRandom(seed);
+			int dependency = 1 + (int)((seed >> 8) % (id - 1));
+			dependencies.push_back({ id, id - 1, 1 + (int)(seed >> 28) });
+			dependencies.push_back({ id, dependency, 50 + (int)((seed >> 12) % 500) });
+		}
+	}
+	TaskGraph graph;
+	buildTaskGraph(taskIds, dependencies, &graph);
+
+	std::vector<int> expected;
+	int reached = dijkstraDistances(graph, 1, &expected);
+	EXPECT_EQ(reached, 1800);
+	for (int threads = 1; threads <= 3; threads += 2) {
+		for (int delta : { 0, 1, 40, 100000 }) {
+			std::vector<int> dist;
+			EXPECT_EQ(deltaSteppingDistances(graph, 1, threads, delta, &dist), reached);
+			EXPECT_EQ(dist, expected);
+		}
+	}
+
+	std::vector<int> dist;
+	EXPECT_EQ(deltaSteppingDistances(graph, 5000, 2, 0, &dist), 0);
+}
+
+TEST_F(TaskschedulerTest, bellmanFordDistances_ReturnsNegativeCycle) {
+	std::vector<int> taskIds = { 1, 2, 3, 4, 5 };
+	std::vector<Edge> dependencies = { { 2, 1, 3 }, { 3, 2, 5 }, { 4, 3, 7 }, { 5, 1, 6 }, { 5, 4, 9 } };
+	TaskGraph graph;
+	buildTaskGraph(taskIds, dependencies, &graph);
+
+	std::vector<int> dist;
+	std::vector<int> expected;
+	std::vector<int> cycle;
+	EXPECT_EQ(bellmanFordDistances(graph, 1, 5, &dist, &cycle), dijkstraDistances(graph, 1, &expected));
+	EXPECT_EQ(dist, expected);
+	EXPECT_TRUE(cycle.empty());
+
+	// An undirected edge of negative weight is a cycle there and back
+	dependencies.push_back({ 4, 3, -10 });
+	buildTaskGraph(taskIds, dependencies, &graph);
+	EXPECT_EQ(bellmanFordDistances(graph, 1, 5, &dist, &cycle), -1);
+	std::sort(cycle.begin(), cycle.end());
+	EXPECT_EQ(cycle, std::vector<int>({ 3, 4 }));
+
+	// Beyond the first three vertices the cycle is out of reach
+	EXPECT_EQ(bellmanFordDistances(graph, 1, 3, &dist, &cycle), 3);
+	EXPECT_EQ(dist, std::vector<int>({ 0, 3, 8 }));
+}
+
+TEST_F(TaskschedulerTest, allPairsDistances_MatchesDijkstra) {
+	// 300 tasks span several tiles without filling the last one; ids above 280 are not connected to the rest
+	std::vector<int> taskIds;
+	std::vector<Edge> dependencies;
+	unsigned seed = 4242;
+	for (int id = 1; id <= 300; id++) {
+		taskIds.push_back(id);
+		if (id > 1 && id <= 280) {
+			nextRandom(seed);
+			int dependency = 1 + (int)((seed >> 8) % (id - 1));
+			dependencies.push_back({ id, id - 1, 1 + (int)(seed >> 28) });
+			dependencies.push_back({ id, dependency, 5 + (int)((seed >> 12) % 50) });
+		}
+	}
+	TaskGraph graph;
+	buildTaskGraph(taskIds, dependencies, &graph);
+
+	for (int threads = 1; threads <= 3; threads += 2) {
+		std::vector<int> all;
+		ASSERT_TRUE(allPairsDistances(graph, threads, &all));
+		ASSERT_EQ(all.size(), graph.ids.size() * graph.ids.size());
+		for (size_t u = 0; u < graph.ids.size(); u += 7) {
+			std::vector<int> expected;
+			dijkstraDistances(graph, graph.ids[u], &expected);
+			std::vector<int> row(all.begin() + u * graph.ids.size(), all.begin() + (u + 1) * graph.ids.size());
+			EXPECT_EQ(row, expected);
+		}
+	}
+
+	TaskGraph negative;
+	buildTaskGraph({ 1, 2 }, { { 2, 1, -3 } }, &negative);
+	std::vector<int> all;
+	EXPECT_FALSE(allPairsDistances(negative, 1, &all));
+}
+
+TEST_F(TaskschedulerTest, shortestPath_PersistsDistanceCache) {
+	const char* pathFileTasks = "Tasks.bin";
+	const char* pathFileDistances = "Tasks.bin.dist";
+	remove(pathFileTasks);
+	remove(pathFileDistances);
+	Task tasksToWrite[3] = {
+		{1, 0, loggedUser, "Task 1", "Description 1", "2024-01-01", "Category 1", true, true, {}, 0, {}},
+		{2, 0, loggedUser, "Task 2", "Description 2", "2024-01-02", "Category 2", true, true, {1}, 1, {}},
+		{3, 0, loggedUser, "Task 3", "Description 3", "2024-01-03", "Category 3", true, true, {2}, 1, {}}
+	};
+	for (int i = 0; i < 3; i++) {
+		ASSERT_EQ(addTask(&tasksToWrite[i], pathFileTasks), 1);
+	}
+
+	std::stringstream input("1\n1\n0\n\n");
+	std::stringstream output;
+	EXPECT_TRUE(shortestPath(input, output));
+	EXPECT_NE(output.str().find("3\t8\n"), std::string::npos);
+
+	// Magic, version, int size and byte order, then the checksum, the vertex count and the matrix
+	const long headerSize = 4 + 4 + 4 + 4 + 8 + 4;
+	FILE* file = fopen(pathFileDistances, "rb");
+	ASSERT_NE(file, nullptr);
+	fseek(file, 0, SEEK_END);
+	EXPECT_EQ(ftell(file), headerSize + 3 * 3 * (long)sizeof(int));
+	fclose(file);
+
+	// An intact file is read back rather than recomputed
+	std::vector<int> distances = *cachedTaskGraphDistances();
+	int marked = 12345;
+	file = fopen(pathFileDistances, "r+b");
+	fseek(file, headerSize, SEEK_SET);
+	fwrite(&marked, sizeof(int), 1, file);
+	fclose(file);
+	taskGraph.generation++;
+	EXPECT_EQ((*cachedTaskGraphDistances())[0], marked);
+
+	// A file with another layout version or another graph checksum is ignored and replaced
+	const long offsets[] = { 4, 16 };
+	for (long offset : offsets) {
+		file = fopen(pathFileDistances, "r+b");
+		fseek(file, offset, SEEK_SET);
+		fwrite("stale", 1, 4, file);
+		fclose(file);
+		taskGraph.generation++;
+		const std::vector<int>* reloaded = cachedTaskGraphDistances();
+		ASSERT_NE(reloaded, nullptr);
+		EXPECT_EQ(*reloaded, distances);
+	}
+
+	remove(pathFileTasks);
+	remove(pathFileDistances);
+}
+
 int main(int argc, char** argv) {
 #ifdef ENABLE_TASKSCHEDULER_TEST
 	::testing::InitGoogleTest(&argc, argv);
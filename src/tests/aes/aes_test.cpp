@@ -0,0 +1,831 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../../aes/header/aes.h"
+
+class AesTest : public ::testing::Test {
+protected:
+	std::vector<uint8_t> key;
+	std::vector<uint8_t> iv;
+	std::vector<uint8_t> plainText;
+
+	void SetUp() override {
+		// NIST SP 800-38A, F.1 - F.5 (AES-128)
+		key = fromHex("2b7e151628aed2a6abf7158809cf4f3c");
+		iv = fromHex("000102030405060708090a0b0c0d0e0f");
+		plainText = fromHex(
+			"6bc1bee22e409f96e93d7e117393172a"
+			"ae2d8a571e03ac9c9eb76fac45af8e51"
+			"30c81c46a35ce411e5fbc1191a0a52ef"
+			"f69f2445df4f9b17ad2b417be66c3710");
+	}
+
+	static std::vector<uint8_t> fromHex(const std::string& hex) {
+		std::vector<uint8_t> bytes;
+		for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+			bytes.push_back((uint8_t)std::stoul(hex.substr(i, 2), nullptr, 16));
+		}
+		return bytes;
+	}
+};
+
+
+TEST_F(AesTest, ECB_EncryptDecrypt) {
+	struct AES_ctx ctx;
+	AES_init_ctx(&ctx, key.data());
+	std::vector<uint8_t> buf(plainText.begin(), plainText.begin() + AES_BLOCKLEN);
+
+	AES_ECB_encrypt(&ctx, buf.data());
+	EXPECT_EQ(buf, fromHex("3ad77bb40d7a3660a89ecaf32466ef97"));
+
+	AES_ECB_decrypt(&ctx, buf.data());
+	EXPECT_EQ(buf, std::vector<uint8_t>(plainText.begin(), plainText.begin() + AES_BLOCKLEN));
+}
+
+TEST_F(AesTest, CBC_EncryptDecrypt) {
+	struct AES_ctx ctx;
+	std::vector<uint8_t> buf = plainText;
+
+	AES_init_ctx_iv(&ctx, key.data(), iv.data());
+	AES_CBC_encrypt_buffer(&ctx, buf.data(), buf.size());
+	EXPECT_EQ(buf, fromHex(
+		"7649abac8119b246cee98e9b12e9197d"
+		"5086cb9b507219ee95db113a917678b2"
+		"73bed6b8e3c1743b7116e69e22229516"
+		"3ff1caa1681fac09120eca307586e1a7"));
+
+	AES_ctx_set_iv(&ctx, iv.data());
+	AES_CBC_decrypt_buffer(&ctx, buf.data(), buf.size());
+	EXPECT_EQ(buf, plainText);
+}
+
+TEST_F(AesTest, CTR_Xcrypt) {
+	struct AES_ctx ctx;
+	std::vector<uint8_t> counter = fromHex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+	std::vector<uint8_t> buf = plainText;
+
+	AES_init_ctx_iv(&ctx, key.data(), counter.data());
+	AES_CTR_xcrypt_buffer(&ctx, buf.data(), buf.size());
+	EXPECT_EQ(buf, fromHex(
+		"874d6191b620e3261bef6864990db6ce"
+		"9806f66b7970fdff8617187bb9fffdff"
+		"5ae4df3edbd5d35e5b4f09020db03eab"
+		"1e031dda2fbe03d1792170a0f3009cee"));
+
+	AES_ctx_set_iv(&ctx, counter.data());
+	AES_CTR_xcrypt_buffer(&ctx, buf.data(), buf.size());
+	EXPECT_EQ(buf, plainText);
+}
+
+
+TEST_F(AesTest, CBC_StreamMatchesBuffer) {
+	struct AES_ctx ctx;
+	struct AES_CBC_stream_ctx stream;
+	std::vector<uint8_t> expected = plainText;
+	std::vector<uint8_t> out(plainText.size() + 2 * AES_BLOCKLEN);
+	size_t written = 0;
+
+	AES_init_ctx_iv(&ctx, key.data(), iv.data());
+	AES_CBC_encrypt_buffer(&ctx, expected.data(), expected.size());
+
+	AES_CBC_encrypt_init(&stream, key.data(), iv.data());
+	written += AES_CBC_encrypt_update(&stream, plainText.data(), 5, out.data() + written);
+	written += AES_CBC_encrypt_update(&stream, plainText.data() + 5, 30, out.data() + written);
+	written += AES_CBC_encrypt_update(&stream, plainText.data() + 35, plainText.size() - 35, out.data() + written);
+	EXPECT_EQ(written, plainText.size());
+	written += AES_CBC_encrypt_final(&stream, out.data() + written);
+
+	EXPECT_EQ(written, plainText.size() + AES_BLOCKLEN);
+	EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + plainText.size()), expected);
+}
+
+TEST_F(AesTest, CBC_StreamPadsAnyLength) {
+	struct AES_CBC_stream_ctx stream;
+	std::vector<uint8_t> message(plainText.begin(), plainText.begin() + 37);
+	std::vector<uint8_t> cipherText(64), decrypted(64);
+	size_t cipherLen = 0, plainLen = 0, finalLen = 0;
+
+	AES_CBC_encrypt_init(&stream, key.data(), iv.data());
+	cipherLen += AES_CBC_encrypt_update(&stream, message.data(), message.size(), cipherText.data());
+	cipherLen += AES_CBC_encrypt_final(&stream, cipherText.data() + cipherLen);
+	EXPECT_EQ(cipherLen, 48u);
+
+	// Feed the ciphertext back through a fixed 7-byte window
+	AES_CBC_decrypt_init(&stream, key.data(), iv.data());
+	for (size_t offset = 0; offset < cipherLen; offset += 7) {
+		size_t chunk = std::min<size_t>(7, cipherLen - offset);
+		plainLen += AES_CBC_decrypt_update(&stream, cipherText.data() + offset, chunk, decrypted.data() + plainLen);
+	}
+	EXPECT_EQ(AES_CBC_decrypt_final(&stream, decrypted.data() + plainLen, &finalLen), 1);
+	plainLen += finalLen;
+
+	EXPECT_EQ(std::vector<uint8_t>(decrypted.begin(), decrypted.begin() + plainLen), message);
+}
+
+TEST_F(AesTest, CBC_StreamRejectsBadPadding) {
+	struct AES_CBC_stream_ctx stream;
+	std::vector<uint8_t> cipherText(AES_BLOCKLEN), decrypted(2 * AES_BLOCKLEN);
+	size_t finalLen = 99;
+
+	// A block whose plaintext ends in 0x00 is never valid PKCS#7
+	struct AES_ctx ctx;
+	std::vector<uint8_t> block(AES_BLOCKLEN, 0);
+	AES_init_ctx_iv(&ctx, key.data(), iv.data());
+	AES_CBC_encrypt_buffer(&ctx, block.data(), block.size());
+
+	AES_CBC_decrypt_init(&stream, key.data(), iv.data());
+	EXPECT_EQ(AES_CBC_decrypt_update(&stream, block.data(), block.size(), decrypted.data()), 0u);
+	EXPECT_EQ(AES_CBC_decrypt_final(&stream, decrypted.data(), &finalLen), 0);
+	EXPECT_EQ(finalLen, 0u);
+
+	// Truncated ciphertext is rejected as well
+	AES_CBC_decrypt_init(&stream, key.data(), iv.data());
+	AES_CBC_decrypt_update(&stream, cipherText.data(), 9, decrypted.data());
+	EXPECT_EQ(AES_CBC_decrypt_final(&stream, decrypted.data(), &finalLen), 0);
+}
+
+TEST_F(AesTest, KeySizes_Fips197Vectors) {
+	// FIPS-197 Appendix C.1 - C.3
+	const std::vector<uint8_t> fipsKey = fromHex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+	const std::vector<uint8_t> fipsPlain = fromHex("00112233445566778899aabbccddeeff");
+	const size_t keyLens[] = { 16, 24, 32 };
+	const char* expected[] = {
+		"69c4e0d86a7b0430d8cdb78070b4c55a",
+		"dda97ca4864cdfe06eaf70a0ec0d7191",
+		"8ea2b7ca516745bfeafc49904b496089" };
+
+	for (int i = 0; i < 3; ++i) {
+		struct AES_ctx ctx;
+		std::vector<uint8_t> buf = fipsPlain;
+		ASSERT_EQ(AES_init_ctx_keylen(&ctx, fipsKey.data(), keyLens[i]), 1);
+		EXPECT_EQ(ctx.Nr, keyLens[i] / 4 + 6);
+
+		AES_ECB_encrypt(&ctx, buf.data());
+		EXPECT_EQ(buf, fromHex(expected[i]));
+
+		AES_ECB_decrypt(&ctx, buf.data());
+		EXPECT_EQ(buf, fipsPlain);
+	}
+}
+
+TEST_F(AesTest, KeySizes_MixedContexts) {
+	// NIST SP 800-38A, F.2.3 and F.2.5: CBC-AES192 and CBC-AES256 next to the AES-128 context
+	struct AES_ctx ctx128, ctx192, ctx256;
+	std::vector<uint8_t> buf128(plainText.begin(), plainText.begin() + AES_BLOCKLEN);
+	std::vector<uint8_t> buf192 = buf128, buf256 = buf128;
+
+	AES_init_ctx_iv(&ctx128, key.data(), iv.data());
+	ASSERT_EQ(AES_init_ctx_iv_keylen(&ctx192, fromHex("8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b").data(), 24, iv.data()), 1);
+	ASSERT_EQ(AES_init_ctx_iv_keylen(&ctx256, fromHex("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4").data(), 32, iv.data()), 1);
+
+	AES_CBC_encrypt_buffer(&ctx256, buf256.data(), buf256.size());
+	AES_CBC_encrypt_buffer(&ctx128, buf128.data(), buf128.size());
+	AES_CBC_encrypt_buffer(&ctx192, buf192.data(), buf192.size());
+
+	EXPECT_EQ(buf128, fromHex("7649abac8119b246cee98e9b12e9197d"));
+	EXPECT_EQ(buf192, fromHex("4f021db243bc633d7178183a9fa071e8"));
+	EXPECT_EQ(buf256, fromHex("f58c4c04d6e5f1ba779eabfb5f7bfbd6"));
+}
+
+TEST_F(AesTest, KeySizes_RejectInvalidLength) {
+	struct AES_ctx ctx;
+	EXPECT_EQ(AES_init_ctx_keylen(&ctx, key.data(), 0), 0);
+	EXPECT_EQ(AES_init_ctx_keylen(&ctx, key.data(), 20), 0);
+	EXPECT_EQ(AES_init_ctx_iv_keylen(&ctx, key.data(), 64, iv.data()), 0);
+}
+
+
+TEST_F(AesTest, KeyHandle_Fips197Vectors) {
+	const std::vector<uint8_t> fipsKey = fromHex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+	const std::vector<uint8_t> fipsPlain = fromHex("00112233445566778899aabbccddeeff");
+	const size_t keyLens[] = { 16, 24, 32 };
+	const char* expected[] = {
+		"69c4e0d86a7b0430d8cdb78070b4c55a",
+		"dda97ca4864cdfe06eaf70a0ec0d7191",
+		"8ea2b7ca516745bfeafc49904b496089" };
+
+	for (int i = 0; i < 3; ++i) {
+		struct AES_key handle;
+		std::vector<uint8_t> buf = fipsPlain;
+		ASSERT_EQ(AES_key_init(&handle, fipsKey.data(), keyLens[i]), 1);
+
+		AES_ECB_encrypt_key(&handle, buf.data());
+		EXPECT_EQ(buf, fromHex(expected[i]));
+
+		// Decryption runs the equivalent inverse cipher on the precomputed schedule
+		AES_ECB_decrypt_key(&handle, buf.data());
+		EXPECT_EQ(buf, fipsPlain);
+	}
+
+	struct AES_key handle;
+	EXPECT_EQ(AES_key_init(&handle, fipsKey.data(), 17), 0);
+}
+
+TEST_F(AesTest, KeyHandle_MatchesContext) {
+	struct AES_key handle;
+	struct AES_ctx ctx;
+	std::vector<uint8_t> viaCtx = plainText, viaKey = plainText;
+	std::vector<uint8_t> keyIv = iv;
+
+	ASSERT_EQ(AES_key_init(&handle, key.data(), key.size()), 1);
+
+	// CBC, split over two calls to check the IV is chained through the caller's buffer
+	AES_init_ctx_iv(&ctx, key.data(), iv.data());
+	AES_CBC_encrypt_buffer(&ctx, viaCtx.data(), viaCtx.size());
+	AES_CBC_encrypt_buffer_key(&handle, keyIv.data(), viaKey.data(), 32);
+	AES_CBC_encrypt_buffer_key(&handle, keyIv.data(), viaKey.data() + 32, viaKey.size() - 32);
+	EXPECT_EQ(viaKey, viaCtx);
+
+	keyIv = iv;
+	AES_CBC_decrypt_buffer_key(&handle, keyIv.data(), viaKey.data(), 16);
+	AES_CBC_decrypt_buffer_key(&handle, keyIv.data(), viaKey.data() + 16, viaKey.size() - 16);
+	EXPECT_EQ(viaKey, plainText);
+
+	// CTR
+	viaCtx = plainText;
+	keyIv = iv;
+	AES_ctx_set_iv(&ctx, iv.data());
+	AES_CTR_xcrypt_buffer(&ctx, viaCtx.data(), viaCtx.size());
+	AES_CTR_xcrypt_buffer_key(&handle, keyIv.data(), viaKey.data(), viaKey.size());
+	EXPECT_EQ(viaKey, viaCtx);
+
+	// A context loaded from the handle behaves like one initialised from the raw key
+	struct AES_ctx loaded;
+	viaKey = plainText;
+	AES_ctx_set_key(&loaded, &handle);
+	AES_ctx_set_iv(&loaded, iv.data());
+	AES_CTR_xcrypt_buffer(&loaded, viaKey.data(), viaKey.size());
+	EXPECT_EQ(viaKey, viaCtx);
+}
+
+TEST_F(AesTest, KeyCache_HitsAndEvicts) {
+	struct AES_key_cache cache;
+	AES_key_cache_init(&cache);
+
+	const struct AES_key* first = AES_key_cache_get(&cache, key.data(), key.size());
+	ASSERT_NE(first, nullptr);
+	EXPECT_EQ(AES_key_cache_get(&cache, key.data(), key.size()), first);
+	EXPECT_EQ(cache.Hits, 1u);
+	EXPECT_EQ(cache.Misses, 1u);
+
+	// The same bytes as a 24-byte key are a different key
+	std::vector<uint8_t> longKey = key;
+	longKey.resize(24, 0);
+	EXPECT_NE(AES_key_cache_get(&cache, longKey.data(), longKey.size()), first);
+	EXPECT_EQ(AES_key_cache_get(&cache, key.data(), 20), nullptr);
+
+	// Fill the cache with other keys; the original key is least recently used and gets evicted
+	for (int i = 0; i < AES_KEY_CACHE_SIZE; ++i) {
+		std::vector<uint8_t> other(16, (uint8_t)(i + 1));
+		const struct AES_key* handle = AES_key_cache_get(&cache, other.data(), other.size());
+		ASSERT_NE(handle, nullptr);
+		std::vector<uint8_t> viaCache = plainText, direct = plainText;
+		struct AES_key expected;
+		AES_key_init(&expected, other.data(), other.size());
+		AES_ECB_encrypt_key(handle, viaCache.data());
+		AES_ECB_encrypt_key(&expected, direct.data());
+		EXPECT_EQ(viaCache, direct);
+	}
+	uint32_t misses = cache.Misses;
+	const struct AES_key* again = AES_key_cache_get(&cache, key.data(), key.size());
+	EXPECT_EQ(cache.Misses, misses + 1);
+
+	std::vector<uint8_t> buf(plainText.begin(), plainText.begin() + AES_BLOCKLEN);
+	AES_ECB_encrypt_key(again, buf.data());
+	EXPECT_EQ(buf, fromHex("3ad77bb40d7a3660a89ecaf32466ef97"));
+
+	AES_key_cache_clear(&cache);
+	EXPECT_EQ(cache.Hits, 0u);
+	EXPECT_EQ(cache.KeyLen[0], 0);
+}
+
+
+TEST_F(AesTest, XTS_Ieee1619Vectors) {
+	struct AES_XTS_ctx ctx;
+
+	// IEEE 1619-2007, XTS-AES-128 vector 2
+	std::vector<uint8_t> xtsKey = fromHex("1111111111111111111111111111111122222222222222222222222222222222");
+	std::vector<uint8_t> buf(32, 0x44);
+	ASSERT_EQ(AES_XTS_init_ctx(&ctx, xtsKey.data(), xtsKey.size()), 1);
+	ASSERT_EQ(AES_XTS_encrypt_record(&ctx, 0x3333333333ULL, buf.data(), buf.size()), 1);
+	EXPECT_EQ(buf, fromHex("c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0"));
+	ASSERT_EQ(AES_XTS_decrypt_record(&ctx, 0x3333333333ULL, buf.data(), buf.size()), 1);
+	EXPECT_EQ(buf, std::vector<uint8_t>(32, 0x44));
+
+	// IEEE 1619-2007, vector 15: 17 byte data unit, ciphertext stealing
+	xtsKey = fromHex("fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0");
+	const std::vector<uint8_t> plain = fromHex("000102030405060708090a0b0c0d0e0f10");
+	buf = plain;
+	ASSERT_EQ(AES_XTS_init_ctx(&ctx, xtsKey.data(), xtsKey.size()), 1);
+	ASSERT_EQ(AES_XTS_encrypt_record(&ctx, 0x123456789aULL, buf.data(), buf.size()), 1);
+	EXPECT_EQ(buf, fromHex("6c1625db4671522d3d7599601de7ca09ed"));
+	ASSERT_EQ(AES_XTS_decrypt_record(&ctx, 0x123456789aULL, buf.data(), buf.size()), 1);
+	EXPECT_EQ(buf, plain);
+}
+
+TEST_F(AesTest, XTS_OpenSslVectors) {
+	// Produced with OpenSSL EVP_aes_128_xts/EVP_aes_256_xts, the record index as a little-endian 16 byte tweak
+	struct AES_XTS_ctx ctx;
+	std::vector<uint8_t> xtsKey(64);
+	std::vector<uint8_t> plain(71);
+	for (size_t i = 0; i < xtsKey.size(); ++i) {
+		xtsKey[i] = (uint8_t)(i * 7 + 3);
+	}
+	for (size_t i = 0; i < plain.size(); ++i) {
+		plain[i] = (uint8_t)(i * 13 + 1);
+	}
+
+	// XTS-AES-128, 71 byte record: four whole blocks and a stolen partial one
+	std::vector<uint8_t> buf = plain;
+	ASSERT_EQ(AES_XTS_init_ctx(&ctx, xtsKey.data(), 32), 1);
+	ASSERT_EQ(AES_XTS_encrypt_record(&ctx, 0x0102030405ULL, buf.data(), buf.size()), 1);
+	EXPECT_EQ(buf, fromHex(
+		"66cd67675e5ad0135649ca86b0c02f65c1a00b6a2c6a2df3f06141c831869847"
+		"9a3917eb2b816120c7b66eb7f1d4a2caf26ae3408a88422f8a2331e77c55b066"
+		"1488789c58757a"));
+	ASSERT_EQ(AES_XTS_decrypt_record(&ctx, 0x0102030405ULL, buf.data(), buf.size()), 1);
+	EXPECT_EQ(buf, plain);
+
+	// XTS-AES-256, 37 byte record
+	buf.assign(plain.begin(), plain.begin() + 37);
+	ASSERT_EQ(AES_XTS_init_ctx(&ctx, xtsKey.data(), 64), 1);
+	ASSERT_EQ(AES_XTS_encrypt_record(&ctx, 5, buf.data(), buf.size()), 1);
+	EXPECT_EQ(buf, fromHex("c9fb11eb88f42ec0585ff7259d5a7a0c8f555a7589f1278beb0e6e8be247a2ea1860438776"));
+	ASSERT_EQ(AES_XTS_decrypt_record(&ctx, 5, buf.data(), buf.size()), 1);
+	EXPECT_EQ(buf, std::vector<uint8_t>(plain.begin(), plain.begin() + 37));
+}
+
+TEST_F(AesTest, XTS_RandomAccessRecords) {
+	struct AES_XTS_ctx ctx;
+	std::vector<uint8_t> xtsKey(64);
+	for (size_t i = 0; i < xtsKey.size(); ++i) {
+		xtsKey[i] = (uint8_t)(i * 7 + 3);
+	}
+	ASSERT_EQ(AES_XTS_init_ctx(&ctx, xtsKey.data(), xtsKey.size()), 1);
+
+	// Records with an odd size spanning more than one batch of blocks, written in order and read back out of order
+	const size_t recordSize = 1100;
+	const int records = 5;
+	std::vector<uint8_t> file(recordSize * records);
+	for (size_t i = 0; i < file.size(); ++i) {
+		file[i] = (uint8_t)(i % 251);
+	}
+	const std::vector<uint8_t> original = file;
+
+	for (int r = 0; r < records; ++r) {
+		ASSERT_EQ(AES_XTS_encrypt_record(&ctx, r, file.data() + r * recordSize, recordSize), 1);
+	}
+	// The same plaintext at another index encrypts differently
+	EXPECT_NE(std::vector<uint8_t>(file.begin(), file.begin() + 16), std::vector<uint8_t>(original.begin(), original.begin() + 16));
+
+	const int order[] = { 3, 0, 4, 1, 2 };
+	for (int r : order) {
+		ASSERT_EQ(AES_XTS_decrypt_record(&ctx, r, file.data() + r * recordSize, recordSize), 1);
+	}
+	EXPECT_EQ(file, original);
+}
+
+TEST_F(AesTest, XTS_RejectsBadInput) {
+	struct AES_XTS_ctx ctx;
+	std::vector<uint8_t> sameHalves(32, 0x5a);
+	std::vector<uint8_t> xtsKey = fromHex("1111111111111111111111111111111122222222222222222222222222222222");
+	std::vector<uint8_t> buf(15, 0x01);
+
+	EXPECT_EQ(AES_XTS_init_ctx(&ctx, sameHalves.data(), sameHalves.size()), 0);
+	EXPECT_EQ(AES_XTS_init_ctx(&ctx, xtsKey.data(), 16), 0);
+	ASSERT_EQ(AES_XTS_init_ctx(&ctx, xtsKey.data(), xtsKey.size()), 1);
+	EXPECT_EQ(AES_XTS_encrypt_record(&ctx, 0, buf.data(), buf.size()), 0);
+	EXPECT_EQ(buf, std::vector<uint8_t>(15, 0x01));
+}
+
+
+TEST_F(AesTest, MultiBuffer_MatchesSingleBuffer) {
+	// Jobs with all three key sizes, a shared key, an empty job and a counter about to wrap
+	const size_t keyLens[] = { 16, 24, 32, 16, 16, 32, 24, 16, 32, 16, 24 };
+	const size_t lengths[] = { 64, 16, 160, 0, 48, 32, 1024, 16, 80, 512, 96 };
+	const int jobCount = 11;
+	const int backends[] = { AES_BACKEND_PORTABLE, AES_BACKEND_AESNI };
+	const int detected = AES_jobs_backend();
+
+	std::vector<AES_key> keys(jobCount);
+	for (int i = 0; i < jobCount; ++i) {
+		std::vector<uint8_t> raw(keyLens[i]);
+		for (size_t j = 0; j < raw.size(); ++j) {
+			raw[j] = (uint8_t)(i * 17 + j);
+		}
+		ASSERT_EQ(AES_key_init(&keys[i], raw.data(), raw.size()), 1);
+	}
+
+	for (int backend : backends) {
+		if (!AES_jobs_set_backend(backend)) {
+			continue;
+		}
+		for (int mode = 0; mode < 3; ++mode) {
+			std::vector<std::vector<uint8_t>> bufs(jobCount), ivs(jobCount), expected(jobCount), expectedIvs(jobCount);
+			std::vector<AES_job> jobs(jobCount);
+
+			for (int i = 0; i < jobCount; ++i) {
+				// CTR jobs get odd lengths to cover the partial last block
+				size_t length = (mode == 2 && lengths[i] > 0) ? lengths[i] - 3 : lengths[i];
+				bufs[i].resize(length);
+				for (size_t j = 0; j < length; ++j) {
+					bufs[i][j] = (uint8_t)(j * 3 + i);
+				}
+				ivs[i] = iv;
+				ivs[i][0] = (uint8_t)i;
+				if (i == 6) {
+					std::fill(ivs[i].begin() + 8, ivs[i].end(), 0xff);
+				}
+				expected[i] = bufs[i];
+				expectedIvs[i] = ivs[i];
+				AES_key* key = &keys[i == 4 ? 0 : i];
+				jobs[i].Key = key;
+				jobs[i].Iv = ivs[i].data();
+				jobs[i].Buf = bufs[i].data();
+				jobs[i].Length = bufs[i].size();
+
+				if (mode == 0) {
+					AES_CBC_encrypt_buffer_key(key, expectedIvs[i].data(), expected[i].data(), expected[i].size());
+				}
+				else if (mode == 1) {
+					AES_CBC_decrypt_buffer_key(key, expectedIvs[i].data(), expected[i].data(), expected[i].size());
+				}
+				else {
+					AES_CTR_xcrypt_buffer_key(key, expectedIvs[i].data(), expected[i].data(), expected[i].size());
+				}
+			}
+
+			if (mode == 0) {
+				AES_CBC_encrypt_jobs(jobs.data(), jobs.size());
+			}
+			else if (mode == 1) {
+				AES_CBC_decrypt_jobs(jobs.data(), jobs.size());
+			}
+			else {
+				AES_CTR_xcrypt_jobs(jobs.data(), jobs.size());
+			}
+
+			for (int i = 0; i < jobCount; ++i) {
+				EXPECT_EQ(bufs[i], expected[i]) << "backend " << backend << " mode " << mode << " job " << i;
+				EXPECT_EQ(ivs[i], expectedIvs[i]) << "backend " << backend << " mode " << mode << " job " << i;
+			}
+		}
+	}
+	AES_jobs_set_backend(detected);
+}
+
+TEST_F(AesTest, MultiBuffer_UnavailableBackendRejected) {
+	const int detected = AES_jobs_backend();
+	EXPECT_EQ(AES_jobs_set_backend(42), 0);
+	EXPECT_EQ(AES_jobs_backend(), detected);
+	EXPECT_EQ(AES_jobs_set_backend(AES_BACKEND_PORTABLE), 1);
+	EXPECT_EQ(AES_jobs_backend(), AES_BACKEND_PORTABLE);
+	AES_jobs_set_backend(detected);
+}
+
+
+TEST_F(AesTest, CMAC_Rfc4493Vectors) {
+	struct AES_CMAC_key cmacKey;
+	ASSERT_EQ(AES_CMAC_key_init(&cmacKey, key.data(), key.size()), 1);
+
+	// RFC 4493, 4: messages of 0, 16, 40 and 64 bytes of the SP 800-38A plaintext
+	const size_t lengths[] = { 0, 16, 40, 64 };
+	const char* tags[] = {
+		"bb1d6929e95937287fa37d129b756746",
+		"070a16b46b4d4144f79bdd9dd04a287c",
+		"dfa66747de9ae63030ca32611497c827",
+		"51f0bebf7e3b9d92fc49741779363cfe" };
+
+	for (int i = 0; i < 4; ++i) {
+		std::vector<uint8_t> tag(AES_CMAC_TAGLEN);
+		AES_CMAC_buffer(&cmacKey, plainText.data(), lengths[i], tag.data());
+		EXPECT_EQ(tag, fromHex(tags[i])) << "length " << lengths[i];
+		EXPECT_EQ(AES_CMAC_verify_buffer(&cmacKey, plainText.data(), lengths[i], tag.data()), 1);
+
+		tag[0] ^= 0x80;
+		EXPECT_EQ(AES_CMAC_verify_buffer(&cmacKey, plainText.data(), lengths[i], tag.data()), 0);
+	}
+}
+
+TEST_F(AesTest, CMAC_StreamingMatchesOneShot) {
+	// SP 800-38B, D.3: AES-256, 64-byte message
+	struct AES_CMAC_key cmacKey;
+	std::vector<uint8_t> key256 = fromHex("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4");
+	ASSERT_EQ(AES_CMAC_key_init(&cmacKey, key256.data(), key256.size()), 1);
+	const std::vector<uint8_t> expected = fromHex("e1992190549f6ed5696a2c056c315410");
+
+	// Every split point, including ones that end exactly on a block boundary
+	for (size_t split = 0; split <= plainText.size(); ++split) {
+		struct AES_CMAC_ctx ctx;
+		std::vector<uint8_t> tag(AES_CMAC_TAGLEN);
+		AES_CMAC_start(&ctx, &cmacKey);
+		AES_CMAC_update(&ctx, plainText.data(), split);
+		AES_CMAC_update(&ctx, plainText.data() + split, plainText.size() - split);
+		AES_CMAC_finish(&ctx, tag.data());
+		EXPECT_EQ(tag, expected) << "split " << split;
+
+		AES_CMAC_start(&ctx, &cmacKey);
+		AES_CMAC_update(&ctx, plainText.data(), split);
+		AES_CMAC_update(&ctx, plainText.data() + split, plainText.size() - split);
+		EXPECT_EQ(AES_CMAC_check_tag(&ctx, expected.data()), 1);
+	}
+
+	EXPECT_EQ(AES_CMAC_key_init(&cmacKey, key256.data(), 20), 0);
+}
+
+
+TEST_F(AesTest, SIV_Rfc5297Vector) {
+	// RFC 5297, A.1: deterministic authenticated encryption
+	struct AES_SIV_ctx ctx;
+	std::vector<uint8_t> sivKey = fromHex("fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+	std::vector<uint8_t> aad = fromHex("101112131415161718191a1b1c1d1e1f2021222324252627");
+	std::vector<uint8_t> plain = fromHex("112233445566778899aabbccddee");
+	std::vector<uint8_t> expected = fromHex("85632d07c6e8f37f950acd320a2ecc9340c02b9690c4dc04daef7f6afe5c");
+	ASSERT_EQ(AES_SIV_init_ctx(&ctx, sivKey.data(), sivKey.size()), 1);
+
+	std::vector<uint8_t> cipher(plain.size() + AES_SIV_IVLEN);
+	AES_SIV_encrypt(&ctx, aad.data(), aad.size(), plain.data(), plain.size(), cipher.data());
+	EXPECT_EQ(cipher, expected);
+
+	std::vector<uint8_t> decrypted(plain.size());
+	EXPECT_EQ(AES_SIV_decrypt(&ctx, aad.data(), aad.size(), cipher.data(), cipher.size(), decrypted.data()), 1);
+	EXPECT_EQ(decrypted, plain);
+
+	cipher[AES_SIV_IVLEN] ^= 0x01;
+	EXPECT_EQ(AES_SIV_decrypt(&ctx, aad.data(), aad.size(), cipher.data(), cipher.size(), decrypted.data()), 0);
+	EXPECT_EQ(decrypted, std::vector<uint8_t>(plain.size(), 0));
+}
+
+TEST_F(AesTest, SIV_DeterministicInPlace) {
+	struct AES_SIV_ctx ctx;
+	std::vector<uint8_t> sivKey(64);
+	for (size_t i = 0; i < sivKey.size(); ++i) {
+		sivKey[i] = (uint8_t)i;
+	}
+	ASSERT_EQ(AES_SIV_init_ctx(&ctx, sivKey.data(), sivKey.size()), 1);
+	EXPECT_EQ(AES_SIV_init_ctx(&ctx, sivKey.data(), 40), 0);
+
+	// Lengths below, at and above one block take the two S2V branches
+	for (size_t length : { (size_t)0, (size_t)5, (size_t)16, (size_t)64 }) {
+		std::vector<uint8_t> once(length + AES_SIV_IVLEN), twice(length + AES_SIV_IVLEN);
+		AES_SIV_encrypt(&ctx, nullptr, 0, plainText.data(), length, once.data());
+
+		// The plaintext already sits where the ciphertext goes
+		std::copy(plainText.begin(), plainText.begin() + length, twice.begin() + AES_SIV_IVLEN);
+		AES_SIV_encrypt(&ctx, nullptr, 0, twice.data() + AES_SIV_IVLEN, length, twice.data());
+		EXPECT_EQ(once, twice) << "length " << length;
+
+		EXPECT_EQ(AES_SIV_decrypt(&ctx, nullptr, 0, twice.data(), twice.size(), twice.data() + AES_SIV_IVLEN), 1);
+		EXPECT_TRUE(std::equal(plainText.begin(), plainText.begin() + length, twice.begin() + AES_SIV_IVLEN));
+	}
+
+	uint8_t shortInput[AES_SIV_IVLEN - 1] = { 0 };
+	EXPECT_EQ(AES_SIV_decrypt(&ctx, nullptr, 0, shortInput, sizeof(shortInput), shortInput), 0);
+}
+
+
+TEST_F(AesTest, CTR_BackendsAgree) {
+	const int detected = AES_jobs_backend();
+	struct AES_key handle;
+	ASSERT_EQ(AES_key_init(&handle, key.data(), key.size()), 1);
+
+	std::vector<uint8_t> data(1000);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = (uint8_t)(i * 7);
+	}
+
+	// Lengths around the 8-block batches, with a counter that carries into the upper bytes
+	for (size_t length : { (size_t)127, (size_t)128, (size_t)129, (size_t)300, (size_t)1000 }) {
+		std::vector<uint8_t> portable(data.begin(), data.begin() + length), fast = portable;
+		std::vector<uint8_t> portableIv = iv, fastIv = iv;
+		std::fill(portableIv.begin() + 10, portableIv.end(), 0xff);
+		fastIv = portableIv;
+
+		ASSERT_EQ(AES_jobs_set_backend(AES_BACKEND_PORTABLE), 1);
+		AES_CTR_xcrypt_buffer_key(&handle, portableIv.data(), portable.data(), portable.size());
+		if (AES_jobs_set_backend(AES_BACKEND_AESNI)) {
+			AES_CTR_xcrypt_buffer_key(&handle, fastIv.data(), fast.data(), fast.size());
+			EXPECT_EQ(fast, portable) << "length " << length;
+			EXPECT_EQ(fastIv, portableIv) << "length " << length;
+		}
+	}
+	AES_jobs_set_backend(detected);
+}
+
+TEST_F(AesTest, DRBG_KnownAnswer) {
+	// CTR_DRBG, AES-256 without derivation function; the expected output was cross-checked
+	// against an independent implementation
+	std::vector<uint8_t> entropy(AES_DRBG_SEEDLEN), reseedEntropy(AES_DRBG_SEEDLEN);
+	std::vector<uint8_t> personalization(AES_DRBG_SEEDLEN), additional(AES_DRBG_SEEDLEN);
+	for (size_t i = 0; i < AES_DRBG_SEEDLEN; ++i) {
+		entropy[i] = (uint8_t)i;
+		reseedEntropy[i] = (uint8_t)(0x80 + i);
+		personalization[i] = (uint8_t)(0x40 + i);
+		additional[i] = (uint8_t)(0xa0 + i);
+	}
+
+	struct AES_DRBG_ctx ctx;
+	std::vector<uint8_t> out(64);
+	ASSERT_EQ(AES_DRBG_init(&ctx, entropy.data(), personalization.data(), personalization.size()), 1);
+	ASSERT_EQ(AES_DRBG_generate(&ctx, out.data(), out.size(), additional.data(), additional.size()), 1);
+	EXPECT_EQ(out, fromHex(
+		"1fba4640112dba6f34cc453ec086a523d818da4de5d926486beceecfc97485d3"
+		"efad38f519e309805ac37a615674fcfe45413f0fe548f78cdc9f9f07b7722c6a"));
+
+	ASSERT_EQ(AES_DRBG_reseed(&ctx, reseedEntropy.data(), additional.data(), 16), 1);
+	ASSERT_EQ(AES_DRBG_generate(&ctx, out.data(), out.size(), nullptr, 0), 1);
+	EXPECT_EQ(out, fromHex(
+		"ebd809f6611023727b0f8903b113e90b41a19b0617d07c6f3a81766a7c6f54fe"
+		"aa0d0c47ed02947b8ac84afbd1496db3fa42f1323cf295927ee375172abd7ec8"));
+
+	std::vector<uint8_t> tooLong(AES_DRBG_SEEDLEN + 1);
+	EXPECT_EQ(AES_DRBG_generate(&ctx, out.data(), out.size(), tooLong.data(), tooLong.size()), 0);
+	EXPECT_EQ(AES_DRBG_init(&ctx, entropy.data(), tooLong.data(), tooLong.size()), 0);
+}
+
+TEST_F(AesTest, DRBG_LargeRequestsSplit) {
+	std::vector<uint8_t> entropy(AES_DRBG_SEEDLEN, 0x11);
+	struct AES_DRBG_ctx whole, split;
+	ASSERT_EQ(AES_DRBG_init(&whole, entropy.data(), nullptr, 0), 1);
+	ASSERT_EQ(AES_DRBG_init(&split, entropy.data(), nullptr, 0), 1);
+
+	// One oversized request is served as requests of AES_DRBG_MAX_REQUEST bytes
+	const size_t length = 2 * AES_DRBG_MAX_REQUEST + 100;
+	std::vector<uint8_t> once(length), parts(length);
+	ASSERT_EQ(AES_DRBG_generate(&whole, once.data(), length, nullptr, 0), 1);
+	ASSERT_EQ(AES_DRBG_generate(&split, parts.data(), AES_DRBG_MAX_REQUEST, nullptr, 0), 1);
+	ASSERT_EQ(AES_DRBG_generate(&split, parts.data() + AES_DRBG_MAX_REQUEST, AES_DRBG_MAX_REQUEST, nullptr, 0), 1);
+	ASSERT_EQ(AES_DRBG_generate(&split, parts.data() + 2 * AES_DRBG_MAX_REQUEST, 100, nullptr, 0), 1);
+	EXPECT_EQ(once, parts);
+	EXPECT_EQ(whole.ReseedCounter, 4u);
+
+	// Consecutive requests never repeat output
+	std::vector<uint8_t> next(64);
+	ASSERT_EQ(AES_DRBG_generate(&whole, next.data(), next.size(), nullptr, 0), 1);
+	EXPECT_FALSE(std::equal(next.begin(), next.end(), once.end() - 64));
+
+	AES_DRBG_clear(&whole);
+	EXPECT_EQ(whole.ReseedCounter, 0u);
+}
+
+
+// GCM test cases from "The Galois/Counter Mode of Operation (GCM)", McGrew & Viega
+class AesGcmTest : public AesTest {
+protected:
+	std::vector<uint8_t> gcmKey;
+	std::vector<uint8_t> gcmPlain;
+	std::vector<uint8_t> gcmAad;
+
+	void SetUp() override {
+		AesTest::SetUp();
+		gcmKey = fromHex("feffe9928665731c6d6a8f9467308308");
+		gcmPlain = fromHex(
+			"d9313225f88406e5a55909c5aff5269a"
+			"86a7a9531534f7da2e4c303d8a318a72"
+			"1c3c0c95956809532fcf0e2449a6b525"
+			"b16aedf5aa0de657ba637b39");
+		gcmAad = fromHex("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+	}
+};
+
+TEST_F(AesGcmTest, GCM_EmptyPlainText) {
+	struct AES_GCM_ctx ctx;
+	std::vector<uint8_t> zeroKey(16, 0), zeroIv(AES_GCM_IVLEN, 0);
+	uint8_t tag[AES_GCM_TAGLEN];
+
+	AES_GCM_init_ctx(&ctx, zeroKey.data());
+	AES_GCM_encrypt_buffer(&ctx, zeroIv.data(), zeroIv.size(), nullptr, 0, nullptr, 0, tag);
+	EXPECT_EQ(std::vector<uint8_t>(tag, tag + AES_GCM_TAGLEN), fromHex("58e2fccefa7e3061367f1d57a4e7455a"));
+}
+
+TEST_F(AesGcmTest, GCM_SingleZeroBlock) {
+	struct AES_GCM_ctx ctx;
+	std::vector<uint8_t> zeroKey(16, 0), zeroIv(AES_GCM_IVLEN, 0), buf(16, 0);
+	uint8_t tag[AES_GCM_TAGLEN];
+
+	AES_GCM_init_ctx(&ctx, zeroKey.data());
+	AES_GCM_encrypt_buffer(&ctx, zeroIv.data(), zeroIv.size(), nullptr, 0, buf.data(), buf.size(), tag);
+	EXPECT_EQ(buf, fromHex("0388dace60b6a392f328c2b971b2fe78"));
+	EXPECT_EQ(std::vector<uint8_t>(tag, tag + AES_GCM_TAGLEN), fromHex("ab6e47d42cec13bdf53a67b21257bddf"));
+}
+
+TEST_F(AesGcmTest, GCM_WithAad) {
+	struct AES_GCM_ctx ctx;
+	std::vector<uint8_t> gcmIv = fromHex("cafebabefacedbaddecaf888");
+	std::vector<uint8_t> buf = gcmPlain;
+	uint8_t tag[AES_GCM_TAGLEN];
+
+	AES_GCM_init_ctx(&ctx, gcmKey.data());
+	AES_GCM_encrypt_buffer(&ctx, gcmIv.data(), gcmIv.size(), gcmAad.data(), gcmAad.size(), buf.data(), buf.size(), tag);
+	EXPECT_EQ(buf, fromHex(
+		"42831ec2217774244b7221b784d0d49c"
+		"e3aa212f2c02a4e035c17e2329aca12e"
+		"21d514b25466931c7d8f6a5aac84aa05"
+		"1ba30b396a0aac973d58e091"));
+	EXPECT_EQ(std::vector<uint8_t>(tag, tag + AES_GCM_TAGLEN), fromHex("5bc94fbc3221a5db94fae95ae7121a47"));
+
+	EXPECT_EQ(AES_GCM_decrypt_buffer(&ctx, gcmIv.data(), gcmIv.size(), gcmAad.data(), gcmAad.size(), buf.data(), buf.size(), tag), 1);
+	EXPECT_EQ(buf, gcmPlain);
+}
+
+TEST_F(AesGcmTest, GCM_LongIv) {
+	struct AES_GCM_ctx ctx;
+	std::vector<uint8_t> gcmIv = fromHex(
+		"9313225df88406e555909c5aff5269aa"
+		"6a7a9538534f7da1e4c303d2a318a728"
+		"c3c0c95156809539fcf0e2429a6b5254"
+		"16aedbf5a0de6a57a637b39b");
+	std::vector<uint8_t> buf = gcmPlain;
+	uint8_t tag[AES_GCM_TAGLEN];
+
+	AES_GCM_init_ctx(&ctx, gcmKey.data());
+	AES_GCM_encrypt_buffer(&ctx, gcmIv.data(), gcmIv.size(), gcmAad.data(), gcmAad.size(), buf.data(), buf.size(), tag);
+	EXPECT_EQ(buf, fromHex(
+		"8ce24998625615b603a033aca13fb894"
+		"be9112a5c3a211a8ba262a3cca7e2ca7"
+		"01e4a9a4fba43c90ccdcb281d48c7c6f"
+		"d62875d2aca417034c34aee5"));
+	EXPECT_EQ(std::vector<uint8_t>(tag, tag + AES_GCM_TAGLEN), fromHex("619cc5aefffe0bfa462af43c1699d050"));
+}
+
+TEST_F(AesGcmTest, GCM_StreamingMatchesOneShot) {
+	struct AES_GCM_ctx ctx;
+	std::vector<uint8_t> gcmIv = fromHex("cafebabefacedbaddecaf888");
+	std::vector<uint8_t> oneShot = gcmPlain, streamed = gcmPlain;
+	uint8_t oneShotTag[AES_GCM_TAGLEN], streamedTag[AES_GCM_TAGLEN];
+
+	AES_GCM_init_ctx(&ctx, gcmKey.data());
+	AES_GCM_encrypt_buffer(&ctx, gcmIv.data(), gcmIv.size(), gcmAad.data(), gcmAad.size(), oneShot.data(), oneShot.size(), oneShotTag);
+
+	AES_GCM_start(&ctx, gcmIv.data(), gcmIv.size());
+	AES_GCM_update_aad(&ctx, gcmAad.data(), 3);
+	AES_GCM_update_aad(&ctx, gcmAad.data() + 3, gcmAad.size() - 3);
+	AES_GCM_encrypt_update(&ctx, streamed.data(), 7);
+	AES_GCM_encrypt_update(&ctx, streamed.data() + 7, 33);
+	AES_GCM_encrypt_update(&ctx, streamed.data() + 40, streamed.size() - 40);
+	AES_GCM_finish(&ctx, streamedTag);
+
+	EXPECT_EQ(streamed, oneShot);
+	EXPECT_EQ(memcmp(streamedTag, oneShotTag, AES_GCM_TAGLEN), 0);
+
+	AES_GCM_start(&ctx, gcmIv.data(), gcmIv.size());
+	AES_GCM_update_aad(&ctx, gcmAad.data(), gcmAad.size());
+	AES_GCM_decrypt_update(&ctx, streamed.data(), 17);
+	AES_GCM_decrypt_update(&ctx, streamed.data() + 17, streamed.size() - 17);
+	EXPECT_EQ(AES_GCM_check_tag(&ctx, oneShotTag), 1);
+	EXPECT_EQ(streamed, gcmPlain);
+}
+
+TEST_F(AesGcmTest, GCM_TamperedRecordRejected) {
+	struct AES_GCM_ctx ctx;
+	std::vector<uint8_t> gcmIv = fromHex("cafebabefacedbaddecaf888");
+	std::vector<uint8_t> buf = gcmPlain;
+	uint8_t tag[AES_GCM_TAGLEN];
+
+	AES_GCM_init_ctx(&ctx, gcmKey.data());
+	AES_GCM_encrypt_buffer(&ctx, gcmIv.data(), gcmIv.size(), gcmAad.data(), gcmAad.size(), buf.data(), buf.size(), tag);
+	buf[5] ^= 0x01;
+
+	EXPECT_EQ(AES_GCM_decrypt_buffer(&ctx, gcmIv.data(), gcmIv.size(), gcmAad.data(), gcmAad.size(), buf.data(), buf.size(), tag), 0);
+	EXPECT_EQ(buf, std::vector<uint8_t>(buf.size(), 0));
+}
+
+TEST_F(AesGcmTest, GCM_TableAndClmulGhashAgree) {
+	struct AES_GCM_ctx ctx;
+	std::vector<uint8_t> gcmIv = fromHex("cafebabefacedbaddecaf888");
+	std::vector<uint8_t> record(1000), tableOut, clmulOut;
+	uint8_t tableTag[AES_GCM_TAGLEN], clmulTag[AES_GCM_TAGLEN];
+
+	for (size_t i = 0; i < record.size(); ++i) {
+		record[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	AES_GCM_init_ctx(&ctx, gcmKey.data());
+	uint8_t detected = ctx.UseClmul;
+
+	ctx.UseClmul = 0;
+	tableOut = record;
+	AES_GCM_encrypt_buffer(&ctx, gcmIv.data(), gcmIv.size(), gcmAad.data(), gcmAad.size(), tableOut.data(), tableOut.size(), tableTag);
+
+	ctx.UseClmul = detected;
+	clmulOut = record;
+	AES_GCM_encrypt_buffer(&ctx, gcmIv.data(), gcmIv.size(), gcmAad.data(), gcmAad.size(), clmulOut.data(), clmulOut.size(), clmulTag);
+
+	EXPECT_EQ(tableOut, clmulOut);
+	EXPECT_EQ(memcmp(tableTag, clmulTag, AES_GCM_TAGLEN), 0);
+}
+
+TEST_F(AesGcmTest, GCM_Aes256) {
+	// McGrew & Viega GCM spec, test case 14 (AES-256, zero key, IV and plaintext block)
+	struct AES_GCM_ctx ctx;
+	std::vector<uint8_t> zeroKey(32, 0), zeroIv(AES_GCM_IVLEN, 0), buf(AES_BLOCKLEN, 0);
+	uint8_t tag[AES_GCM_TAGLEN];
+
+	ASSERT_EQ(AES_GCM_init_ctx_keylen(&ctx, zeroKey.data(), zeroKey.size()), 1);
+	AES_GCM_encrypt_buffer(&ctx, zeroIv.data(), zeroIv.size(), nullptr, 0, buf.data(), buf.size(), tag);
+
+	EXPECT_EQ(buf, fromHex("cea7403d4d606b6e074ec5d3baf39d18"));
+	EXPECT_EQ(std::vector<uint8_t>(tag, tag + AES_GCM_TAGLEN), fromHex("d0d1c8a799996bf0265b98b5d48ab919"));
+}
@@ -0,0 +1,148 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../../chacha/header/chacha.h"
+
+class ChachaTest : public ::testing::Test {
+protected:
+	std::vector<uint8_t> key;
+	std::vector<uint8_t> iv;
+	std::vector<uint8_t> aad;
+	std::vector<uint8_t> plainText;
+	std::vector<uint8_t> cipherText;
+	std::vector<uint8_t> tag;
+
+	void SetUp() override {
+		// RFC 8439, 2.8.2
+		key = fromHex("808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f");
+		iv = fromHex("070000004041424344454647");
+		aad = fromHex("50515253c0c1c2c3c4c5c6c7");
+		const std::string sunscreen = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+		plainText.assign(sunscreen.begin(), sunscreen.end());
+		cipherText = fromHex(
+			"d31a8d34648e60db7b86afbc53ef7ec2"
+			"a4aded51296e08fea9e2b5a736ee62d6"
+			"3dbea45e8ca9671282fafb69da92728b"
+			"1a71de0a9e060b2905d6a5b67ecd3b36"
+			"92ddbd7f2d778b8c9803aee328091b58"
+			"fab324e4fad675945585808b4831d7bc"
+			"3ff4def08e4b7a9de576d26586cec64b"
+			"6116");
+		tag = fromHex("1ae10b594f09e26a7e902ecbd0600691");
+	}
+
+	static std::vector<uint8_t> fromHex(const std::string& hex) {
+		std::vector<uint8_t> bytes;
+		for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+			bytes.push_back((uint8_t)std::stoul(hex.substr(i, 2), nullptr, 16));
+		}
+		return bytes;
+	}
+};
+
+
+TEST_F(ChachaTest, Rfc8439_Encrypt) {
+	struct CHACHA20_POLY1305_ctx ctx;
+	std::vector<uint8_t> buf = plainText;
+	uint8_t computed[CHACHA20_POLY1305_TAGLEN];
+
+	CHACHA20_POLY1305_init_ctx(&ctx, key.data());
+	ASSERT_EQ(CHACHA20_POLY1305_encrypt_buffer(&ctx, iv.data(), iv.size(), aad.data(), aad.size(), buf.data(), buf.size(), computed), 1);
+
+	EXPECT_EQ(buf, cipherText);
+	EXPECT_EQ(std::vector<uint8_t>(computed, computed + CHACHA20_POLY1305_TAGLEN), tag);
+}
+
+TEST_F(ChachaTest, Rfc8439_Decrypt) {
+	struct CHACHA20_POLY1305_ctx ctx;
+	std::vector<uint8_t> buf = cipherText;
+
+	CHACHA20_POLY1305_init_ctx(&ctx, key.data());
+	ASSERT_EQ(CHACHA20_POLY1305_decrypt_buffer(&ctx, iv.data(), iv.size(), aad.data(), aad.size(), buf.data(), buf.size(), tag.data()), 1);
+	EXPECT_EQ(buf, plainText);
+}
+
+TEST_F(ChachaTest, StreamingMatchesOneShot) {
+	struct CHACHA20_POLY1305_ctx ctx;
+	std::vector<uint8_t> record(1500);
+	std::vector<uint8_t> oneShot, streamed;
+	uint8_t oneShotTag[CHACHA20_POLY1305_TAGLEN], streamedTag[CHACHA20_POLY1305_TAGLEN];
+
+	for (size_t i = 0; i < record.size(); ++i) {
+		record[i] = (uint8_t)(i * 13 + 1);
+	}
+	CHACHA20_POLY1305_init_ctx(&ctx, key.data());
+
+	oneShot = record;
+	CHACHA20_POLY1305_encrypt_buffer(&ctx, iv.data(), iv.size(), aad.data(), aad.size(), oneShot.data(), oneShot.size(), oneShotTag);
+
+	// Uneven chunks cross keystream blocks, SIMD batches and Poly1305 blocks
+	const size_t chunks[] = { 1, 15, 17, 63, 64, 65, 511, 513 };
+	streamed = record;
+	ASSERT_EQ(CHACHA20_POLY1305_start(&ctx, iv.data(), iv.size()), 1);
+	CHACHA20_POLY1305_update_aad(&ctx, aad.data(), 5);
+	CHACHA20_POLY1305_update_aad(&ctx, aad.data() + 5, aad.size() - 5);
+	size_t offset = 0;
+	for (size_t i = 0; offset < streamed.size(); ++i) {
+		size_t take = std::min(chunks[i % 8], streamed.size() - offset);
+		CHACHA20_POLY1305_encrypt_update(&ctx, streamed.data() + offset, take);
+		offset += take;
+	}
+	CHACHA20_POLY1305_finish(&ctx, streamedTag);
+
+	EXPECT_EQ(streamed, oneShot);
+	EXPECT_EQ(memcmp(streamedTag, oneShotTag, CHACHA20_POLY1305_TAGLEN), 0);
+}
+
+TEST_F(ChachaTest, SimdPathsAgree) {
+	struct CHACHA20_POLY1305_ctx ctx;
+	std::vector<uint8_t> record(4096 + 100);
+	std::vector<uint8_t> reference;
+	uint8_t referenceTag[CHACHA20_POLY1305_TAGLEN], simdTag[CHACHA20_POLY1305_TAGLEN];
+
+	for (size_t i = 0; i < record.size(); ++i) {
+		record[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	CHACHA20_POLY1305_init_ctx(&ctx, key.data());
+	const uint8_t detected = ctx.Simd;
+
+	ctx.Simd = CHACHA_SIMD_NONE;
+	reference = record;
+	CHACHA20_POLY1305_encrypt_buffer(&ctx, iv.data(), iv.size(), aad.data(), aad.size(), reference.data(), reference.size(), referenceTag);
+
+	for (uint8_t simd = CHACHA_SIMD_SSE2; simd <= detected; ++simd) {
+		std::vector<uint8_t> buf = record;
+		ctx.Simd = simd;
+		CHACHA20_POLY1305_encrypt_buffer(&ctx, iv.data(), iv.size(), aad.data(), aad.size(), buf.data(), buf.size(), simdTag);
+		EXPECT_EQ(buf, reference);
+		EXPECT_EQ(memcmp(simdTag, referenceTag, CHACHA20_POLY1305_TAGLEN), 0);
+	}
+}
+
+TEST_F(ChachaTest, TamperedRecordRejected) {
+	struct CHACHA20_POLY1305_ctx ctx;
+	std::vector<uint8_t> buf = cipherText;
+	buf[10] ^= 0x01;
+
+	CHACHA20_POLY1305_init_ctx(&ctx, key.data());
+	EXPECT_EQ(CHACHA20_POLY1305_decrypt_buffer(&ctx, iv.data(), iv.size(), aad.data(), aad.size(), buf.data(), buf.size(), tag.data()), 0);
+	EXPECT_EQ(buf, std::vector<uint8_t>(buf.size(), 0));
+
+	// Wrong associated data fails as well
+	buf = cipherText;
+	EXPECT_EQ(CHACHA20_POLY1305_decrypt_buffer(&ctx, iv.data(), iv.size(), aad.data(), aad.size() - 1, buf.data(), buf.size(), tag.data()), 0);
+}
+
+TEST_F(ChachaTest, RejectsBadNonceLength) {
+	struct CHACHA20_POLY1305_ctx ctx;
+	std::vector<uint8_t> buf = plainText;
+	uint8_t computed[CHACHA20_POLY1305_TAGLEN];
+
+	CHACHA20_POLY1305_init_ctx(&ctx, key.data());
+	EXPECT_EQ(CHACHA20_POLY1305_start(&ctx, iv.data(), 8), 0);
+	EXPECT_EQ(CHACHA20_POLY1305_encrypt_buffer(&ctx, iv.data(), 16, nullptr, 0, buf.data(), buf.size(), computed), 0);
+	EXPECT_EQ(buf, plainText);
+}